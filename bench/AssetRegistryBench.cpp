@@ -0,0 +1,185 @@
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Assets/AssetId.h>
+#include <Core/IdMap.h>
+#include "Bench.h"
+
+// The lookup path AssetManager uses: paths interned as AssetId, entries in an SCConcurrentIdMap.
+// AssetManager itself needs a renderer to load anything, so these drive the same pieces directly
+// with stand-in entries shaped like its own.
+
+struct RegistryEntry
+{
+	AssetId Id;
+	std::shared_ptr<int> Loaded;
+	std::atomic<bool> Resident{ true };
+};
+
+// SCIdMap against std::map under random inserts, erases and finds, then keys that all share their
+// low bits, which land in one probe run and exercise the backward-shift erase.
+SC_BENCH("id-map", IdMapTest)
+{
+	SCIdMap<int> map;
+	std::map<uint64_t, int> reference;
+	std::mt19937_64 random(1);
+	for (int step = 0; step < 200000; step++)
+	{
+		const uint64_t key = (random() % 5000 + 1) * 0x9e3779b97f4a7c15ull;
+		switch (random() % 3)
+		{
+		case 0:
+		{
+			const bool inserted = map.Emplace(key, step).second;
+			SC_BENCH_CHECK(inserted == reference.emplace(key, step).second);
+			break;
+		}
+		case 1:
+			SC_BENCH_CHECK(map.Erase(key) == (reference.erase(key) == 1));
+			break;
+		default:
+		{
+			const int* found = map.Find(key);
+			const auto expected = reference.find(key);
+			SC_BENCH_CHECK((found != nullptr) == (expected != reference.end()));
+			if (found && expected != reference.end())
+				SC_BENCH_CHECK(*found == expected->second);
+		}
+		}
+	}
+	SC_BENCH_CHECK(map.Size() == reference.size());
+
+	SCIdMap<int> clustered;
+	for (uint64_t i = 1; i < 3000; i++)
+		clustered.Emplace(i << 20, static_cast<int>(i));
+	for (uint64_t i = 1; i < 3000; i += 2)
+		clustered.Erase(i << 20);
+	for (uint64_t i = 1; i < 3000; i++)
+		SC_BENCH_CHECK((clustered.Find(i << 20) != nullptr) == (i % 2 == 0));
+	std::printf("%zu keys left, matching std::map\n", map.Size());
+}
+
+static constexpr size_t AssetCount = 100000;
+static constexpr int Repeats = 10;
+
+static std::string AssetPath(const char* root, size_t i)
+{
+	return std::string(root) + "/models/props/set_" + std::to_string(i % 97) + "/asset_" + std::to_string(i) + ".scmesh";
+}
+
+// Lookups among 100k registered assets, then readers running lock-free lookups while a writer
+// interns and registers 50k more.
+SC_BENCH("asset-registry", AssetRegistryBench)
+{
+	std::vector<std::string> paths;
+	for (size_t i = 0; i < AssetCount; i++)
+		paths.push_back(AssetPath("resources", i));
+
+	const SCBenchClock::time_point internStart = SCBenchClock::now();
+	std::vector<AssetId> ids;
+	for (const std::string& path : paths)
+		ids.push_back(AssetId::Intern(path));
+	const double intern = SCBenchNanoseconds(internStart, SCBenchClock::now(), AssetCount);
+
+	std::vector<std::unique_ptr<RegistryEntry>> entries;
+	SCConcurrentIdMap<RegistryEntry*> registry;
+	std::map<std::string, std::shared_ptr<int>> stringMap; // what AssetManager used before
+	for (size_t i = 0; i < AssetCount; i++)
+	{
+		entries.push_back(std::make_unique<RegistryEntry>());
+		entries.back()->Id = ids[i];
+		entries.back()->Loaded = std::make_shared<int>(static_cast<int>(i));
+		registry.Assign(ids[i].Value, entries.back().get());
+		stringMap.emplace(paths[i], entries.back()->Loaded);
+	}
+	for (size_t i = 0; i < AssetCount; i++)
+		SC_BENCH_CHECK(AssetId::Find(paths[i]) == ids[i] && ids[i].Path() == paths[i]);
+
+	// A scattered order, so lookups aren't walking the tables in insertion order.
+	std::vector<size_t> order(AssetCount);
+	for (size_t i = 0; i < AssetCount; i++)
+		order[i] = i * 7919 % AssetCount;
+
+	size_t hits = 0;
+	auto time = [&](auto&& lookup)
+		{
+			const SCBenchClock::time_point start = SCBenchClock::now();
+			for (int r = 0; r < Repeats; r++)
+				for (size_t i : order)
+					hits += lookup(i);
+			return SCBenchNanoseconds(start, SCBenchClock::now(), AssetCount * Repeats);
+		};
+	auto isLoaded = [&](AssetId id)
+		{
+			const RegistryEntry* entry = registry.Find(id.Value);
+			return entry && entry->Resident.load(std::memory_order_relaxed);
+		};
+	// The old AssetManager took the path by value.
+	const double byString = time([&](size_t i) { const std::string path = paths[i]; return stringMap.find(path) != stringMap.end(); });
+	const double byPath = time([&](size_t i) { return isLoaded(AssetId::Find(paths[i])); });
+	const double byId = time([&](size_t i) { return isLoaded(ids[i]); });
+	const double getById = time([&](size_t i) { const RegistryEntry* entry = registry.Find(ids[i].Value); std::shared_ptr<int> asset = entry->Loaded; return asset != nullptr; });
+	SC_BENCH_CHECK(hits == AssetCount * Repeats * 4);
+
+	std::printf("%zu assets, ns per lookup\n", AssetCount);
+	std::printf("  AssetId::Intern                         %7.1f\n", intern);
+	std::printf("  std::map<std::string>, path by value    %7.1f\n", byString);
+	std::printf("  loaded by path (AssetId::Find + map)    %7.1f\n", byPath);
+	std::printf("  loaded by id                            %7.1f\n", byId);
+	std::printf("  asset by id, with the shared_ptr copy   %7.1f\n", getById);
+
+	// Readers only ever see a missing entry for an id the writer hasn't registered yet, and never
+	// a wrong one, while the writer grows the map through several table swaps.
+	const size_t extraCount = AssetCount / 2;
+	std::vector<std::string> extraPaths;
+	for (size_t i = 0; i < extraCount; i++)
+		extraPaths.push_back(AssetPath("extra", i));
+	std::vector<std::unique_ptr<RegistryEntry>> extraEntries(extraCount);
+	std::atomic<bool> stop{ false };
+	std::atomic<size_t> wrong{ 0 }, lookups{ 0 };
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; t++)
+	{
+		readers.emplace_back([&, t]
+			{
+				size_t local = 0;
+				for (size_t pass = 0; !stop.load(std::memory_order_relaxed) || pass < 2; pass++)
+				{
+					for (size_t k = 0; k < AssetCount; k += 7)
+					{
+						const size_t i = order[(k + t) % AssetCount];
+						const RegistryEntry* entry = registry.Find(ids[i].Value);
+						if (!entry || entry->Id != ids[i])
+							wrong.fetch_add(1, std::memory_order_relaxed);
+
+						const size_t e = i % extraCount;
+						if (const AssetId id = AssetId::Find(extraPaths[e]); id.IsValid())
+							if (const RegistryEntry* extra = registry.Find(id.Value); extra && extra->Id != id)
+								wrong.fetch_add(1, std::memory_order_relaxed);
+						local += 2;
+					}
+				}
+				lookups.fetch_add(local, std::memory_order_relaxed);
+			});
+	}
+	for (size_t i = 0; i < extraCount; i++)
+	{
+		extraEntries[i] = std::make_unique<RegistryEntry>();
+		extraEntries[i]->Id = AssetId::Intern(extraPaths[i]);
+		registry.Assign(extraEntries[i]->Id.Value, extraEntries[i].get());
+	}
+	stop = true;
+	for (std::thread& reader : readers)
+		reader.join();
+
+	SC_BENCH_CHECK(wrong == 0);
+	SC_BENCH_CHECK(registry.Size() == AssetCount + extraCount);
+	for (size_t i = 0; i < extraCount; i++)
+		SC_BENCH_CHECK(registry.Find(AssetId::Find(extraPaths[i]).Value) == extraEntries[i].get());
+	std::printf("%zu concurrent lookups while registering %zu more, %zu wrong\n", lookups.load(), extraCount, wrong.load());
+}
@@ -0,0 +1,72 @@
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "Bench.h"
+
+struct BenchEntry
+{
+	const char* Name;
+	SCBenchFunction Function;
+};
+
+// Function-local so registrations from other translation units never see it unconstructed.
+static std::vector<BenchEntry>& Benchmarks()
+{
+	static std::vector<BenchEntry> benchmarks;
+	return benchmarks;
+}
+
+static int Failures = 0;
+static const void* volatile Sink = nullptr;
+
+SCBenchRegistration::SCBenchRegistration(const char* name, SCBenchFunction function)
+{
+	Benchmarks().push_back({ name, function });
+}
+
+bool SCBenchCheck(bool passed, const char* condition, const char* file, int line)
+{
+	if (!passed)
+	{
+		std::cerr << "[BENCH]: check failed: " << condition << " (" << file << ":" << line << ")" << std::endl;
+		Failures++;
+	}
+	return passed;
+}
+
+void SCBenchKeep(const void* data)
+{
+	Sink = data;
+}
+
+int main(int argc, char** argv)
+{
+	bool ran = false;
+	for (const BenchEntry& bench : Benchmarks())
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc; i++)
+			selected |= std::strcmp(argv[i], bench.Name) == 0;
+		if (!selected)
+			continue;
+
+		std::cout << "== " << bench.Name << std::endl;
+		bench.Function();
+		ran = true;
+	}
+
+	if (!ran)
+	{
+		std::cerr << "[BENCH]: nothing to run. Benchmarks:";
+		for (const BenchEntry& bench : Benchmarks())
+			std::cerr << " " << bench.Name;
+		std::cerr << std::endl;
+		return 1;
+	}
+	if (Failures > 0)
+	{
+		std::cerr << "[BENCH]: " << Failures << " check(s) failed" << std::endl;
+		return 1;
+	}
+	return 0;
+}
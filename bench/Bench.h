@@ -0,0 +1,40 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+// Benchmarks and checks for the engine's headless parts, run by SteelcastBench. Each one
+// registers itself with SC_BENCH; the executable runs all of them, or the ones named on the
+// command line, prints what they measure and exits non-zero if any SC_BENCH_CHECK failed.
+// Build Release for meaningful timings.
+
+using SCBenchFunction = void(*)();
+
+struct SCBenchRegistration
+{
+	SCBenchRegistration(const char* name, SCBenchFunction function);
+};
+
+#define SC_BENCH(name, function) \
+	static void function(); \
+	static SCBenchRegistration function##Registration(name, function); \
+	static void function()
+
+// Records a failure and carries on, so one run reports everything that is off.
+#define SC_BENCH_CHECK(condition) SCBenchCheck((condition), #condition, __FILE__, __LINE__)
+bool SCBenchCheck(bool passed, const char* condition, const char* file, int line);
+
+// Keeps the optimizer from dropping work whose result is otherwise unused.
+void SCBenchKeep(const void* data);
+
+using SCBenchClock = std::chrono::steady_clock;
+
+inline double SCBenchMilliseconds(SCBenchClock::time_point start, SCBenchClock::time_point end = SCBenchClock::now())
+{
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Nanoseconds per operation.
+inline double SCBenchNanoseconds(SCBenchClock::time_point start, SCBenchClock::time_point end, size_t operations)
+{
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(operations);
+}
@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <Assets/MeshImporter.h>
+#include <Core/DerivedDataCache.h>
+#include "Bench.h"
+
+// Cold versus warm startup for mesh imports: the first import of a generated OBJ fills an empty
+// cache, later ones load the blob. Shader compilation goes through the same cache but needs the
+// D3D compiler, so only meshes are measured here. Checks that a hit hands back exactly what a
+// fresh import produces, that changed settings miss, and that a corrupted blob is rejected and
+// rewritten.
+
+static constexpr int GridSize = 400; // quads per side
+
+static bool WriteGridObj(const std::filesystem::path& path)
+{
+	std::ofstream file(path, std::ios::binary);
+	for (int y = 0; y <= GridSize; y++)
+		for (int x = 0; x <= GridSize; x++)
+			file << "v " << x * 0.1f << " " << std::sin(x * 0.05f) * std::cos(y * 0.05f) << " " << y * 0.1f << "\n";
+	for (int y = 0; y <= GridSize; y++)
+		for (int x = 0; x <= GridSize; x++)
+			file << "vt " << static_cast<float>(x) / GridSize << " " << static_cast<float>(y) / GridSize << "\n";
+	for (int y = 0; y < GridSize; y++)
+	{
+		for (int x = 0; x < GridSize; x++)
+		{
+			const int a = y * (GridSize + 1) + x + 1, b = a + 1, c = a + GridSize + 1, d = c + 1;
+			file << "f " << a << "/" << a << " " << c << "/" << c << " " << b << "/" << b << "\n";
+			file << "f " << b << "/" << b << " " << c << "/" << c << " " << d << "/" << d << "\n";
+		}
+	}
+	return static_cast<bool>(file);
+}
+
+static bool SameMesh(const Mesh& a, const Mesh& b)
+{
+	return a.Vertices.size() == b.Vertices.size() && a.Indices == b.Indices && a.Lods.size() == b.Lods.size()
+		&& std::memcmp(a.Vertices.data(), b.Vertices.data(), a.Vertices.size() * sizeof(SCVertex)) == 0
+		&& std::memcmp(a.Lods.data(), b.Lods.data(), a.Lods.size() * sizeof(SCMeshLod)) == 0;
+}
+
+SC_BENCH("derived-data-cache", DerivedDataCacheBench)
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "SteelcastBench-ddc";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+	const std::string source = (directory / "grid.obj").string();
+	if (!SC_BENCH_CHECK(WriteGridObj(source)))
+		return;
+
+	SCDerivedDataCache cache((directory / "cache").string());
+	SCMeshOptimizeReport report;
+	MeshImportSettings settings;
+	settings.Cache = &cache;
+	settings.Report = &report;
+
+	std::printf("%s: %.1f MB, %d triangles\n", source.c_str(), std::filesystem::file_size(source) / 1e6, GridSize * GridSize * 2);
+	Mesh cold;
+	SCBenchClock::time_point start = SCBenchClock::now();
+	SC_BENCH_CHECK(ImportMesh(source, cold, settings));
+	std::printf("cold:   %8.1f ms\n", SCBenchMilliseconds(start));
+	const SCMeshOptimizeReport coldReport = report;
+	SC_BENCH_CHECK(coldReport.After.ACMR < coldReport.Before.ACMR);
+	for (int run = 0; run < 3; run++)
+	{
+		Mesh warm;
+		report = {};
+		start = SCBenchClock::now();
+		SC_BENCH_CHECK(ImportMesh(source, warm, settings));
+		std::printf("warm:   %8.1f ms\n", SCBenchMilliseconds(start));
+		SC_BENCH_CHECK(SameMesh(warm, cold));
+		SC_BENCH_CHECK(std::memcmp(&report, &coldReport, sizeof(report)) == 0); // cached with the mesh
+	}
+	std::cout << "optimized: " << coldReport;
+
+	MeshImportSettings uncached = settings;
+	uncached.Cache = nullptr;
+	Mesh fresh;
+	SC_BENCH_CHECK(ImportMesh(source, fresh, uncached) && SameMesh(fresh, cold));
+
+	SCDerivedDataStats stats = cache.GetStats();
+	SC_BENCH_CHECK(stats.Misses == 1 && stats.Hits == 3 && stats.Writes == 1 && stats.Rejected == 0);
+
+	// Settings that change the output are part of the key.
+	MeshImportSettings flipped = settings;
+	flipped.FlipV = !settings.FlipV;
+	Mesh other;
+	SC_BENCH_CHECK(ImportMesh(source, other, flipped) && !SameMesh(other, cold));
+	stats = cache.GetStats();
+	SC_BENCH_CHECK(stats.Misses == 2 && stats.Writes == 2);
+
+	// Damage every blob; the next import rejects its one, re-imports and rewrites it.
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(directory / "cache"))
+	{
+		if (!entry.is_regular_file())
+			continue;
+		std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+		const std::streamoff middle = static_cast<std::streamoff>(entry.file_size() / 2);
+		file.seekg(middle);
+		const char byte = static_cast<char>(file.get());
+		file.seekp(middle);
+		file.put(static_cast<char>(~byte));
+	}
+	Mesh repaired;
+	SC_BENCH_CHECK(ImportMesh(source, repaired, settings) && SameMesh(repaired, cold));
+	SC_BENCH_CHECK(ImportMesh(source, repaired, settings) && SameMesh(repaired, cold));
+	stats = cache.GetStats();
+	SC_BENCH_CHECK(stats.Rejected == 1 && stats.Writes == 3 && stats.Hits == 4);
+
+	std::cout << stats;
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <Events/EventSystem.h>
+#include "Bench.h"
+
+// EventQueue throughput with 1 to 32 producer threads feeding the one consumer, under each
+// backpressure policy, with a ring small enough that producers regularly find it full. The
+// consumer checks that every producer's events arrive in the order it pushed them and that
+// nothing goes missing beyond what Drop reports.
+
+struct SequenceArgs : EventArgs
+{
+	int Producer;
+	int Sequence;
+
+	SequenceArgs(int producer, int sequence) : Producer(producer), Sequence(sequence) {}
+};
+
+static constexpr int EventsPerRun = 400000;
+static constexpr size_t RingCapacity = 1024;
+
+static void RunContention(EventBackpressure policy, const char* policyName, int producers)
+{
+	EventQueue queue({ RingCapacity, policy });
+	const int perProducer = EventsPerRun / producers;
+
+	const SCBenchClock::time_point start = SCBenchClock::now();
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&queue, p, perProducer]
+			{
+				for (int i = 0; i < perProducer; i++)
+				{
+					EventPtr event = EventPool::Acquire(EventType::ERROR_EVENT);
+					event->EmplaceArgs<SequenceArgs>(p, i);
+					queue.PushEvent(std::move(event));
+				}
+			});
+	}
+	std::thread closer([&threads, &queue]
+		{
+			for (std::thread& thread : threads)
+				thread.join();
+			queue.Close();
+		});
+
+	std::vector<int> last(producers, -1);
+	size_t received = 0;
+	bool ordered = true;
+	while (EventPtr event = queue.PopEvent())
+	{
+		const SequenceArgs& args = static_cast<const SequenceArgs&>(*event->Args);
+		ordered &= args.Sequence > last[args.Producer];
+		last[args.Producer] = args.Sequence;
+		received++;
+	}
+	closer.join();
+	const double milliseconds = SCBenchMilliseconds(start);
+	const size_t sent = static_cast<size_t>(perProducer) * producers;
+
+	std::printf("%-5s %2d producers: %6.1f ms, %5.2f M pushes/s, %6zu handled, %6llu dropped\n", policyName, producers,
+		milliseconds, sent / milliseconds / 1000.0, received, static_cast<unsigned long long>(queue.DroppedCount()));
+	SC_BENCH_CHECK(ordered);
+	SC_BENCH_CHECK(received + queue.DroppedCount() == sent);
+	if (policy != EventBackpressure::Drop)
+		SC_BENCH_CHECK(queue.DroppedCount() == 0);
+}
+
+SC_BENCH("event-queue", EventQueueBench)
+{
+	std::printf("%d events per run, ring of %zu, %u hardware threads\n", EventsPerRun, RingCapacity, std::thread::hardware_concurrency());
+	const std::pair<EventBackpressure, const char*> policies[] = {
+		{ EventBackpressure::Block, "Block" },
+		{ EventBackpressure::Drop, "Drop" },
+		{ EventBackpressure::Grow, "Grow" }
+	};
+	for (const auto& [policy, name] : policies)
+		for (int producers : { 1, 2, 4, 8, 16, 32 })
+			RunContention(policy, name, producers);
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <Math/VectorStream.h>
+#include "Bench.h"
+
+// SCVector3fStream kernels against the per-element SCVector3f methods they replace, at every SIMD
+// level the CPU supports. Each level first checks its results against SCVector3f.
+
+static constexpr size_t VectorCount = 100003; // not a multiple of the lane count
+static constexpr int Repeats = 100;
+
+static float Difference(const SCVector3f& a, const SCVector3f& b)
+{
+	return std::max({ std::fabs(a.X - b.X), std::fabs(a.Y - b.Y), std::fabs(a.Z - b.Z) });
+}
+
+SC_BENCH("vector-stream", VectorStreamBench)
+{
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+	std::vector<SCVector3f> a(VectorCount), b(VectorCount);
+	for (size_t i = 0; i < VectorCount; i++)
+	{
+		a[i] = SCVector3f(coordinate(random), coordinate(random), coordinate(random));
+		b[i] = SCVector3f(coordinate(random), coordinate(random), coordinate(random));
+	}
+	const SCMatrix4f matrix = SCMatrix4f::Scaling(2, 3, 4) * SCMatrix4f::RotationY(0.7f) * SCMatrix4f::Translation(10, 11, 12);
+
+	std::vector<SCVector3f> result(VectorCount);
+	SCFloatStream dots;
+	std::vector<float> aosDots(VectorCount);
+	auto timeAos = [&](auto&& kernel)
+		{
+			const SCBenchClock::time_point start = SCBenchClock::now();
+			for (int r = 0; r < Repeats; r++)
+				kernel();
+			SCBenchKeep(result.data());
+			SCBenchKeep(aosDots.data());
+			return SCBenchMilliseconds(start) / Repeats;
+		};
+	const double aosAdd = timeAos([&] { for (size_t i = 0; i < VectorCount; i++) result[i] = a[i].Add(b[i]); });
+	const double aosDot = timeAos([&] { for (size_t i = 0; i < VectorCount; i++) aosDots[i] = a[i].Dot(b[i]); });
+	const double aosCross = timeAos([&] { for (size_t i = 0; i < VectorCount; i++) result[i] = a[i].Cross(b[i]); });
+	const double aosNormalize = timeAos([&] { for (size_t i = 0; i < VectorCount; i++) result[i] = a[i].Normalize(); });
+	const double aosTransform = timeAos([&] { for (size_t i = 0; i < VectorCount; i++) result[i] = matrix.TransformPoint(a[i]); });
+
+	std::printf("%zu vectors, ms per pass\n", VectorCount);
+	std::printf("%-10s %8s %8s %8s %10s %10s\n", "", "Add", "Dot", "Cross", "Normalize", "Transform");
+	std::printf("%-10s %8.3f %8.3f %8.3f %10.3f %10.3f\n", "SCVector3f", aosAdd, aosDot, aosCross, aosNormalize, aosTransform);
+
+	const char* levelNames[] = { "Scalar", "SSE", "AVX2" };
+	SCVector3fStream sa, sb, out;
+	sa.Gather(a.data(), VectorCount);
+	sb.Gather(b.data(), VectorCount);
+	for (int level = 0; level <= static_cast<int>(SCGetSupportedSimdLevel()); level++)
+	{
+		SCSetSimdLevel(static_cast<SCSimdLevel>(level));
+
+		float error = 0;
+		sa.Add(sb, out);
+		for (size_t i = 0; i < VectorCount; i++)
+			error = std::max(error, Difference(out.Get(i), a[i].Add(b[i])));
+		sa.Dot(sb, dots);
+		for (size_t i = 0; i < VectorCount; i++)
+			error = std::max(error, std::fabs(dots[i] - a[i].Dot(b[i])) / 100.0f);
+		sa.Cross(sb, out);
+		for (size_t i = 0; i < VectorCount; i++)
+			error = std::max(error, Difference(out.Get(i), a[i].Cross(b[i])) / 100.0f);
+		sa.Normalize(out);
+		for (size_t i = 0; i < VectorCount; i++)
+			error = std::max(error, Difference(out.Get(i), a[i].Normalize()));
+		sa.Transform(matrix, out);
+		for (size_t i = 0; i < VectorCount; i++)
+			error = std::max(error, Difference(out.Get(i), matrix.TransformPoint(a[i])) / 100.0f);
+		SC_BENCH_CHECK(error < 1e-5f);
+		for (size_t i = VectorCount; i < out.PaddedSize(); i++)
+			SC_BENCH_CHECK(out.X[i] == 0 && out.Y[i] == 0 && out.Z[i] == 0);
+		SCVector3fStream zero(1);
+		zero.Normalize(zero);
+		SC_BENCH_CHECK(zero.Get(0) == SCVector3f(0, 0, 0));
+
+		auto timeStream = [&](auto&& kernel)
+			{
+				const SCBenchClock::time_point start = SCBenchClock::now();
+				for (int r = 0; r < Repeats; r++)
+					kernel();
+				SCBenchKeep(out.X.data());
+				SCBenchKeep(dots.data());
+				return SCBenchMilliseconds(start) / Repeats;
+			};
+		const double add = timeStream([&] { sa.Add(sb, out); });
+		const double dot = timeStream([&] { sa.Dot(sb, dots); });
+		const double cross = timeStream([&] { sa.Cross(sb, out); });
+		const double normalize = timeStream([&] { sa.Normalize(out); });
+		const double transform = timeStream([&] { sa.Transform(matrix, out); });
+		std::printf("%-10s %8.3f %8.3f %8.3f %10.3f %10.3f  (%.1fx %.1fx %.1fx %.1fx %.1fx, max error %g)\n",
+			levelNames[level], add, dot, cross, normalize, transform,
+			aosAdd / add, aosDot / dot, aosCross / cross, aosNormalize / normalize, aosTransform / transform, error);
+	}
+	SCSetSimdLevel(SCGetSupportedSimdLevel());
+}
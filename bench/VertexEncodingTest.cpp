@@ -0,0 +1,74 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <Graphics/VertexEncoding.h>
+#include "Bench.h"
+
+// Round-trips random vertices through every SCVertexFormat and holds the error to the bounds the
+// compact formats promise: octahedral normals within 0.004 degrees, half texcoords within 1.4e-3
+// for |uv| <= 3, and UNORM16 positions within 1.4e-3 over a 100-unit box.
+
+static constexpr float NormalBoundDegrees = 0.004f;
+static constexpr float TexCoordBound = 1.4e-3f;
+static constexpr float QuantizedPositionBound = 1.4e-3f;
+
+SC_BENCH("vertex-encoding", VertexEncodingTest)
+{
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> direction(-1.0f, 1.0f), position(-50.0f, 50.0f), texCoord(-2.0f, 3.0f);
+	std::vector<SCVertex> vertices;
+	while (vertices.size() < 100000)
+	{
+		const SCVector3f normal(direction(random), direction(random), direction(random));
+		if (normal.Length() > 1e-3f)
+			vertices.push_back(SCVertex({ position(random), position(random), position(random) }, normal.Normalize(), { texCoord(random), texCoord(random) }));
+	}
+	// The octahedral fold and the poles are where the encoding is least regular.
+	vertices.push_back(SCVertex({ 0, 0, 0 }, { 0, 0, -1 }, { 0, 0 }));
+	vertices.push_back(SCVertex({ 0, 0, 0 }, { 0, 0, 1 }, { 0, 0 }));
+	vertices.push_back(SCVertex({ 0, 0, 0 }, { 1, 0, 0 }, { 0.5f, 1 }));
+	vertices.push_back(SCVertex({ 0, 0, 0 }, SCVector3f(-1, -1, -1).Normalize(), { 0.5f, 1 }));
+
+	const float toDegrees = 180.0f / SC_PI;
+	std::printf("%zu vertices; max/mean error in position, normal (degrees), texcoord\n", vertices.size());
+	for (SCVertexFormat format : { SCVertexFormat::Standard, SCVertexFormat::Compact, SCVertexFormat::CompactQuantized })
+	{
+		const SCEncodedVertices encoded = SCEncodeVertices(vertices, format);
+		const SCVertexEncodingError error = SCMeasureEncodingError(vertices, encoded);
+		std::printf("stride %2u: %.3g/%.3g  %.3g/%.3g  %.3g/%.3g\n", encoded.Stride(),
+			error.MaxPositionError, error.MeanPositionError,
+			error.MaxNormalError * toDegrees, error.MeanNormalError * toDegrees,
+			error.MaxTexCoordError, error.MeanTexCoordError);
+
+		SC_BENCH_CHECK(encoded.Count == vertices.size());
+		SC_BENCH_CHECK(encoded.Data.size() == vertices.size() * encoded.Stride());
+		switch (format)
+		{
+		case SCVertexFormat::Standard:
+			SC_BENCH_CHECK(encoded.Stride() == 32);
+			SC_BENCH_CHECK(error.MaxPositionError == 0 && error.MaxTexCoordError == 0);
+			SC_BENCH_CHECK(error.MaxNormalError * toDegrees < 1e-4f); // acos rounding only
+			break;
+		case SCVertexFormat::Compact:
+			SC_BENCH_CHECK(encoded.Stride() == 20);
+			SC_BENCH_CHECK(error.MaxPositionError == 0);
+			SC_BENCH_CHECK(error.MaxNormalError * toDegrees < NormalBoundDegrees);
+			SC_BENCH_CHECK(error.MaxTexCoordError < TexCoordBound);
+			break;
+		case SCVertexFormat::CompactQuantized:
+			SC_BENCH_CHECK(encoded.Stride() == 16);
+			SC_BENCH_CHECK(error.MaxPositionError < QuantizedPositionBound);
+			SC_BENCH_CHECK(error.MaxNormalError * toDegrees < NormalBoundDegrees);
+			SC_BENCH_CHECK(error.MaxTexCoordError < TexCoordBound);
+			break;
+		}
+	}
+
+	// Halves: exact where the format is, and saturating to infinity past its range.
+	for (float value : { 0.0f, 1.0f, -1.0f, 0.5f, 2048.0f, 65504.0f })
+		SC_BENCH_CHECK(SCHalfToFloat(SCFloatToHalf(value)) == value);
+	SC_BENCH_CHECK(std::isinf(SCHalfToFloat(SCFloatToHalf(70000.0f))));
+	SC_BENCH_CHECK(std::fabs(SCHalfToFloat(SCFloatToHalf(1e-5f)) - 1e-5f) < 1e-7f); // subnormal
+	SC_BENCH_CHECK(std::fabs(SCHalfToFloat(SCFloatToHalf(0.333f)) - 0.333f) < 2.5e-4f);
+}
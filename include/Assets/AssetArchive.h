@@ -0,0 +1,91 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <Core/MappedFile.h>
+
+// .scpak: many asset files packed into one, read through a single mapping.
+//
+//   header | entry data, each aligned to ArchiveAlignment | table of contents | names
+//
+// The table of contents is sorted by (path hash, path), so a lookup is a binary search over
+// fixed-size records followed by one string compare. Paths are stored normalized (see
+// NormalizeAssetPath) and hashed with AssetId::HashPath. An entry is either stored as is, in
+// which case readers get a view straight into the mapping, or LZ4-compressed when that saved
+// enough to be worth a decompress (see Core/Compression.h).
+
+constexpr char ArchiveMagic[4] = { 'S', 'C', 'P', 'K' };
+constexpr uint32_t ArchiveVersion = 1;
+constexpr uint64_t ArchiveAlignment = 64;
+
+enum ArchiveEntryFlags : uint32_t
+{
+	ARCHIVE_ENTRY_COMPRESSED = 1 << 0
+};
+
+struct ArchiveHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint32_t HeaderSize;
+	uint32_t EntryCount;
+	uint64_t TocOffset;
+	uint64_t NamesOffset;
+	uint64_t NamesSize;
+};
+
+struct ArchiveEntry
+{
+	uint64_t PathHash;
+	uint64_t Offset;		// of the stored bytes, from the start of the archive
+	uint64_t StoredSize;
+	uint64_t Size;			// once decompressed; StoredSize for stored entries
+	uint32_t NameOffset;	// into the names block
+	uint32_t NameLength;
+	uint32_t Flags;
+	uint32_t Reserved;
+};
+
+static_assert(std::endian::native == std::endian::little, ".scpak files are little-endian");
+static_assert(std::is_trivially_copyable_v<ArchiveHeader> && sizeof(ArchiveHeader) == 40);
+static_assert(std::is_trivially_copyable_v<ArchiveEntry> && sizeof(ArchiveEntry) == 48);
+
+// Forward slashes, no "." segments, ".." folded into the segment before it, no leading "./".
+std::string NormalizeAssetPath(std::string_view path);
+
+// A mapped, validated .scpak.
+class AssetArchive
+{
+public:
+	bool Open(const std::string& path);
+	bool IsOpen() const { return Header != nullptr; }
+	const std::string& GetPath() const { return Path; }
+
+	// path must already be normalized; hash is AssetId::HashPath(path).
+	const ArchiveEntry* Find(std::string_view path, uint64_t hash) const;
+	const ArchiveEntry* Find(std::string_view path) const;
+
+	std::span<const ArchiveEntry> GetEntries() const { return Entries; }
+	std::string_view GetName(const ArchiveEntry& entry) const { return Names.substr(entry.NameOffset, entry.NameLength); }
+	// The bytes as stored: compressed for ARCHIVE_ENTRY_COMPRESSED entries.
+	std::span<const uint8_t> GetStored(const ArchiveEntry& entry) const { return File.Bytes().subspan(entry.Offset, entry.StoredSize); }
+	// A range of the stored bytes; see SCMappedFile::Prefetch.
+	void Prefetch(const ArchiveEntry& entry, size_t offset = 0, size_t size = SIZE_MAX) const;
+
+private:
+	std::string Path;
+	SCMappedFile File;
+	const ArchiveHeader* Header = nullptr;
+	std::span<const ArchiveEntry> Entries;
+	std::string_view Names;
+};
+
+// Packs the given files, named by their normalized paths. Each one is compressed if that
+// saves at least an eighth of it and compress is set. Returns false if a file can't be read,
+// two paths normalize to the same name, or the archive can't be written.
+bool WriteAssetArchive(const std::string& archivePath, const std::vector<std::string>& files, bool compress = true);
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Assets/AssetArchive.h>
+#include <Core/MappedFile.h>
+
+// The bytes of one asset file, wherever they came from: a view into a mounted archive's mapping
+// for stored entries, a buffer for compressed ones, or a mapping of its own for loose files.
+// Move-only; the bytes stay valid while it is open.
+class AssetFile
+{
+public:
+	AssetFile() = default;
+	AssetFile(AssetFile&& other) noexcept;
+	AssetFile& operator=(AssetFile&& other) noexcept;
+	AssetFile(const AssetFile&) = delete;
+	AssetFile& operator=(const AssetFile&) = delete;
+
+	bool IsOpen() const { return Opened; }
+	const uint8_t* GetData() const { return Data; }
+	size_t GetSize() const { return Size; }
+	std::span<const uint8_t> Bytes() const { return { Data, Size }; }
+	std::string_view Text() const { return { reinterpret_cast<const char*>(Data), Size }; }
+	// True if the bytes come from an archive rather than a loose file.
+	bool IsPacked() const { return Archive != nullptr; }
+
+	// See SCMappedFile::Prefetch. Nothing to do for decompressed entries.
+	void Prefetch(size_t offset, size_t size) const;
+
+private:
+	friend class AssetFileSystem;
+
+	const uint8_t* Data = nullptr;
+	size_t Size = 0;
+	bool Opened = false;
+	SCMappedFile Mapped;
+	std::vector<uint8_t> Decompressed;
+	std::shared_ptr<const AssetArchive> Archive; // keeps the mapping alive for stored entries
+	const ArchiveEntry* Entry = nullptr;
+};
+
+// Resolves asset paths against mounted .scpak archives, newest mount first, then falls back to
+// the loose file. A packed lookup is a hash and a binary search in memory; no syscalls unless the
+// pages have to be read in. Thread-safe: loader threads open files while the frame thread mounts.
+//
+// Hot reload watches loose files, so it won't see changes to anything that is also packed in a
+// mounted archive.
+class AssetFileSystem
+{
+public:
+	// Later mounts shadow earlier ones, so patches can be mounted over a base archive.
+	bool Mount(const std::string& archivePath);
+	void UnmountAll();
+	size_t GetMountCount() const;
+
+	AssetFile Open(std::string_view path) const;
+	bool Exists(std::string_view path) const;
+
+	static AssetFile OpenLoose(const std::string& path);
+	static bool ExistsLoose(const std::string& path);
+
+private:
+	const ArchiveEntry* FindPacked(std::string_view path, std::shared_ptr<const AssetArchive>& archive) const;
+
+	mutable std::shared_mutex Mutex;
+	std::vector<std::shared_ptr<const AssetArchive>> Archives; // newest first
+};
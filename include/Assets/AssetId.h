@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Interned asset path: a 64-bit hash of the path, checked against every path interned before it.
+// A path whose hash is already taken is re-hashed with the next seed, so ids are unique within
+// the process and comparing or looking up an asset never touches the string.
+struct AssetId
+{
+	uint64_t Value = 0;
+
+	AssetId() = default;
+	explicit AssetId(uint64_t value) : Value(value) {}
+
+	bool IsValid() const { return Value != 0; }
+	bool operator==(const AssetId& other) const = default;
+
+	// Thread-safe. Lock-free when the path is already interned.
+	static AssetId Intern(std::string_view path);
+	// Lock-free. Invalid if the path was never interned.
+	static AssetId Find(std::string_view path);
+
+	// The interned path; empty for invalid ids.
+	const std::string& Path() const;
+
+	// Never 0.
+	static uint64_t HashPath(std::string_view path, uint64_t seed = 0);
+};
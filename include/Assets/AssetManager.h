@@ -1,28 +1,200 @@
 #pragma once
-#include <iostream>
-#include <map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
 #include <Assets/Assets.h>
+#include <Assets/AssetFileSystem.h>
+#include <Assets/AssetId.h>
+#include <Core/DerivedDataCache.h>
+#include <Core/FileWatcher.h>
+#include <Core/IdMap.h>
 
-enum class AssetType
+struct AssetTypeResidency
 {
-	DX11_SHADER,
-	MODEL,
-	TEXTURE,
-	SCRIPT
+	size_t Budget = 0;			// bytes, 0 = unlimited
+	size_t Resident = 0;		// assets loaded now
+	size_t Bytes = 0;			// their GetMemorySize total
+	size_t PeakBytes = 0;
+	uint64_t Loads = 0;
+	uint64_t Reloads = 0;		// loads of something evicted earlier
+	uint64_t Evictions = 0;
+	uint64_t EvictedBytes = 0;
+	uint64_t HotReloads = 0;
+	uint64_t Relinks = 0;		// Link calls after a dependency hot-reloaded
 };
 
+struct AssetResidencyStats
+{
+	std::array<AssetTypeResidency, AssetTypeCount> Types{};
+};
+
+std::ostream& operator<<(std::ostream& stream, const AssetResidencyStats& stats);
+
+// Called on the frame thread after the asset is gone, with the bytes it accounted for.
+using AssetEvictionCallback = std::function<void(AssetId id, AssetType type, size_t bytes)>;
+
+// Resolves to the loaded asset, or nullptr if the load failed.
+using AssetFuture = std::shared_future<std::shared_ptr<Asset>>;
+
 class AssetManager
 {
 public:
-	AssetManager() : AssetDict() {}
-	~AssetManager() = default;
-
-	std::shared_ptr<Asset> LoadAsset(const AssetType& type, std::string path);
-	std::shared_ptr<Asset> GetAsset(std::string path);
-	std::vector<std::shared_ptr<Asset>> GetAllAssets();
-	std::vector<std::shared_ptr<Asset>> GetAssetsOfType(const AssetType& type);
-	bool IsAssetLoaded(std::string path);
-	AssetType GetAssetType(std::string path);
+	// loaderThreads 0 picks half the hardware threads. Processed data (compiled shaders and the
+	// like) is cached under cacheDirectory across runs; an empty directory turns that off.
+	AssetManager(unsigned int loaderThreads = 0, std::string cacheDirectory = "cache");
+	~AssetManager();
+
+	// Frame thread. Loads the asset's dependencies (Asset::GetAssetDependencies) that aren't
+	// loaded yet the same way first.
+	std::shared_ptr<Asset> LoadAsset(const AssetType& type, const std::string& path);
+	// Reads and parses on a loader thread; the renderer upload happens in the next Update on the
+	// frame thread, which also resolves the future. Requests for a path that is loading or loaded
+	// share the same future. Callable from any thread.
+	// Dependencies are requested as soon as the asset's Read reports them and go ahead of other
+	// queued loads, so independent subtrees of the graph read in parallel on the loader threads.
+	// An asset is linked and uploaded only once everything it depends on has been; a dependency
+	// that fails, or a cycle, fails it.
+	AssetFuture LoadAssetAsync(const AssetType& type, const std::string& path);
+	// Frame thread: uploads the assets whose Read has finished and whose dependencies are
+	// loaded, dependencies first, and resolves their futures.
+	void Update();
+
+	// Lookups by id are lock-free and safe from any thread; intern the path once with
+	// AssetId::Intern and keep the id. The path overloads hash the path first.
+	std::shared_ptr<Asset> GetAsset(AssetId id) const;
+	std::shared_ptr<Asset> GetAsset(std::string_view path) const;
+	bool IsAssetLoaded(AssetId id) const;
+	bool IsAssetLoaded(std::string_view path) const;
+	// UNKNOWN if the asset isn't loaded.
+	AssetType GetAssetType(AssetId id) const;
+	AssetType GetAssetType(std::string_view path) const;
+
+	// Resident assets, in first load order.
+	std::vector<std::shared_ptr<Asset>> GetAllAssets() const;
+	std::vector<std::shared_ptr<Asset>> GetAssetsOfType(const AssetType& type) const;
+
+	// Residency. Each type may get a byte budget; when a type goes over it, Update evicts its
+	// assets that nothing outside the manager holds a shared_ptr to and that aren't pinned,
+	// least recently used first by a clock sweep, until it is back under. Evicted assets read as
+	// not loaded and load again on the next LoadAsset/LoadAssetAsync. Assets in use are never
+	// evicted, so a type can stay over its budget while they are.
+	void SetBudget(AssetType type, size_t bytes);
+	size_t GetBudget(AssetType type) const;
+	// Pinned assets are never evicted. Pins nest. Pin fails if the asset isn't loaded.
+	bool Pin(AssetId id);
+	void Unpin(AssetId id);
+	void SetEvictionCallback(AssetEvictionCallback callback);
+	// Evicts over-budget types now instead of on the next Update. Frame thread.
+	void Trim();
+	// Evicts every asset that can be, ignoring budgets. Frame thread.
+	void EvictUnused();
+	AssetResidencyStats GetResidencyStats() const;
+
+	SCDerivedDataCache& GetDerivedDataCache() { return DerivedData; }
+	// Mount archives here and every load resolves against them before loose files.
+	AssetFileSystem& GetFileSystem() { return FileSystem; }
+
+	// Hot reload. Watches directory, and when files under it change, reads fresh copies of the
+	// resident assets built from them on the loader threads; Update then swaps each into the
+	// existing object with Asset::Replace, so every shared_ptr to it sees the new data. Only
+	// assets built from a changed file (their own path, or one from Asset::GetDependencies such as
+	// a shader's #includes) reload. SCFileWatcher debounces and batches the changes, so saving
+	// many files costs one pass. A reload that fails to read keeps the old version. Frame thread.
+	// After an asset reloads, the assets built on it (see Asset::GetAssetDependencies), and the
+	// ones built on those, are linked again in dependency order; the rest of the graph isn't touched.
+	bool EnableHotReload(const std::string& directory, std::chrono::milliseconds debounce = std::chrono::milliseconds(100));
 private:
-	std::map<std::string, std::shared_ptr<Asset>> AssetDict;
-};
\ No newline at end of file
+	// Kept until the manager is destroyed, so lock-free readers can hold on to one. Id and Type
+	// never change; Loaded is only written while Resident is false and no reader is inside
+	// Acquire, which is what makes evicting it safe (see Evict).
+	struct Entry
+	{
+		AssetId Id;
+		AssetType Type;
+		std::shared_ptr<Asset> Loaded;
+		size_t Bytes = 0;
+		std::atomic<bool> Resident{ false };
+		std::atomic<bool> Referenced{ false }; // clock bit, set by readers
+		std::atomic<uint32_t> Readers{ 0 };
+		uint32_t Pins = 0;
+		bool Evicted = false;
+		std::vector<uint64_t> Files; // keys into Dependents, while hot reload is on
+		std::vector<AssetId> Uses;   // dependencies, in GetAssetDependencies order
+		std::vector<AssetId> UsedBy; // assets whose Uses contain this one; may include evicted ones
+	};
+
+	struct PendingLoad
+	{
+		AssetId Id;
+		AssetType Type;
+		std::string Path;
+		std::shared_ptr<Asset> Loaded;
+		std::promise<std::shared_ptr<Asset>> Promise;
+		bool ReadOk = false;
+		bool HotReload = false;
+		std::vector<AssetId> DependencyIds;
+		std::vector<AssetFuture> Dependencies;
+	};
+
+	struct Eviction
+	{
+		AssetId Id;
+		AssetType Type;
+		size_t Bytes;
+		std::shared_ptr<Asset> Loaded; // released after the lock, ahead of the callback
+	};
+
+	AssetFuture QueueLoad(AssetType type, const std::string& path, bool urgent);
+	void LoaderLoop();
+	bool RequestDependencies(PendingLoad& load);
+	bool WaitsOn(AssetId from, AssetId to) const;
+	static bool DependenciesReady(const PendingLoad& load);
+	void FinishLoad(PendingLoad& load);
+	bool LoadDependencies(Asset& asset, const std::string& path, std::vector<AssetId>& ids, std::vector<std::shared_ptr<Asset>>& dependencies);
+	static std::shared_ptr<Asset> Acquire(Entry& entry);
+	std::shared_ptr<Asset> Register(AssetId id, AssetType type, std::shared_ptr<Asset> asset, std::vector<AssetId> uses = {});
+	void SetUses(Entry& entry, std::vector<AssetId> uses);
+	void RelinkUsers(Entry& changed);
+	void Resolve(PendingLoad& load, std::shared_ptr<Asset> result);
+	bool Evict(Entry& entry, std::vector<Eviction>& evicted);
+	void Sweep(size_t type, size_t target, std::vector<Eviction>& evicted);
+	void FinishEvictions(std::vector<Eviction>& evicted);
+	void IndexFiles(Entry& entry);
+	void QueueHotReloads(const std::vector<std::string>& changed);
+	void FinishHotReload(PendingLoad& load, bool ok);
+
+	SCDerivedDataCache DerivedData;
+	AssetFileSystem FileSystem;
+	SCConcurrentIdMap<Entry*> Registry;
+
+	mutable std::mutex Mutex; // everything from here to QueueMutex
+	std::vector<std::unique_ptr<Entry>> Entries;
+	SCIdMap<AssetFuture> Loading;
+	std::vector<std::unique_ptr<PendingLoad>> Uploads;
+	std::array<std::vector<Entry*>, AssetTypeCount> Clock; // each type's entries, swept in a ring
+	std::array<size_t, AssetTypeCount> ClockHand{};
+	AssetResidencyStats Residency;
+	AssetEvictionCallback OnEvict;
+	SCIdMap<std::vector<AssetId>> Dependents; // file key -> resident assets built from that file
+	bool TrackFiles = false;
+	SCIdMap<std::vector<AssetId>> Waiting; // in-flight load -> the dependencies it waits on
+
+	std::vector<AssetId> SyncLoads; // LoadAsset calls in progress, innermost last; frame thread only
+
+	std::mutex QueueMutex;
+	std::condition_variable QueueCondition;
+	std::deque<std::unique_ptr<PendingLoad>> Queue;
+	bool Stopping = false;
+	std::vector<std::thread> Loaders;
+
+	std::unique_ptr<SCFileWatcher> Watcher;
+};
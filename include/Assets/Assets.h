@@ -1,19 +1,104 @@
 #pragma once
 #include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
 #include <Graphics/DX11/DX11Shader.h>
 #include <Graphics/DX11/DX11Material.h>
+#include <Assets/AssetFileSystem.h>
+#include <Assets/MeshFile.h>
 
+class DX11Mesh;
+
+enum class AssetType
+{
+	DX11_SHADER,
+	MODEL,
+	TEXTURE,
+	SCRIPT,
+	MATERIAL,
+	UNKNOWN // keep last
+};
+
+constexpr size_t AssetTypeCount = static_cast<size_t>(AssetType::UNKNOWN);
+
+// Another asset this one is built from, e.g. a material's shader.
+struct AssetDependency
+{
+	AssetType Type;
+	std::string Path;
+};
+
+// Loading is split so AssetManager::LoadAssetAsync can run the expensive part off the frame
+// thread: Read does file I/O and parsing on a loader thread and must not touch the renderer;
+// Upload then creates the GPU/renderer objects on the frame thread.
 class Asset { 
 public:
 	virtual ~Asset() = default;
-	virtual void Load(const std::string& path) = 0;
+	virtual bool Read(const std::string& path) = 0;
+	virtual bool Upload() { return true; }
+	// Synchronous load on the calling thread, for assets without dependencies.
+	bool Load(const std::string& path) { return Read(path) && Link({}) && Upload(); }
+	// Where Read may look up and store processed data. Set by AssetManager; null processes every time.
+	SCDerivedDataCache* Cache = nullptr;
+	// Where Read opens files: mounted archives first, then loose files. Set by AssetManager; null
+	// reads loose files only.
+	const AssetFileSystem* FileSystem = nullptr;
+	AssetFile OpenFile(const std::string& path) const { return FileSystem ? FileSystem->Open(path) : AssetFileSystem::OpenLoose(path); }
+	bool HasFile(const std::string& path) const { return FileSystem ? FileSystem->Exists(path) : AssetFileSystem::ExistsLoose(path); }
+	// Bytes this asset keeps alive once uploaded, CPU and GPU side, for AssetManager budgets.
+	// Queried once after Upload.
+	virtual size_t GetMemorySize() const { return 0; }
+
+	// Hot reload. Files other than its own path the asset was built from; a change to any of them
+	// reloads it.
+	virtual std::vector<std::string> GetDependencies() const { return {}; }
+	// Takes over a freshly loaded copy of the same asset in place, on the frame thread, so
+	// everything already holding this asset or the renderer objects it handed out sees the new
+	// data. Returns false if the type can't do that.
+	virtual bool Replace(Asset& /*fresh*/) { return false; }
+
+	// Dependency graph. The assets this one is built from, known once Read has run; AssetManager
+	// loads them first, independent ones in parallel.
+	virtual std::vector<AssetDependency> GetAssetDependencies() const { return {}; }
+	// Hands over the loaded dependencies, in GetAssetDependencies order, on the frame thread.
+	// Called before Upload, and again after any of them hot-reloads so whatever this asset built
+	// from them can be rebuilt.
+	virtual bool Link(std::span<const std::shared_ptr<Asset>> /*dependencies*/) { return true; }
 };
 
+class MaterialAsset;
+
+// A .scmesh file. Read only maps and validates it (and asks the OS to start paging it in);
+// Upload hands the mapped blobs to the renderer without copying them, keeps the bounds, and
+// closes the file so exporters and imports can replace it while the model is loaded. A .scmat
+// next to it with the same name is its material.
 class ModelAsset : public Asset
 {
 public:
 	ModelAsset() = default;
-	void Load(const std::string& path) override;
+	std::shared_ptr<DX11Mesh> MeshObj;
+	bool Read(const std::string& path) override;
+	bool Upload() override;
+	std::vector<AssetDependency> GetAssetDependencies() const override;
+	bool Link(std::span<const std::shared_ptr<Asset>> dependencies) override;
+	// MeshObj's table; invalidated by Replace.
+	std::span<const SCMeshLod> GetLods() const;
+	// From the file's bounds, in model space; for SCSelectLod.
+	void GetBoundingSphere(SCVector3f& center, float& radius) const;
+	// The vertex and index buffers, plus the mapping between Read and Upload.
+	size_t GetMemorySize() const override;
+	// Swaps the buffers into the existing MeshObj and keeps its Material unless the fresh copy has
+	// one.
+	bool Replace(Asset& fresh) override;
+private:
+	MeshFile File;		// open from Read until Upload
+	SCVector3f BoundsCenter;
+	float BoundsRadius = 0;
+	size_t BufferSize = 0;
+	std::string MaterialPath;
+	std::shared_ptr<MaterialAsset> Material;
 };
 
 class ShaderAsset : public Asset
@@ -21,6 +106,39 @@ class ShaderAsset : public Asset
 public:
 	ShaderAsset() = default;
 	std::shared_ptr<DX11Shader> ShaderObj;
-	void Load(const std::string& path) override;
+	bool Read(const std::string& path) override;
+	bool Upload() override;
 	std::shared_ptr<SCMaterial> PackMat();
+	// The driver keeps roughly the bytecode per shader object.
+	size_t GetMemorySize() const override { return BytecodeSize; }
+	// The #included files.
+	std::vector<std::string> GetDependencies() const override { return SourceFiles; }
+	// Moves the new shaders into the existing ShaderObj, which materials from PackMat share.
+	bool Replace(Asset& fresh) override;
+private:
+	// Compiled by Read, turned into ShaderObj by Upload.
+	ComPtr<ID3DBlob> VertexBlob;
+	ComPtr<ID3DBlob> PixelBlob;
+	size_t BytecodeSize = 0;
+	std::vector<std::string> SourceFiles;
+};
+
+// A .scmat file: one "key value" setting per line, # starts a comment. Paths are relative to the
+// .scmat. Keys:
+//   shader <path>	the DX11_SHADER to draw with (required)
+class MaterialAsset : public Asset
+{
+public:
+	MaterialAsset() = default;
+	std::shared_ptr<DX11Material> MaterialObj;
+	bool Read(const std::string& path) override;
+	bool Upload() override;
+	std::vector<AssetDependency> GetAssetDependencies() const override;
+	// Points MaterialObj at the shader's current ShaderObj.
+	bool Link(std::span<const std::shared_ptr<Asset>> dependencies) override;
+	// Takes the new shader and keeps the existing ConstantBuffer.
+	bool Replace(Asset& fresh) override;
+private:
+	std::string ShaderPath;
+	std::shared_ptr<ShaderAsset> Shader;
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <Assets/AssetFileSystem.h>
+#include <Graphics/IndexEncoding.h>
+#include <Graphics/Mesh.h>
+#include <Graphics/Vertex.h>
+
+// .scmesh: a header followed by the vertex and index blobs, each stored exactly as the renderer
+// takes them (SCVertex, uint16_t or uint32_t indices) at a 64-byte aligned file offset. Mapping
+// the file is all a load does; the blobs are used in place. Little-endian only.
+//
+// Version 2 added 16-bit indices, which the writer picks whenever the vertices allow it.
+// Version 3 added the LOD table, SCMeshLod records after the index blob; every level indexes the
+// one vertex blob.
+//
+// Readers accept any version up to MeshFileVersion and any HeaderSize at least as large as the
+// fields they know, so later versions can append header fields.
+
+constexpr char MeshFileMagic[4] = { 'S', 'C', 'M', 'S' };
+constexpr uint32_t MeshFileVersion = 3;
+constexpr size_t MeshFileAlignment = 64;
+
+struct MeshFileHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint32_t HeaderSize;
+	uint32_t Flags;			// none defined yet
+	uint32_t VertexStride;	// sizeof(SCVertex)
+	uint32_t IndexSize;		// sizeof(uint16_t) or sizeof(uint32_t); always the latter before version 2
+	uint64_t VertexCount;
+	uint64_t IndexCount;
+	uint64_t VertexOffset;	// from the start of the file, MeshFileAlignment aligned
+	uint64_t IndexOffset;
+	float BoundsMin[3];
+	float BoundsMax[3];
+	// Version 3
+	uint64_t LodOffset;		// MeshFileAlignment aligned; 0 without LODs
+	uint32_t LodCount;
+	uint32_t Reserved;
+};
+
+// What versions before 3 wrote.
+constexpr size_t MeshFileHeaderV2Size = offsetof(MeshFileHeader, LodOffset);
+
+static_assert(std::endian::native == std::endian::little, ".scmesh blobs are little-endian");
+static_assert(std::is_trivially_copyable_v<MeshFileHeader> && sizeof(MeshFileHeader) == 96 && MeshFileHeaderV2Size == 80);
+static_assert(std::is_trivially_copyable_v<SCMeshLod> && sizeof(SCMeshLod) == 12, "SCMeshLod layout is part of the .scmesh format");
+static_assert(std::is_trivially_copyable_v<SCVertex> && sizeof(SCVertex) == 32, "SCVertex layout is part of the .scmesh format");
+static_assert(offsetof(SCVertex, Position) == 0 && offsetof(SCVertex, Normal) == 12 && offsetof(SCVertex, TexCoord) == 24);
+
+// A mapped, validated .scmesh. The spans point into the mapping (or the archive entry it was
+// opened from) and stay valid while the MeshFile is open.
+class MeshFile
+{
+public:
+	// A loose file.
+	bool Open(const std::string& path);
+	// Takes over an already opened file, e.g. from AssetFileSystem; name is for error messages.
+	bool Open(AssetFile file, const std::string& name);
+	void Close();
+
+	// Starts paging the blobs in ahead of use; see SCMappedFile::Prefetch.
+	void Prefetch() const;
+
+	bool IsOpen() const { return Header != nullptr; }
+	const MeshFileHeader& GetHeader() const { return *Header; }
+	size_t GetSize() const { return File.GetSize(); }
+	std::span<const SCVertex> Vertices() const;
+	SCIndexSpan Indices() const;
+	// Empty for files without LODs, which draw all of Indices.
+	std::span<const SCMeshLod> Lods() const;
+
+private:
+	AssetFile File;
+	const MeshFileHeader* Header = nullptr;
+};
+
+// Stores the indices in SCChooseIndexFormat(vertices.size()). lods index into indices. The file
+// is written under a temporary name and renamed over path, so open mappings of the old one and
+// file watchers never see it half written.
+bool WriteMeshFile(const std::string& path, std::span<const SCVertex> vertices, SCIndexSpan indices, std::span<const SCMeshLod> lods = {});
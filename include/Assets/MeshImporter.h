@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <Core/DerivedDataCache.h>
+#include <Graphics/Mesh.h>
+#include <Graphics/MeshOptimizer.h>
+
+// Importers from interchange formats into Mesh::Vertices/Indices, optionally writing a .scmesh
+// for ModelAsset to map later.
+//
+// OBJ files are mapped, not read into strings, and parsed in parallel in newline-aligned chunks;
+// face corners are then deduplicated into vertices by hash shards, one shard per thread, so
+// both phases scale with cores and memory stays proportional to the mesh rather than the text.
+// glTF 2.0 reads .gltf (JSON + external or base64 buffers) and .glb, triangle primitives only,
+// flattening every mesh instance in the default scene into one mesh with node transforms applied.
+//
+// Both importers finish with SCOptimizeMesh and SCBuildLods unless told not to, so what gets
+// cached or written to a .scmesh is already in vertex cache and fetch order and has its LODs.
+// SCOptimizeMesh's before/after vertex cache figures go to Report, and are cached with the mesh
+// so a hit reports them too.
+//
+// With a Cache, ImportMesh keys the result on the source bytes, MeshImporterVersion and the
+// settings that change the output, and skips importing on a hit. .gltf files aren't cached since
+// their buffers can live in other files the key wouldn't see; .glb and .obj are self-contained.
+
+// Bump whenever either importer's output changes for the same input.
+constexpr uint32_t MeshImporterVersion = 5;
+
+struct MeshImportSettings
+{
+	unsigned int Threads = 0;	// 0 = all hardware threads
+	size_t ChunkBytes = 4 << 20;	// OBJ parse granularity
+	bool Deduplicate = true;	// OBJ: merge identical position/texcoord/normal tuples; glTF: identical vertices
+	bool FlipV = true;			// OBJ texcoords to the top-left origin D3D samples with (glTF already uses it)
+	bool GenerateNormals = true;	// smooth normals when the source has none
+	bool Optimize = true;		// weld and reorder for the GPU with SCOptimizeMesh
+	bool GenerateLods = true;	// append a LOD chain with SCBuildLods
+	std::string CachePath;		// write a .scmesh here after importing, if set
+	SCDerivedDataCache* Cache = nullptr;	// ImportMesh only
+	SCMeshOptimizeReport* Report = nullptr;	// receives SCOptimizeMesh's report, zeroed without Optimize
+};
+
+// Picks the importer from the extension (.obj, .gltf, .glb).
+bool ImportMesh(const std::string& path, Mesh& mesh, const MeshImportSettings& settings = {});
+bool ImportObj(const std::string& path, Mesh& mesh, const MeshImportSettings& settings = {});
+bool ImportGltf(const std::string& path, Mesh& mesh, const MeshImportSettings& settings = {});
+
+// Area-weighted vertex normals from the triangles.
+void ComputeSmoothNormals(std::vector<SCVertex>& vertices, const std::vector<unsigned int>& indices);
@@ -2,6 +2,7 @@
 #include <memory>
 #include <Core/Window.h>
 #include <Events/EventSystem.h>
+#include <Core/Task.h>
 #include <Graphics/Renderer.h>
 #include <Assets/AssetManager.h>
 #include <Graphics/DX11/DX11Renderer.h>
@@ -17,6 +18,7 @@ struct AppSettings
 	std::string Title;
 	SCVector2i Size;
 	RendererAPI RenderAPI;
+	EventDispatchSettings EventDispatch;
 
 	AppSettings(std::string title, SCVector2i size, RendererAPI api) : Title(title), Size(size), RenderAPI(api) {}
 };
@@ -27,8 +29,10 @@ private:
 	static Application* instance;
 	std::unique_ptr<Window> AppWindow;
 	std::unique_ptr<EventSystem> EventSys;
+	std::unique_ptr<SCTaskScheduler> Tasks;
 	std::unique_ptr<AssetManager> AssetMan;
 	std::unique_ptr<Renderer> m_Renderer;
+	EventDispatchSettings EventDispatch;
 public:
 	RendererAPI RenderAPI;
 
@@ -39,6 +43,7 @@ public:
 	static Application& Get() { return *instance; }
 	Window& GetWindow() { return *AppWindow; }
 	EventSystem& GetEventSys() { return *EventSys; }
+	SCTaskScheduler& GetTaskScheduler() { return *Tasks; }
 	Renderer& GetRenderer() { return *m_Renderer; }
 	AssetManager& GetAssetManager() { return *AssetMan; }
 	DX11Renderer& GetDX11Renderer();
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// LZ4 block format (no frame header): greedy single-probe matching for the compressor, a
+// bounds-checked decoder. Blocks are interchangeable with the reference LZ4 library's. Decoding
+// runs at memory speed, which is why archives use it for entries worth compressing.
+
+// Worst-case compressed size for size input bytes.
+size_t SCCompressBound(size_t size);
+
+// Returns the compressed size, or 0 if dst is smaller than SCCompressBound(src.size()).
+size_t SCCompress(std::span<const uint8_t> src, std::span<uint8_t> dst);
+
+// Decodes a whole block into dst. False if the block is malformed or doesn't decode to exactly
+// dst.size() bytes; never reads or writes out of bounds either way.
+bool SCDecompress(std::span<const uint8_t> src, std::span<uint8_t> dst);
@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// On-disk cache for the output of expensive processing (compiled shaders, imported meshes),
+// addressed by a hash of everything the output depends on: the source bytes, the processor and
+// its version, and its settings. Bump the processor version whenever its output changes for the
+// same input, which retires every older blob at once.
+//
+// Each blob is one file, <directory>/<first two hex digits>/<32 hex digits>, written to a
+// temporary name and renamed into place, so concurrent writers (loader threads, several
+// processes) never expose a partial file. Reads verify the key and a checksum of the payload;
+// anything that doesn't match counts as a miss and is overwritten by the next Put. Nothing
+// is ever evicted; delete the directory to reclaim the space.
+
+struct SCDerivedDataKey
+{
+	uint64_t High = 0;
+	uint64_t Low = 0;
+
+	bool operator==(const SCDerivedDataKey&) const = default;
+	std::string ToHex() const;
+};
+
+class SCDerivedDataKeyBuilder
+{
+public:
+	SCDerivedDataKeyBuilder(std::string_view processor, uint32_t version);
+
+	SCDerivedDataKeyBuilder& Add(const void* data, size_t size);
+	// Length-prefixed, so "ab" + "c" and "a" + "bc" differ.
+	SCDerivedDataKeyBuilder& Add(std::string_view text);
+	template<typename T> requires std::is_trivially_copyable_v<T> && (!std::is_pointer_v<T>)
+	SCDerivedDataKeyBuilder& Add(const T& value) { return Add(&value, sizeof(value)); }
+
+	SCDerivedDataKey Finish() const { return Key; }
+
+private:
+	SCDerivedDataKey Key;
+};
+
+// 128-bit non-cryptographic hash, several GB/s, so hashing a source file costs far less than
+// processing it.
+SCDerivedDataKey SCHashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+struct SCDerivedDataStats
+{
+	uint64_t Hits = 0;
+	uint64_t Misses = 0;
+	uint64_t Rejected = 0;		// present but corrupt or stale, counted in Misses too
+	uint64_t Writes = 0;
+	uint64_t WriteFailures = 0;
+	uint64_t BytesRead = 0;
+	uint64_t BytesWritten = 0;
+};
+
+std::ostream& operator<<(std::ostream& stream, const SCDerivedDataStats& stats);
+
+// Thread-safe; every call is independent file I/O.
+class SCDerivedDataCache
+{
+public:
+	// An empty directory disables the cache: Get always misses and Put does nothing.
+	explicit SCDerivedDataCache(std::string directory);
+
+	bool IsEnabled() const { return !Directory.empty(); }
+	const std::string& GetDirectory() const { return Directory; }
+
+	bool Get(const SCDerivedDataKey& key, std::vector<uint8_t>& data);
+	bool Put(const SCDerivedDataKey& key, std::span<const uint8_t> data);
+
+	SCDerivedDataStats GetStats() const;
+
+private:
+	std::string PathFor(const SCDerivedDataKey& key) const;
+
+	std::string Directory;
+	std::atomic<uint64_t> Hits{ 0 };
+	std::atomic<uint64_t> Misses{ 0 };
+	std::atomic<uint64_t> Rejected{ 0 };
+	std::atomic<uint64_t> Writes{ 0 };
+	std::atomic<uint64_t> WriteFailures{ 0 };
+	std::atomic<uint64_t> BytesRead{ 0 };
+	std::atomic<uint64_t> BytesWritten{ 0 };
+};
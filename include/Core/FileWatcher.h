@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Reports files written under watched directories (recursively, including directories created
+// later). Each root gets a thread blocked in the OS: inotify on Linux, ReadDirectoryChangesW on
+// Windows. Only completed writes and renames into place are reported, which is what editors and
+// exporters do on save, so a file is not seen half written. inotify says when a writer closes the
+// file; Windows reports every write, so there TakeChanges holds back files that are still open
+// for writing until a later batch.
+//
+// Changes are batched: TakeChanges hands them out only once no new one has arrived for the
+// debounce period, so saving many files at once (or an editor's write-then-rename) comes out as
+// one batch. A steady stream of changes is still flushed every MaxBatchDelay debounce periods.
+class SCFileWatcher
+{
+public:
+	static constexpr int MaxBatchDelay = 10;
+
+	explicit SCFileWatcher(std::chrono::milliseconds debounce = std::chrono::milliseconds(100));
+	~SCFileWatcher();
+
+	SCFileWatcher(const SCFileWatcher&) = delete;
+	SCFileWatcher& operator=(const SCFileWatcher&) = delete;
+
+	bool Watch(const std::string& directory);
+
+	// The files changed since the last batch, each once and sorted, or nothing while the batch is
+	// still settling. Reported paths are the watched directory joined with the relative path.
+	std::vector<std::string> TakeChanges();
+
+private:
+	struct Root;
+
+	void Record(std::string path);
+	void Run(Root& root);
+
+	using Clock = std::chrono::steady_clock;
+
+	const Clock::duration Debounce;
+	std::mutex Mutex; // Pending and the times
+	std::vector<std::string> Pending;
+	Clock::time_point FirstChange;
+	Clock::time_point LastChange;
+
+	std::atomic<bool> Stopping{ false };
+	std::vector<std::unique_ptr<Root>> Roots;
+#ifdef _WIN32
+	void* StopEvent = nullptr;
+#else
+	int StopFd = -1;
+#endif
+};
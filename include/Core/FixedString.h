@@ -0,0 +1,42 @@
+#pragma once
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <ostream>
+
+// Inline, fixed-capacity string. Never allocates; input longer than N - 1 characters is truncated.
+template<size_t N>
+class SCFixedString
+{
+public:
+	SCFixedString() { Data[0] = '\0'; }
+	SCFixedString(std::string_view str) { Assign(str); }
+	SCFixedString(const char* str) { Assign(str ? std::string_view(str) : std::string_view()); }
+
+	void Assign(std::string_view str)
+	{
+		Length = str.size() < N ? str.size() : N - 1;
+		Truncated = Length != str.size();
+		std::memcpy(Data, str.data(), Length);
+		Data[Length] = '\0';
+	}
+
+	const char* CStr() const { return Data; }
+	std::string_view View() const { return std::string_view(Data, Length); }
+	std::string Str() const { return std::string(Data, Length); }
+	size_t Size() const { return Length; }
+	bool IsTruncated() const { return Truncated; }
+
+	operator std::string_view() const { return View(); }
+
+private:
+	char Data[N];
+	size_t Length = 0;
+	bool Truncated = false;
+};
+
+template<size_t N>
+std::ostream& operator<<(std::ostream& os, const SCFixedString<N>& str)
+{
+	return os << str.View();
+}
@@ -0,0 +1,221 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Open-addressing hash maps keyed by 64-bit ids that are already hashes (AssetId values and the
+// like), so the low bits index the table directly. Key 0 is reserved for empty slots. Linear
+// probing over a power-of-two table kept at most 3/4 full.
+
+// Single-threaded map. Erase shifts the rest of the probe run back instead of leaving
+// tombstones, so lookups never slow down as entries come and go.
+template<typename V>
+class SCIdMap
+{
+public:
+	explicit SCIdMap(size_t capacity = 16) : Slots(RoundCapacity(capacity)) {}
+
+	V* Find(uint64_t key)
+	{
+		for (size_t i = key & Mask(); Slots[i].Key != 0; i = (i + 1) & Mask())
+			if (Slots[i].Key == key)
+				return &Slots[i].Value;
+		return nullptr;
+	}
+	const V* Find(uint64_t key) const { return const_cast<SCIdMap*>(this)->Find(key); }
+
+	// Returns the value for key and whether it was inserted; an existing value is left as it is.
+	template<typename... A>
+	std::pair<V*, bool> Emplace(uint64_t key, A&&... args)
+	{
+		if ((Count + 1) * 4 > Slots.size() * 3)
+			Rehash(Slots.size() * 2);
+		size_t i = key & Mask();
+		for (; Slots[i].Key != 0; i = (i + 1) & Mask())
+			if (Slots[i].Key == key)
+				return { &Slots[i].Value, false };
+		Slots[i].Key = key;
+		Slots[i].Value = V(std::forward<A>(args)...);
+		Count++;
+		return { &Slots[i].Value, true };
+	}
+
+	bool Erase(uint64_t key)
+	{
+		size_t i = key & Mask();
+		for (; Slots[i].Key != key; i = (i + 1) & Mask())
+			if (Slots[i].Key == 0)
+				return false;
+
+		for (size_t j = (i + 1) & Mask(); Slots[j].Key != 0; j = (j + 1) & Mask())
+		{
+			// Move j back into the hole unless the hole lies before j's home slot.
+			const size_t home = Slots[j].Key & Mask();
+			if (((j - home) & Mask()) >= ((j - i) & Mask()))
+			{
+				Slots[i] = std::move(Slots[j]);
+				i = j;
+			}
+		}
+		Slots[i] = Slot();
+		Count--;
+		return true;
+	}
+
+	template<typename F>
+	void ForEach(F&& function)
+	{
+		for (Slot& slot : Slots)
+			if (slot.Key != 0)
+				function(slot.Key, slot.Value);
+	}
+
+	size_t Size() const { return Count; }
+	void Clear() { Slots.assign(Slots.size(), Slot()); Count = 0; }
+
+private:
+	struct Slot
+	{
+		uint64_t Key = 0;
+		V Value = V();
+	};
+
+	static size_t RoundCapacity(size_t capacity)
+	{
+		size_t size = 16;
+		while (size * 3 < capacity * 4)
+			size *= 2;
+		return size;
+	}
+
+	size_t Mask() const { return Slots.size() - 1; }
+
+	void Rehash(size_t size)
+	{
+		std::vector<Slot> old = std::exchange(Slots, std::vector<Slot>(size));
+		for (Slot& slot : old)
+		{
+			if (slot.Key == 0)
+				continue;
+			size_t i = slot.Key & Mask();
+			while (Slots[i].Key != 0)
+				i = (i + 1) & Mask();
+			Slots[i] = std::move(slot);
+		}
+	}
+
+	std::vector<Slot> Slots;
+	size_t Count = 0;
+};
+
+// Read-mostly map shared between threads. Find is lock-free and only loads (no shared counters
+// or lock words are written, so readers on different cores don't contend); Assign takes a mutex.
+// Values are trivially copyable, typically pointers to data that outlives the map, and V{} means
+// absent. Keys are never removed. Growing publishes a new table by pointer swap; the tables it
+// replaced are kept until the map is destroyed (together never more than the current one) since
+// readers may still be probing them.
+template<typename V>
+class SCConcurrentIdMap
+{
+	static_assert(std::is_trivially_copyable_v<V>, "SCConcurrentIdMap values must be trivially copyable");
+public:
+	explicit SCConcurrentIdMap(size_t capacity = 16)
+	{
+		size_t size = 16;
+		while (size * 3 < capacity * 4)
+			size *= 2;
+		Tables.push_back(std::make_unique<Table>(size));
+		Current.store(Tables.back().get(), std::memory_order_release);
+	}
+
+	SCConcurrentIdMap(const SCConcurrentIdMap&) = delete;
+	SCConcurrentIdMap& operator=(const SCConcurrentIdMap&) = delete;
+
+	V Find(uint64_t key) const
+	{
+		const Table* table = Current.load(std::memory_order_acquire);
+		for (size_t i = key & table->Mask;; i = (i + 1) & table->Mask)
+		{
+			const uint64_t slotKey = table->Slots[i].Key.load(std::memory_order_acquire);
+			if (slotKey == key)
+				return table->Slots[i].Value.load(std::memory_order_acquire);
+			if (slotKey == 0)
+				return V{};
+		}
+	}
+
+	// Inserts or replaces. Readers see either the old or the new value.
+	void Assign(uint64_t key, V value)
+	{
+		std::lock_guard<std::mutex> lock(WriteMutex);
+		Table* table = Current.load(std::memory_order_relaxed);
+		if (Slot* slot = Probe(*table, key); slot->Key.load(std::memory_order_relaxed) == key)
+		{
+			slot->Value.store(value, std::memory_order_release);
+			return;
+		}
+
+		if ((Count + 1) * 4 > (table->Mask + 1) * 3)
+			table = Grow(*table);
+		Slot* slot = Probe(*table, key);
+		slot->Value.store(value, std::memory_order_relaxed);
+		slot->Key.store(key, std::memory_order_release); // publishes Value with it
+		Count++;
+	}
+
+	size_t Size() const
+	{
+		std::lock_guard<std::mutex> lock(WriteMutex);
+		return Count;
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<uint64_t> Key{ 0 };
+		std::atomic<V> Value{ V{} };
+	};
+
+	struct Table
+	{
+		explicit Table(size_t size) : Mask(size - 1), Slots(std::make_unique<Slot[]>(size)) {}
+		size_t Mask;
+		std::unique_ptr<Slot[]> Slots;
+	};
+
+	// The slot holding key, or the empty slot it would go in.
+	static Slot* Probe(Table& table, uint64_t key)
+	{
+		size_t i = key & table.Mask;
+		for (uint64_t slotKey; (slotKey = table.Slots[i].Key.load(std::memory_order_relaxed)) != 0 && slotKey != key;)
+			i = (i + 1) & table.Mask;
+		return &table.Slots[i];
+	}
+
+	Table* Grow(Table& old)
+	{
+		Tables.push_back(std::make_unique<Table>((old.Mask + 1) * 2));
+		Table* table = Tables.back().get();
+		for (size_t i = 0; i <= old.Mask; i++)
+		{
+			const uint64_t key = old.Slots[i].Key.load(std::memory_order_relaxed);
+			if (key == 0)
+				continue;
+			Slot* slot = Probe(*table, key);
+			slot->Value.store(old.Slots[i].Value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			slot->Key.store(key, std::memory_order_relaxed);
+		}
+		Current.store(table, std::memory_order_release);
+		return table;
+	}
+
+	std::atomic<Table*> Current{ nullptr };
+	mutable std::mutex WriteMutex;
+	std::vector<std::unique_ptr<Table>> Tables; // every table ever published, newest last
+	size_t Count = 0;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are faulted in from the OS file cache on first
+// touch, so opening is O(1) whatever the file size. Move-only; the view is unmapped on destruction.
+// Others may read, rename or delete the file while it is open, as far as the OS allows, but not
+// write it.
+class SCMappedFile
+{
+public:
+	SCMappedFile() = default;
+	~SCMappedFile() { Close(); }
+
+	SCMappedFile(SCMappedFile&& other) noexcept;
+	SCMappedFile& operator=(SCMappedFile&& other) noexcept;
+	SCMappedFile(const SCMappedFile&) = delete;
+	SCMappedFile& operator=(const SCMappedFile&) = delete;
+
+	bool Open(const std::string& path);
+	void Close();
+
+	// Asks the OS to start reading the range in the background, so later touches (e.g. the
+	// renderer upload on the frame thread) don't stall on disk. Only a hint.
+	void Prefetch(size_t offset, size_t size) const;
+
+	bool IsOpen() const { return Data != nullptr; }
+	const uint8_t* GetData() const { return Data; }
+	size_t GetSize() const { return Size; }
+	std::span<const uint8_t> Bytes() const { return { Data, Size }; }
+
+private:
+	const uint8_t* Data = nullptr;
+	size_t Size = 0;
+#ifdef _WIN32
+	void* FileHandle = nullptr;
+	void* MappingHandle = nullptr;
+#endif
+};
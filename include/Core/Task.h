@@ -0,0 +1,327 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <Events/EventSystem.h>
+
+template<typename T = void>
+class SCTask;
+
+// Whichever of the coroutine (at final_suspend) and the SCTask object (in its destructor) lets
+// go second destroys the frame, so a task can be dropped while it is still suspended.
+class SCTaskPromiseBase
+{
+public:
+	std::suspend_never initial_suspend() noexcept { return {}; }
+	void unhandled_exception() noexcept { std::terminate(); }
+
+	struct FinalAwaiter
+	{
+		bool await_ready() noexcept { return false; }
+		template<typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+		{
+			SCTaskPromiseBase& promise = handle.promise();
+			void* continuation = promise.Continuation.exchange(DoneMarker(), std::memory_order_acq_rel);
+			if (promise.Released.exchange(true, std::memory_order_acq_rel))
+			{
+				handle.destroy();
+				return std::noop_coroutine();
+			}
+			if (continuation)
+				return std::coroutine_handle<>::from_address(continuation);
+			return std::noop_coroutine();
+		}
+		void await_resume() noexcept {}
+	};
+	FinalAwaiter final_suspend() noexcept { return {}; }
+
+	static void* DoneMarker() { static char marker; return &marker; }
+
+	std::atomic<void*> Continuation{ nullptr }; // awaiting coroutine, or DoneMarker once finished
+	std::atomic<bool> Released{ false };
+};
+
+template<typename T>
+class SCTaskPromise : public SCTaskPromiseBase
+{
+public:
+	SCTask<T> get_return_object();
+	template<typename U>
+	void return_value(U&& value) { Result.emplace(std::forward<U>(value)); }
+	T TakeResult() { return std::move(*Result); }
+private:
+	std::optional<T> Result;
+};
+
+template<>
+class SCTaskPromise<void> : public SCTaskPromiseBase
+{
+public:
+	SCTask<void> get_return_object();
+	void return_void() {}
+	void TakeResult() {}
+};
+
+// Eagerly started coroutine. co_await it from another task to get its result, or drop it to
+// let it run to completion on its own.
+template<typename T>
+class SCTask
+{
+public:
+	using promise_type = SCTaskPromise<T>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	SCTask() = default;
+	explicit SCTask(Handle handle) : Coroutine(handle) {}
+	SCTask(SCTask&& other) noexcept : Coroutine(std::exchange(other.Coroutine, nullptr)) {}
+	SCTask& operator=(SCTask&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			Coroutine = std::exchange(other.Coroutine, nullptr);
+		}
+		return *this;
+	}
+	SCTask(const SCTask&) = delete;
+	SCTask& operator=(const SCTask&) = delete;
+	~SCTask() { Release(); }
+
+	bool IsDone() const
+	{
+		return !Coroutine || Coroutine.promise().Continuation.load(std::memory_order_acquire) == SCTaskPromiseBase::DoneMarker();
+	}
+
+	auto operator co_await() && noexcept
+	{
+		struct Awaiter
+		{
+			Handle Coroutine;
+			bool await_ready() const noexcept
+			{
+				return Coroutine.promise().Continuation.load(std::memory_order_acquire) == SCTaskPromiseBase::DoneMarker();
+			}
+			bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+			{
+				void* expected = nullptr;
+				// Fails if the task finished in the meantime; carry on without suspending.
+				return Coroutine.promise().Continuation.compare_exchange_strong(expected, awaiting.address(), std::memory_order_acq_rel);
+			}
+			T await_resume() { return Coroutine.promise().TakeResult(); }
+		};
+		return Awaiter{ Coroutine };
+	}
+
+private:
+	void Release()
+	{
+		if (Coroutine && Coroutine.promise().Released.exchange(true, std::memory_order_acq_rel))
+			Coroutine.destroy();
+		Coroutine = nullptr;
+	}
+
+	Handle Coroutine = nullptr;
+};
+
+template<typename T>
+SCTask<T> SCTaskPromise<T>::get_return_object() { return SCTask<T>(SCTask<T>::Handle::from_promise(*this)); }
+inline SCTask<void> SCTaskPromise<void>::get_return_object() { return SCTask<void>(SCTask<void>::Handle::from_promise(*this)); }
+
+// Resumes suspended tasks on the frame thread (from Tick) or on worker threads. Waiters are
+// intrusive nodes living in the awaiting coroutine's frame and the run queues reuse their
+// storage, so suspending and resuming doesn't allocate once the queues have warmed up.
+class SCTaskScheduler
+{
+public:
+	SCTaskScheduler(EventSystem& events, unsigned int workers = 1);
+	~SCTaskScheduler();
+
+	SCTaskScheduler(const SCTaskScheduler&) = delete;
+	SCTaskScheduler& operator=(const SCTaskScheduler&) = delete;
+
+	// The scheduler the free awaitables below use: the most recently constructed one still alive.
+	static SCTaskScheduler& Current() { return *CurrentScheduler; }
+
+	// Called once per frame on the frame thread: advances the delay clock, polls awaited futures
+	// and resumes everything that became ready.
+	void Tick(float deltaSeconds);
+
+	void ResumeOnFrame(std::coroutine_handle<> handle);
+	void ResumeOnWorker(std::coroutine_handle<> handle);
+
+	struct EventWaiter
+	{
+		EventWaiter* Next = nullptr;
+		std::coroutine_handle<> Handle;
+		void (*Capture)(EventWaiter* self, const EventArgs& args) = nullptr;
+	};
+	void WaitForEvent(EventType type, EventWaiter* waiter);
+
+	struct PollWaiter
+	{
+		PollWaiter* Next = nullptr;
+		std::coroutine_handle<> Handle;
+		bool (*Ready)(PollWaiter* self) = nullptr;
+	};
+	void WaitUntil(PollWaiter* waiter);
+
+	void WaitFor(float seconds, std::coroutine_handle<> handle);
+
+private:
+	// FIFO of handles over a power-of-two ring that only ever grows.
+	class HandleRing
+	{
+	public:
+		void Push(std::coroutine_handle<> handle);
+		std::coroutine_handle<> Pop();
+		bool Empty() const { return Count == 0; }
+	private:
+		std::vector<std::coroutine_handle<>> Items;
+		size_t Head = 0;
+		size_t Count = 0;
+	};
+
+	struct Delayed
+	{
+		double ResumeAt;
+		uint64_t Sequence;
+		std::coroutine_handle<> Handle;
+		bool operator>(const Delayed& other) const { return ResumeAt != other.ResumeAt ? ResumeAt > other.ResumeAt : Sequence > other.Sequence; }
+	};
+
+	void OnEvent(EventType type, const EventArgs& args);
+	void WorkerLoop();
+
+	static SCTaskScheduler* CurrentScheduler;
+	SCTaskScheduler* PreviousScheduler;
+
+	EventSystem& Events;
+
+	std::mutex FrameMutex;
+	std::vector<std::coroutine_handle<>> FrameReady;
+	std::vector<std::coroutine_handle<>> FrameRunning;
+	std::vector<Delayed> DelayHeap; // min-heap on ResumeAt
+	uint64_t DelaySequence = 0;
+	double Clock = 0;
+	PollWaiter* Polling = nullptr;
+
+	std::mutex EventMutex;
+	std::array<EventWaiter*, EventTypeCount> EventWaiters{};
+	std::array<EventHandlerId, EventTypeCount> EventHandlers{};
+
+	std::mutex WorkerMutex;
+	std::condition_variable WorkerCondition;
+	HandleRing WorkerReady;
+	bool Stopping = false;
+	std::vector<std::thread> Workers;
+};
+
+// Awaitables, all using SCTaskScheduler::Current().
+
+// Resumes on the frame thread after the next event of the given type has been dispatched. With
+// T other than EventArgs the event's args are copied out and returned.
+template<typename T = EventArgs>
+auto NextEvent(EventType type)
+{
+	struct Awaiter : SCTaskScheduler::EventWaiter
+	{
+		EventType Type;
+		std::optional<T> Args;
+
+		explicit Awaiter(EventType type) : Type(type) {}
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			Handle = handle;
+			Capture = [](SCTaskScheduler::EventWaiter* self, const EventArgs& args)
+				{
+					if constexpr (!std::is_same_v<T, EventArgs>)
+						static_cast<Awaiter*>(self)->Args.emplace(static_cast<const T&>(args));
+				};
+			SCTaskScheduler::Current().WaitForEvent(Type, this);
+		}
+		auto await_resume()
+		{
+			if constexpr (!std::is_same_v<T, EventArgs>)
+				return std::move(*Args);
+		}
+	};
+	return Awaiter(type);
+}
+
+// Resumes on the frame thread once seconds of frame time (as passed to Tick) have elapsed.
+inline auto Delay(float seconds)
+{
+	struct Awaiter
+	{
+		float Seconds;
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { SCTaskScheduler::Current().WaitFor(Seconds, handle); }
+		void await_resume() noexcept {}
+	};
+	return Awaiter{ seconds };
+}
+
+// Moves the rest of the coroutine to a worker thread.
+inline auto ResumeOnWorker()
+{
+	struct Awaiter
+	{
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { SCTaskScheduler::Current().ResumeOnWorker(handle); }
+		void await_resume() noexcept {}
+	};
+	return Awaiter{};
+}
+
+// Moves the rest of the coroutine to the frame thread (next Tick).
+inline auto ResumeOnFrame()
+{
+	struct Awaiter
+	{
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { SCTaskScheduler::Current().ResumeOnFrame(handle); }
+		void await_resume() noexcept {}
+	};
+	return Awaiter{};
+}
+
+// Waits for a shared_future (e.g. an asset load) without blocking: the frame thread polls it
+// each Tick and resumes the coroutine there with the value.
+template<typename T>
+auto AwaitFuture(std::shared_future<T> future)
+{
+	struct Awaiter : SCTaskScheduler::PollWaiter
+	{
+		std::shared_future<T> Future;
+
+		explicit Awaiter(std::shared_future<T> future) : Future(std::move(future)) {}
+		bool await_ready() const
+		{
+			return !Future.valid() || Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			Handle = handle;
+			Ready = [](SCTaskScheduler::PollWaiter* self)
+				{
+					return static_cast<Awaiter*>(self)->await_ready();
+				};
+			SCTaskScheduler::Current().WaitUntil(this);
+		}
+		T await_resume() { return Future.get(); }
+	};
+	return Awaiter(std::move(future));
+}
@@ -1,9 +1,11 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <source_location>
 #include <Core/Application.h>
+#include <Core/FixedString.h>
 #include <Events/EventSystem.h>
-#define SC_ErrorEvent(x) Application::Get().GetEventSys().FireEvent(std::make_unique<Event>(EventType::ERROR_EVENT, std::make_unique<ErrorEventArgs>(x)));
+#define SC_ErrorEvent(x) Application::Get().GetEventSys().Fire<ErrorEventArgs>(EventType::ERROR_EVENT, x, std::source_location::current());
 
 class AppEventArgs : public EventArgs
 {
@@ -16,9 +18,13 @@ public:
 class ErrorEventArgs : public EventArgs
 {
 public:
-    std::string Error;
+    // Stored inline so firing an error doesn't allocate; long messages are truncated.
+    SCFixedString<200> Error;
     std::source_location Location;
 
-    ErrorEventArgs(const std::string& error, std::source_location location = std::source_location::current())
+    ErrorEventArgs(std::string_view error, std::source_location location = std::source_location::current())
         : Error(error), Location(location) {}
-};
\ No newline at end of file
+};
+
+static_assert(sizeof(AppEventArgs) <= Event::ArgsCapacity, "AppEventArgs must fit in an Event slot");
+static_assert(sizeof(ErrorEventArgs) <= Event::ArgsCapacity, "ErrorEventArgs must fit in an Event slot");
\ No newline at end of file
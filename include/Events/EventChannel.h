@@ -0,0 +1,186 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using EventSubscriptionId = uint64_t;
+
+// Type-erased face of EventChannel<T>, so the frame loop can flush every channel in one call.
+class EventChannelBase
+{
+public:
+	virtual ~EventChannelBase() = default;
+
+	// Flushes every channel used so far, in order of first use. Returns the number of payloads delivered.
+	static size_t FlushAll();
+
+protected:
+	static void RegisterChannel(EventChannelBase* channel);
+	static EventSubscriptionId NextSubscriptionId();
+
+	virtual size_t FlushPending() = 0;
+};
+
+// Statically typed event channel, alongside the EventType-based EventSystem. Payloads are plain
+// values (no EventArgs base or vtable needed) and callbacks receive const T& directly.
+//
+//   EventChannel<ResizeArgs>::Subscribe<&Renderer::OnResize>(renderer);
+//   EventChannel<ResizeArgs>::Fire({ 1280, 720 });   // immediate, on this thread
+//   EventChannel<ResizeArgs>::Post(1280, 720);        // buffered until Flush/FlushAll
+//
+// Subscribe<&Function>() and Subscribe<&Class::Method>(object) bind at compile time, so delivery
+// is one indirect call through a trampoline the compiler can inline the target into. Any other
+// callable is held in a std::function.
+//
+// Subscribe, Unsubscribe, Fire and Flush belong to the thread that owns the channel (normally the
+// frame thread); Post may be called from any thread. Subscribing or unsubscribing from inside a
+// callback is allowed and takes effect from the next delivery.
+template<typename T>
+class EventChannel : public EventChannelBase
+{
+public:
+	template<auto Function>
+	static EventSubscriptionId Subscribe()
+	{
+		return Instance().Add([](void*, const T& payload) { Function(payload); }, nullptr, nullptr);
+	}
+
+	template<auto Method, typename C>
+	static EventSubscriptionId Subscribe(C* object)
+	{
+		return Instance().Add([](void* context, const T& payload) { (static_cast<C*>(context)->*Method)(payload); }, object, nullptr);
+	}
+
+	template<typename F>
+	static EventSubscriptionId Subscribe(F&& callable)
+	{
+		auto owned = std::make_unique<std::function<void(const T&)>>(std::forward<F>(callable));
+		void* context = owned.get();
+		return Instance().Add([](void* context, const T& payload) { (*static_cast<std::function<void(const T&)>*>(context))(payload); }, context, std::move(owned));
+	}
+
+	static bool Unsubscribe(EventSubscriptionId id) { return Instance().Remove(id); }
+
+	// Delivers to every subscriber now, on the calling thread.
+	static void Fire(const T& payload) { Instance().Deliver(&payload, 1); }
+
+	// Stores the payload by value in the channel's buffer until the next Flush.
+	template<typename... A>
+	static void Post(A&&... args)
+	{
+		EventChannel& channel = Instance();
+		std::lock_guard<std::mutex> lock(channel.PendingMutex);
+		channel.Pending.emplace_back(std::forward<A>(args)...);
+	}
+
+	// Delivers everything posted so far; payloads posted by the callbacks wait for the next Flush.
+	static size_t Flush() { return Instance().FlushPending(); }
+
+	static size_t SubscriberCount() { return Instance().Active; }
+
+protected:
+	size_t FlushPending() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(PendingMutex);
+			if (Pending.empty())
+				return 0;
+			std::swap(Pending, Delivering); // both keep their capacity, so steady state doesn't allocate
+		}
+
+		// Delivering may be refilled by a nested Flush from a callback, so work on a local.
+		std::vector<T> batch = std::move(Delivering);
+		Deliver(batch.data(), batch.size());
+		const size_t delivered = batch.size();
+		batch.clear();
+		if (Delivering.capacity() < batch.capacity())
+			Delivering = std::move(batch);
+		return delivered;
+	}
+
+private:
+	using Trampoline = void(*)(void* context, const T& payload);
+
+	struct Subscriber
+	{
+		EventSubscriptionId Id;
+		Trampoline Invoke; // null once unsubscribed during delivery
+		void* Context;
+		std::unique_ptr<std::function<void(const T&)>> Owned;
+	};
+
+	EventChannel() { RegisterChannel(this); }
+
+	static EventChannel& Instance()
+	{
+		static EventChannel channel;
+		return channel;
+	}
+
+	EventSubscriptionId Add(Trampoline invoke, void* context, std::unique_ptr<std::function<void(const T&)>> owned)
+	{
+		const EventSubscriptionId id = NextSubscriptionId();
+		Subscribers.push_back({ id, invoke, context, std::move(owned) });
+		Active++;
+		return id;
+	}
+
+	bool Remove(EventSubscriptionId id)
+	{
+		for (size_t i = 0; i < Subscribers.size(); i++)
+		{
+			if (Subscribers[i].Id != id || !Subscribers[i].Invoke)
+				continue;
+			Active--;
+			if (Depth > 0)
+			{
+				// The callable may be the one running; it is destroyed when delivery unwinds.
+				Subscribers[i].Invoke = nullptr;
+				Dirty = true;
+			}
+			else
+			{
+				Subscribers.erase(Subscribers.begin() + i);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	// Subscriber-major: each callback runs over the whole contiguous batch before the next one.
+	void Deliver(const T* payloads, size_t count)
+	{
+		Depth++;
+		const size_t subscribers = Subscribers.size(); // ones added by callbacks start next time
+		for (size_t s = 0; s < subscribers; s++)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const Trampoline invoke = Subscribers[s].Invoke;
+				if (!invoke)
+					break;
+				invoke(Subscribers[s].Context, payloads[i]);
+			}
+		}
+		if (--Depth == 0 && Dirty)
+		{
+			std::erase_if(Subscribers, [](const Subscriber& subscriber) { return !subscriber.Invoke; });
+			Dirty = false;
+		}
+	}
+
+	std::vector<Subscriber> Subscribers;
+	size_t Active = 0;
+	unsigned int Depth = 0;
+	bool Dirty = false;
+
+	std::mutex PendingMutex;
+	std::vector<T> Pending;
+	std::vector<T> Delivering;
+};
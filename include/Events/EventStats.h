@@ -0,0 +1,125 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include <Events/Events.h>
+
+// Event system instrumentation: per-type counters and latency histograms, per-handler cost and
+// queue depth. On by default in Debug, compiled out in Release. Define SC_EVENT_STATS to 0 or 1
+// to override.
+#if !defined(SC_EVENT_STATS)
+#if defined(NDEBUG)
+#define SC_EVENT_STATS 0
+#else
+#define SC_EVENT_STATS 1
+#endif
+#endif
+
+struct SCEventStatsPolicy
+{
+	static constexpr bool Enabled = SC_EVENT_STATS != 0;
+};
+
+// Monotonic nanoseconds.
+uint64_t SCEventClockNs();
+
+// Power-of-two buckets over nanoseconds: bucket i holds values in [2^(i-1), 2^i), bucket 0 holds 0.
+// Recording is a handful of relaxed atomic adds, safe from any thread.
+class SCLatencyHistogram
+{
+public:
+	static constexpr size_t BucketCount = 40; // up to ~9 minutes
+
+	struct Snapshot
+	{
+		uint64_t Count = 0;
+		uint64_t TotalNs = 0;
+		uint64_t MaxNs = 0;
+		std::array<uint64_t, BucketCount> Buckets{};
+
+		double MeanNs() const { return Count ? static_cast<double>(TotalNs) / Count : 0.0; }
+		// Upper bound of the bucket containing the given percentile (0-100).
+		uint64_t PercentileNs(double percentile) const;
+	};
+
+	void Record(uint64_t ns);
+	Snapshot Read() const;
+
+private:
+	std::array<std::atomic<uint64_t>, BucketCount> Buckets{};
+	std::atomic<uint64_t> Count{ 0 };
+	std::atomic<uint64_t> TotalNs{ 0 };
+	std::atomic<uint64_t> MaxNs{ 0 };
+};
+
+struct EventTypeStatsSnapshot
+{
+	EventType Type = EventType::EVENT_NONE;
+	uint64_t Fired = 0;
+	uint64_t Dispatched = 0;
+	SCLatencyHistogram::Snapshot QueueLatency; // FireEvent to start of dispatch
+	SCLatencyHistogram::Snapshot DispatchTime; // all callbacks for one event
+};
+
+struct EventHandlerStatsSnapshot
+{
+	EventHandlerId Id = 0;
+	EventType Type = EventType::EVENT_NONE;
+	SCLatencyHistogram::Snapshot CallTime;
+};
+
+struct EventStatsSnapshot
+{
+	bool Enabled = SCEventStatsPolicy::Enabled;
+	size_t QueueCapacity = 0;
+	size_t QueueDepth = 0;
+	size_t MaxQueueDepth = 0; // as seen by the consumer
+	uint64_t Dropped = 0;
+	std::vector<EventTypeStatsSnapshot> Types;		// types that saw any traffic
+	std::vector<EventHandlerStatsSnapshot> Handlers;	// currently registered handlers
+
+	const EventTypeStatsSnapshot* FindType(EventType type) const;
+	const EventHandlerStatsSnapshot* FindHandler(EventHandlerId id) const;
+};
+
+std::ostream& operator<<(std::ostream& os, const EventStatsSnapshot& stats);
+
+// Counters shared by the queue consumer, the dispatch table and the worker pool.
+class EventStats
+{
+public:
+	struct TypeCounters
+	{
+		std::atomic<uint64_t> Fired{ 0 };
+		std::atomic<uint64_t> Dispatched{ 0 };
+		SCLatencyHistogram QueueLatency;
+		SCLatencyHistogram DispatchTime;
+	};
+
+	struct HandlerCounters
+	{
+		SCLatencyHistogram CallTime;
+	};
+
+	void RecordFired(EventType type);
+	void RecordDispatch(EventType type, uint64_t fireTimeNs, uint64_t startNs, uint64_t endNs);
+	void RecordQueueDepth(size_t depth);
+
+	// Fills everything but the queue and handler fields.
+	void Read(EventStatsSnapshot& snapshot) const;
+
+	// Periodic dump; 0 disables. Due() lets exactly one caller through per interval.
+	void SetDumpInterval(double seconds);
+	bool Due(uint64_t nowNs);
+
+private:
+	TypeCounters* Counters(EventType type);
+
+	std::array<TypeCounters, EventTypeCount> Types;
+	std::atomic<size_t> MaxQueueDepth{ 0 };
+	std::atomic<uint64_t> DumpIntervalNs{ 0 };
+	std::atomic<uint64_t> NextDumpNs{ 0 };
+};
@@ -1,59 +1,406 @@
 #pragma once
 #include <functional>
-#include <map>
+#include <array>
+#include <unordered_map>
+#include <condition_variable>
 #include <vector>
+#include <deque>
 #include <thread>
-#include <queue>
+#include <atomic>
+#include <memory>
 #include <mutex>
-#include <condition_variable>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
 #include <Events/Events.h>
+#include <Events/EventStats.h>
+
+constexpr size_t SCCacheLineSize = 64;
 
 class EventArgs {
 public:
 	virtual ~EventArgs() = default;
 };
 
+class EventPool;
+struct EventPoolThreadState;
+
+// A pooled event slot. The args object is constructed in place in Storage, so firing an event
+// doesn't touch the heap once the calling thread's pool is warm. Slots are handed out by
+// EventPool::Acquire and go back to the pool of the thread that acquired them when the owning
+// EventPtr is destroyed.
 class Event {
 public:
-	EventType Type;
-	std::unique_ptr<EventArgs> Args;
+	// Large enough for every EventArgs in EventArgs.h (checked there with static_assert).
+	static constexpr size_t ArgsCapacity = 256;
+
+	EventType Type = EventType::EVENT_NONE;
+	EventArgs* Args = nullptr; // points into Storage
+	// Events sharing a non-zero key are handled in FIFO order, across types, when dispatching on a
+	// worker pool. 0 orders the event with the others of its Type.
+	uint64_t OrderingKey = 0;
+	uint64_t FireTime = 0; // SCEventClockNs() at FireEvent, only stamped when SC_EVENT_STATS is on
 
-	virtual ~Event() = default;
-	Event(EventType type, std::unique_ptr<EventArgs> args) : Type(type), Args(std::move(args)) {}
+	Event() = default;
+	~Event() { ResetArgs(); }
 
 	Event(const Event&) = delete;
 	Event& operator=(const Event&) = delete;
 
-	Event(Event&&) noexcept = default;
-	Event& operator=(Event&&) noexcept = default;
+	template<typename T, typename... A>
+	T& EmplaceArgs(A&&... args)
+	{
+		static_assert(std::is_base_of_v<EventArgs, T>, "Event args must derive from EventArgs");
+		static_assert(sizeof(T) <= ArgsCapacity, "EventArgs type too large for Event::ArgsCapacity");
+		static_assert(alignof(T) <= alignof(std::max_align_t), "EventArgs type is over-aligned");
+
+		ResetArgs();
+		T* ptr = new (Storage) T(std::forward<A>(args)...);
+		Args = ptr;
+		return *ptr;
+	}
+
+	void ResetArgs()
+	{
+		if (Args)
+		{
+			Args->~EventArgs();
+			Args = nullptr;
+		}
+	}
+
+private:
+	alignas(std::max_align_t) unsigned char Storage[ArgsCapacity];
+	EventPoolThreadState* Owner = nullptr;
+	Event* Next = nullptr; // free list link while pooled, strand link while queued on a worker pool
+
+	friend class EventPool;
+	friend class EventWorkerPool;
+};
+
+struct EventRecycler
+{
+	void operator()(Event* event) const;
+};
+
+using EventPtr = std::unique_ptr<Event, EventRecycler>;
+
+// Per-thread free lists of Event slots. Acquire pops from the calling thread's list; slots released
+// on another thread (the handler thread, usually) are pushed onto a lock-free return stack and
+// picked up by the owner the next time its local list runs dry. Pools of exited threads are
+// adopted by new threads rather than freed, so in-flight slots stay valid.
+class EventPool
+{
+public:
+	static EventPtr Acquire(EventType type);
+	static void Release(Event* event);
+
+	// Total slots ever allocated, across all threads. Flat in steady state.
+	static size_t AllocatedSlots();
+private:
+	static void Grow(EventPoolThreadState& pool);
+};
+
+// What PushEvent does when the ring is full.
+enum class EventBackpressure
+{
+	Block,	// wait for the handler thread to free a slot
+	Drop,	// discard the event and count it
+	Grow	// spill into a locked overflow list until the handler catches up
+};
+
+struct EventQueueSettings
+{
+	size_t Capacity = 4096; // rounded up to a power of two
+	EventBackpressure Policy = EventBackpressure::Block;
 };
 
+// Bounded lock-free multi-producer/single-consumer ring. Producers claim slots with a CAS on the
+// enqueue index and publish through a per-slot sequence number. PopEvent/TryPopEvent must only be
+// called from one thread. The consumer sleeps on an atomic wait (futex / WaitOnAddress) only once
+// the ring is empty, and producers only issue a wake when it is actually sleeping.
 class EventQueue
 {
 public:
-	void PushEvent(std::unique_ptr<Event> event);
-	std::unique_ptr<Event> PopEvent();
+	EventQueue(const EventQueueSettings& settings = EventQueueSettings());
+	~EventQueue();
+
+	EventQueue(const EventQueue&) = delete;
+	EventQueue& operator=(const EventQueue&) = delete;
+
+	// Returns false if the event was dropped (Drop policy, or the queue is closed).
+	bool PushEvent(EventPtr event);
+	// Blocks until an event is available. Returns nullptr once the queue is closed and drained.
+	EventPtr PopEvent();
+	// Non-blocking variant of PopEvent.
+	EventPtr TryPopEvent();
+	// Wakes the consumer and any blocked producers; pending events are still delivered.
+	void Close();
+
+	size_t Capacity() const { return Mask + 1; }
+	size_t ApproximateSize() const;
+	uint64_t DroppedCount() const { return Dropped.load(std::memory_order_relaxed); }
 private:
-	std::queue<std::unique_ptr<Event>> queue_;
-	std::mutex mutex_;
-	std::condition_variable condition_;
+	struct Slot
+	{
+		std::atomic<size_t> Sequence;
+		Event* Value;
+	};
+
+	bool TryEnqueue(Event* event);
+	Event* TryDequeue();
+	void WakeConsumer();
+
+	std::unique_ptr<Slot[]> Slots;
+	size_t Mask;
+	EventBackpressure Policy;
+
+	alignas(SCCacheLineSize) std::atomic<size_t> EnqueuePos{ 0 };
+	alignas(SCCacheLineSize) std::atomic<size_t> DequeuePos{ 0 };
+
+	// Consumer sleep/wake (eventcount).
+	alignas(SCCacheLineSize) std::atomic<uint32_t> ConsumerSignal{ 0 };
+	std::atomic<bool> ConsumerWaiting{ false };
+
+	// Producers blocked on a full ring (Block policy).
+	alignas(SCCacheLineSize) std::atomic<uint32_t> SpaceSignal{ 0 };
+	std::atomic<uint32_t> ProducersWaiting{ 0 };
+
+	// Overflow list (Grow policy). Once anything spills, producers keep spilling until the consumer
+	// has taken the list, so each producer's events stay in order.
+	alignas(SCCacheLineSize) std::atomic<bool> Overflowing{ false };
+	std::mutex OverflowMutex;
+	std::deque<Event*> Overflow;
+	std::deque<Event*> Spilled; // consumer-owned
+	size_t SpillBarrier = 0;    // consumer-owned
+
+	std::atomic<bool> Closed{ false };
+	std::atomic<uint64_t> Dropped{ 0 };
 };
 
 using ECallback = std::function<void(const EventArgs&)>;
+
+// Callbacks per EventType, in a flat array of immutable handler lists. Writers copy the list,
+// modify the copy and publish it with one pointer store; dispatch is one indexed load plus a walk
+// over a contiguous vector and never takes a lock. Replaced lists are freed once every dispatch
+// that could still be reading them has finished (two-phase epoch, see Reclaim).
+class EventDispatchTable
+{
+public:
+	// stats receives per-type and per-handler timings when SC_EVENT_STATS is on; may be null.
+	explicit EventDispatchTable(EventStats* stats = nullptr);
+	~EventDispatchTable();
+
+	EventDispatchTable(const EventDispatchTable&) = delete;
+	EventDispatchTable& operator=(const EventDispatchTable&) = delete;
+
+	// Returns 0 if the type is out of range.
+	EventHandlerId Add(EventType type, ECallback cb);
+	// Safe to call from inside a callback. Returns false if the handler isn't registered.
+	bool Remove(EventHandlerId id);
+	void Dispatch(const Event& event) const;
+	size_t HandlerCount(EventType type) const;
+	void ReadHandlerStats(std::vector<EventHandlerStatsSnapshot>& out) const;
+private:
+	struct Handler
+	{
+		EventHandlerId Id;
+		ECallback Callback;
+		std::shared_ptr<EventStats::HandlerCounters> Stats; // shared by every copy of the list
+	};
+	using HandlerList = std::vector<Handler>;
+
+	struct RetiredList
+	{
+		const HandlerList* List;
+		uint64_t Epoch;
+	};
+
+	struct alignas(SCCacheLineSize) ReaderCount
+	{
+		std::atomic<uint32_t> Count{ 0 };
+	};
+
+	void Publish(size_t index, const HandlerList* list);
+	void Reclaim();
+
+	std::array<std::atomic<const HandlerList*>, EventTypeCount> Lists;
+
+	// Dispatches in flight, split by the parity of the epoch they started in.
+	mutable ReaderCount Readers[2];
+	alignas(SCCacheLineSize) std::atomic<uint64_t> Epoch{ 0 };
+
+	std::mutex WriteMutex;
+	std::vector<RetiredList> Retired;
+	uint64_t NextSerial = 1;
+
+	EventStats* Stats;
+};
+
+enum class EventDispatchMode
+{
+	HandlerThread,	// callbacks run one event at a time on the handler thread
+	WorkerPool,		// the handler thread routes events to a pool of dispatch workers
+	Deferred		// no handler thread; events wait for Flush(), called once per frame
+};
+
+struct EventDispatchSettings
+{
+	EventDispatchMode Mode = EventDispatchMode::HandlerThread;
+	unsigned int Workers = 0; // WorkerPool only; 0 picks one less than the hardware thread count
+};
+
+// Runs callbacks on N threads. Each ordering domain (an EventType, or a non-zero
+// Event::OrderingKey) is a strand: a FIFO of events that at most one worker drains at a time, so
+// events in one domain stay in order while different domains run concurrently, and a slow
+// callback only holds up its own domain. Submit is called from a single thread (the handler thread).
+class EventWorkerPool
+{
+public:
+	EventWorkerPool(const EventDispatchTable& dispatcher, size_t maxInFlight);
+	~EventWorkerPool();
+
+	EventWorkerPool(const EventWorkerPool&) = delete;
+	EventWorkerPool& operator=(const EventWorkerPool&) = delete;
+
+	void Start(unsigned int workers);
+	// Blocks while maxInFlight events are queued or running, so the EventQueue backpressure
+	// policy still applies when callbacks fall behind.
+	void Submit(EventPtr event);
+	// Waits for everything submitted so far to be handled, then joins the workers.
+	void Stop();
+
+	size_t WorkerCount() const { return Workers.size(); }
+private:
+	struct Strand
+	{
+		std::mutex Mutex;
+		Event* Head = nullptr;
+		Event* Tail = nullptr;
+		bool Scheduled = false;
+	};
+
+	Strand& StrandFor(const Event& event);
+	void PruneKeyedStrands();
+	void WorkerLoop();
+	void Schedule(Strand* strand);
+
+	const EventDispatchTable& Dispatcher;
+	const uint32_t MaxInFlight;
+
+	std::array<Strand, EventTypeCount> TypeStrands;
+	std::unordered_map<uint64_t, std::unique_ptr<Strand>> KeyedStrands; // handler thread only
+	size_t PruneThreshold;
+
+	std::mutex ReadyMutex;
+	std::condition_variable ReadyCondition;
+	std::deque<Strand*> Ready;
+	bool Stopping = false;
+
+	alignas(SCCacheLineSize) std::atomic<uint32_t> InFlight{ 0 };
+	std::vector<std::thread> Workers;
+};
+
+class EventTimerWheel;
+
 class EventSystem
 {
 public:
-	void Register(EventType type, ECallback cb);
-	void FireEvent(std::unique_ptr<Event> event);
+	EventSystem(const EventQueueSettings& queueSettings = EventQueueSettings(), const EventDispatchSettings& dispatchSettings = EventDispatchSettings());
+	~EventSystem();
+
+	// Handlers may be added and removed at any time, including from inside a callback; a change
+	// applies from the next dispatched event.
+	EventHandlerId Register(EventType type, ECallback cb);
+	bool Unregister(EventHandlerId id);
+	void FireEvent(EventPtr event);
+
+	// Constructs T in a pooled event slot and queues it. No heap allocation in steady state.
+	template<typename T = EventArgs, typename... A>
+	void Fire(EventType type, A&&... args)
+	{
+		EventPtr event = EventPool::Acquire(type);
+		event->EmplaceArgs<T>(std::forward<A>(args)...);
+		FireEvent(std::move(event));
+	}
+
+	// Like Fire, but in WorkerPool mode the event is handled in order with every other event
+	// fired with the same key, regardless of type. key must be non-zero.
+	template<typename T = EventArgs, typename... A>
+	void FireOrdered(EventType type, uint64_t key, A&&... args)
+	{
+		EventPtr event = EventPool::Acquire(type);
+		event->OrderingKey = key;
+		event->EmplaceArgs<T>(std::forward<A>(args)...);
+		FireEvent(std::move(event));
+	}
+
+	// Timers run on the time passed to AdvanceTimers (the frame's delta time), not the wall clock.
+	// Due events are fired from AdvanceTimers, called by one thread (the frame loop), in due order.
+	EventTimerId FireEventAfter(float delaySeconds, EventPtr event);
+	// make builds one event per firing; see EventTimerWheel::ScheduleRepeating. durationSeconds 0
+	// repeats until cancelled, intervalSeconds 0 fires once per AdvanceTimers call.
+	EventTimerId FireEventEvery(float intervalSeconds, float durationSeconds, std::function<EventPtr()> make);
+	bool CancelTimer(EventTimerId id);
+	void AdvanceTimers(float deltaSeconds);
+
+	// The args are constructed now, in a pooled slot, and held until the event is due.
+	template<typename T = EventArgs, typename... A>
+	EventTimerId FireAfter(EventType type, float delaySeconds, A&&... args)
+	{
+		EventPtr event = EventPool::Acquire(type);
+		event->EmplaceArgs<T>(std::forward<A>(args)...);
+		return FireEventAfter(delaySeconds, std::move(event));
+	}
+
+	// The args are copied into the timer and a fresh T is constructed from them for each firing.
+	template<typename T = EventArgs, typename... A>
+	EventTimerId FireEvery(EventType type, float intervalSeconds, float durationSeconds, A... args)
+	{
+		return FireEventEvery(intervalSeconds, durationSeconds, [type, args...]()
+			{
+				EventPtr event = EventPool::Acquire(type);
+				event->EmplaceArgs<T>(args...);
+				return event;
+			});
+	}
+
 	void Launch();
 	void Halt();
+
+	// Deferred mode: dispatches the events queued so far on the calling thread, in firing order,
+	// and returns how many were handled. Of the events of a coalescing
+	// type that share an ordering key, only the latest is dispatched. Events fired from inside a
+	// callback are left for the next Flush. No-op in the other modes.
+	size_t Flush();
+	// Marks a type whose events supersede each other, e.g. size changes or per-frame notifications.
+	void SetCoalescing(EventType type, bool coalesce);
+
+	// Instrumentation (SC_EVENT_STATS). With stats compiled out the snapshot only has the queue fields.
+	EventStatsSnapshot GetStats() const;
+	void DumpStats(std::ostream& os = std::cout) const;
+	// Dumps to std::cout from the dispatching thread at most once per interval; 0 disables.
+	void SetStatsDumpInterval(double seconds);
 private:
-	static std::map<EventType, std::vector<ECallback>> EventCallbacks;
-	static void EventHandler(EventQueue& queue);
+	void EventHandler();
+	void CoalesceInto(EventPtr event);
+	void PollStats();
+	EventStats Stats;
+	EventDispatchTable Dispatcher;
+	EventDispatchSettings DispatchSettings;
+
+	// Deferred mode, touched only by the flushing thread.
+	std::vector<EventPtr> DeferredBatch;
+	std::array<size_t, EventTypeCount> LatestByType;
+	std::array<std::unordered_map<uint64_t, size_t>, EventTypeCount> LatestByKey;
+	std::array<std::atomic<bool>, EventTypeCount> Coalescing{};
+	bool Flushing = false;
+
 	std::thread HandlerThread;
 	EventQueue Queue;
-	std::mutex mutex_;
+	std::unique_ptr<EventWorkerPool> WorkerPool;
+	std::unique_ptr<EventTimerWheel> Timers;
+	std::vector<EventPtr> DueTimers; // reused by AdvanceTimers
 	bool running = true;
-};
-
-void EventHandler(EventQueue& queue);
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <Events/EventSystem.h>
+
+// Hierarchical timing wheel (4 levels of 256 slots over 1 ms ticks, ~49 days of range). Timers
+// sit in intrusive lists in pooled nodes, so scheduling and cancelling are O(1), and advancing
+// only touches the slots the clock passes through: pending timers cost nothing until their slot
+// comes up, apart from one cascade to a finer level every 256^n ticks.
+class EventTimerWheel
+{
+public:
+	static constexpr double TickSeconds = 0.001;
+
+	EventTimerWheel();
+
+	// Due after delaySeconds of advanced time (at least one tick).
+	EventTimerId Schedule(float delaySeconds, EventPtr event);
+	// make is called once per elapsed interval until durationSeconds have passed (0 = until
+	// cancelled). An interval <= 0 fires once per Advance call, i.e. once a frame. make runs with
+	// the wheel locked and must not schedule or cancel timers.
+	EventTimerId ScheduleRepeating(float intervalSeconds, float durationSeconds, std::function<EventPtr()> make);
+	bool Cancel(EventTimerId id);
+
+	// Moves the clock forward and appends the events that came due, in due order.
+	void Advance(float deltaSeconds, std::vector<EventPtr>& due);
+
+	size_t PendingCount() const;
+private:
+	static constexpr uint32_t LevelBits = 8;
+	static constexpr uint32_t SlotsPerLevel = 1u << LevelBits;
+	static constexpr uint32_t Levels = 4;
+	static constexpr uint32_t EveryAdvanceList = Levels * SlotsPerLevel;
+	static constexpr uint32_t NoNode = UINT32_MAX;
+
+	struct Node
+	{
+		uint32_t Prev = NoNode;
+		uint32_t Next = NoNode;
+		uint32_t List = NoNode; // index into Heads while linked
+		uint32_t Generation = 1;
+		uint64_t Expiry = 0;
+		uint64_t Interval = 0;	// ticks; 0 for one-shot timers
+		uint64_t End = 0;		// repeating timers stop once the clock reaches this tick; 0 = never
+		EventPtr Event;				// one-shot
+		std::function<EventPtr()> Make;	// repeating
+	};
+
+	uint32_t AllocateNode();
+	void FreeNode(uint32_t index);
+	void Link(uint32_t index, uint32_t list);
+	void Unlink(uint32_t index);
+	uint32_t Detach(uint32_t list);
+	void Insert(uint32_t index);
+	void Cascade(uint32_t level);
+	void Expire(uint32_t list, std::vector<EventPtr>& due);
+	void FireNode(uint32_t index, std::vector<EventPtr>& due);
+	static uint64_t ToTicks(float seconds);
+
+	mutable std::mutex Mutex;
+	std::vector<Node> Nodes;
+	uint32_t FreeList = NoNode;
+	std::array<uint32_t, EveryAdvanceList + 1> Heads;
+	uint64_t CurrentTick = 0;
+	double Accumulated = 0;
+	size_t Pending = 0;
+	size_t OnWheel = 0; // pending minus the once-per-Advance timers
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include <iostream>
+#include <cstddef>
+#include <cstdint>
 
 enum class EventType
 {
@@ -7,5 +9,15 @@ enum class EventType
 	ERROR_EVENT,
 	APP_PROC_START,
 	APP_PROC_STOP,
-	APP_RENDER_LOOP
-};
\ No newline at end of file
+	APP_RENDER_LOOP,
+
+	EVENT_TYPE_COUNT // keep last
+};
+
+constexpr size_t EventTypeCount = static_cast<size_t>(EventType::EVENT_TYPE_COUNT);
+
+// Returned by EventSystem::Register, 0 is never a valid id.
+using EventHandlerId = uint64_t;
+
+// Returned by EventSystem::FireEventAfter/FireEventEvery, 0 is never a valid id.
+using EventTimerId = uint64_t;
\ No newline at end of file
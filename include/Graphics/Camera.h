@@ -1,45 +1,39 @@
 #pragma once
 #include <iostream>
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-#include <DirectXMath.h>
-
-using namespace DirectX;
+#include <Math/MathUtils.h>
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
 
+// Right-handed camera (OpenGL-style view space, -Z forward).
 class Camera3D
 {
 public:
-	glm::vec3 Position;
-	glm::vec3 Target;
-	glm::vec3 Up;
-	float FOV;
+	SCVector3f Position;
+	SCVector3f Target;
+	SCVector3f Up;
+	float FOV = SCToRadians(45.0f);
 
-	glm::mat4 ComputeProjectionMatrix(float aspectRatio);
-	glm::mat4 ComputeViewMatrix();
-	glm::mat4 ComputeProjectionViewMatrix(float aspRatio);
+	SCMatrix4f ComputeProjectionMatrix(float aspectRatio);
+	SCMatrix4f ComputeViewMatrix();
+	SCMatrix4f ComputeProjectionViewMatrix(float aspRatio);
 
-	Camera3D(const glm::vec3& position, const glm::vec3& target, const glm::vec3& up)
+	Camera3D(const SCVector3f& position, const SCVector3f& target, const SCVector3f& up)
 		: Position(position), Target(target), Up(up) {}
 };
 
+// Left-handed camera (D3D view space, +Z forward).
 class DXCamera3D
 {
 public:
-	XMFLOAT3 Position;
-	XMFLOAT3 Target;
-	XMFLOAT3 Up;
-	float FOV = 0;
-
-	XMMATRIX ComputeProjectionMatrix(float aspectRatio);
-	XMMATRIX ComputeViewMatrix();
-	XMMATRIX ComputeProjectionViewMatrix(float aspectRatio);
-	XMMATRIX ComputeMVPMatrix(float aspectRatio, XMMATRIX world);
-
-	DXCamera3D(const XMFLOAT3& pos, const XMFLOAT3& target, const XMFLOAT3& up) : Position(pos), Target(target), Up(up) {}
-};
-
-inline XMFLOAT3 AddFloat3(XMFLOAT3 a, XMFLOAT3 b)
-{
-	return XMFLOAT3(a.x + b.x, a.y + b.y, a.z + b.z);
-}
\ No newline at end of file
+	SCVector3f Position;
+	SCVector3f Target;
+	SCVector3f Up;
+	float FOV = SCToRadians(45.0f);
+
+	SCMatrix4f ComputeProjectionMatrix(float aspectRatio);
+	SCMatrix4f ComputeViewMatrix();
+	SCMatrix4f ComputeProjectionViewMatrix(float aspectRatio);
+	SCMatrix4f ComputeMVPMatrix(float aspectRatio, const SCMatrix4f& world);
+
+	DXCamera3D(const SCVector3f& pos, const SCVector3f& target, const SCVector3f& up) : Position(pos), Target(target), Up(up) {}
+};
\ No newline at end of file
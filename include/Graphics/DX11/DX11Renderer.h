@@ -1,6 +1,7 @@
 #pragma once
 #include <Graphics/Renderer.h>
 #include <Graphics/Vertex.h>
+#include <Graphics/VertexEncoding.h>
 #include <Graphics/Mesh.h>
 #include <Graphics/DX11/DX11Shader.h>
 #include <Graphics/DX11/DX11Material.h>
@@ -8,6 +9,7 @@
 #include <d3d11.h>
 #include <dxgi.h>
 #include <memory>
+#include <span>
 #include <wrl.h>
 #include <Graphics/DX11/DX11ConstantBuffer.h>
 
@@ -29,6 +31,15 @@ public:
     ComPtr<ID3D11Buffer> IndexBuffer;
     std::shared_ptr<DX11Material> Material;
 
+    // Layout of VertexBuffer. Vertices always keeps the full-precision SCVertex copy.
+    SCVertexFormat VertexFormat = SCVertexFormat::Standard;
+    UINT VertexStride = sizeof(SCVertex);
+    // Bound to b1 for SCVertexFormat::CompactQuantized meshes.
+    std::shared_ptr<DX11ConstantBuffer<SCVertexQuantization>> QuantizationBuffer;
+    // Indices in IndexBuffer, every LOD included. Meshes created from spans leave Vertices and
+    // Indices empty.
+    UINT IndexCount = 0;
+
     DX11Mesh(ComPtr<ID3D11Buffer> vb, ComPtr<ID3D11Buffer> ib, std::shared_ptr<DX11Material> mat)
         : VertexBuffer(vb), IndexBuffer(ib), Material(mat) {}
 };
@@ -42,6 +53,7 @@ public:
     // Renderer base class functions
     bool Initialize(Window* hwnd) override;
     void Render() override;
+    // Draws the finest LOD.
     void DrawMesh(const std::weak_ptr<Mesh>&) override;
     void Resize(int width, int height) override;
     void BeginFrame(SCVector2i size) override;
@@ -51,6 +63,7 @@ public:
     // DX11Renderer-Specific
     bool CreateVertexBuffer(const void* vertexData, UINT vertexSize, UINT vertexCount, ComPtr<ID3D11Buffer>& buffer);
     bool CreateIndexBuffer(const void* indexData, UINT indexSize, UINT indexCount, ComPtr<ID3D11Buffer>& buffer);
+    bool CreateIndexBuffer(SCIndexSpan indices, ComPtr<ID3D11Buffer>& buffer);
 
     template<typename T>
     std::shared_ptr<DX11ConstantBuffer<T>> CreateConstantBuffer(const T& data)
@@ -69,21 +82,41 @@ public:
         }
     }
 
-    void BindBuffer(DX11BufferType bufferType, ComPtr<ID3D11Buffer>& buffer);
+    // Draws one level of mesh->Lods, clamped to the coarsest; see SCSelectLod.
+    void DrawMesh(const std::weak_ptr<Mesh>& mesh, size_t lod);
+
+    // stride is the vertex stride for VERTEX. Index buffers come in either width, which the buffer
+    // doesn't record, so INDEX is refused here; bind them with BindIndexBuffer.
+    void BindBuffer(DX11BufferType bufferType, ComPtr<ID3D11Buffer>& buffer, UINT stride = sizeof(SCVertex));
+    void BindIndexBuffer(ComPtr<ID3D11Buffer>& buffer, SCIndexFormat format);
 
+    // Both CreateMesh overloads and UploadMesh pick the mesh's IndexFormat from its vertex count
+    // and narrow 32-bit indices to 16 bits when they fit. lods is the table the indices were built
+    // with (Mesh::Lods from the importers); without it DrawMesh draws the whole index buffer, which
+    // for an imported mesh is every level at once. UploadMesh keeps the mesh's own Lods.
     void UploadMesh(std::shared_ptr<DX11Mesh> mesh);
-    std::shared_ptr<DX11Mesh> CreateMesh(std::vector<SCVertex>& vertices, std::vector<unsigned int>& indices, std::shared_ptr<SCMaterial> material);
-    std::shared_ptr<DX11Shader> CreateShader(const wchar_t* vsPath, const wchar_t* psPath);
-    std::shared_ptr<DX11Shader> CreateShader(const wchar_t* shPath);
+    // The material's shader must have been created with the same SCVertexFormat.
+    std::shared_ptr<DX11Mesh> CreateMesh(std::vector<SCVertex>& vertices, std::vector<unsigned int>& indices, std::shared_ptr<SCMaterial> material, std::span<const SCMeshLod> lods = {}, SCVertexFormat format = SCVertexFormat::Standard);
+    // Uploads straight from the given memory (e.g. a mapped .scmesh) without keeping a CPU copy.
+    // Set Material before drawing.
+    std::shared_ptr<DX11Mesh> CreateMesh(std::span<const SCVertex> vertices, SCIndexSpan indices, std::span<const SCMeshLod> lods = {}, SCVertexFormat format = SCVertexFormat::Standard);
+    std::shared_ptr<DX11Shader> CreateShader(const wchar_t* vsPath, const wchar_t* psPath, SCVertexFormat format = SCVertexFormat::Standard);
+    std::shared_ptr<DX11Shader> CreateShader(const wchar_t* shPath, SCVertexFormat format = SCVertexFormat::Standard);
+    std::shared_ptr<DX11Shader> CreateShader(ID3DBlob* vsBlob, ID3DBlob* psBlob, SCVertexFormat format = SCVertexFormat::Standard);
+    // Used by the path overloads of CreateShader; null compiles every time.
+    void SetShaderCache(SCDerivedDataCache* cache) { shaderCache = cache; }
     
 private:
     bool CreateDeviceAndSwapChain(HWND hwnd, SCVector2i size);
     void CreateRenderTarget();
     bool CreateDepthStencil(SCVector2i size);
+    bool CreateMeshVertexBuffer(DX11Mesh& mesh, std::span<const SCVertex> vertices);
+    bool CreateMeshIndexBuffer(DX11Mesh& mesh, SCIndexSpan indices, size_t vertexCount);
 
     ComPtr<ID3D11Device> d3dDevice;
     ComPtr<ID3D11DeviceContext> d3dContext;
     ComPtr<IDXGISwapChain> swapChain;
     ComPtr<ID3D11RenderTargetView> renderTargetView;
     ComPtr<ID3D11DepthStencilView> depthStencilView;
+    SCDerivedDataCache* shaderCache = nullptr;
 };
\ No newline at end of file
@@ -1,23 +1,43 @@
 #pragma once
 #include <iostream>
+#include <string>
+#include <vector>
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <dxgi.h>
 #include <wrl.h>
+#include <Core/DerivedDataCache.h>
+#include <Graphics/VertexEncoding.h>
 
 using namespace Microsoft::WRL;
 
 class DX11Shader
 {
 public:
-    bool Initialize(ID3D11Device* device, const wchar_t* vsPath, const wchar_t* psPath);
-    bool Initialize(ID3D11Device* device, const wchar_t* shPath);
+    // Bump when anything that changes compiled bytecode for the same preprocessed source changes
+    // outside of what the cache key already covers (flags, profiles, compiler version).
+    static constexpr uint32_t CacheVersion = 1;
+
+    bool Initialize(ID3D11Device* device, const wchar_t* vsPath, const wchar_t* psPath, SCVertexFormat format = SCVertexFormat::Standard, SCDerivedDataCache* cache = nullptr);
+    bool Initialize(ID3D11Device* device, const wchar_t* shPath, SCVertexFormat format = SCVertexFormat::Standard, SCDerivedDataCache* cache = nullptr);
+    // Creates the shaders and input layout from already compiled bytecode (see CompileSource).
+    bool Initialize(ID3D11Device* device, ID3DBlob* vsBlob, ID3DBlob* psBlob, SCVertexFormat format = SCVertexFormat::Standard);
+
+    // Compiles VS_Main/PS_Main from HLSL source in memory. Doesn't touch the device, so it can run
+    // on a loader thread; sourceName is used for error messages and relative #includes.
+    // With a cache, each stage is keyed on its preprocessed source (so #includes and defines are
+    // covered) and only compiled on a miss. sourceFiles, if given, collects every file the
+    // preprocessor read, the source itself included. include replaces the default handler, which
+    // opens #includes from disk relative to the including file.
+    static bool CompileSource(const std::string& source, const char* sourceName, SCVertexFormat format, ComPtr<ID3DBlob>& vsBlob, ComPtr<ID3DBlob>& psBlob,
+        SCDerivedDataCache* cache = nullptr, std::vector<std::string>* sourceFiles = nullptr, ID3DInclude* include = nullptr);
     void SetShaders(ID3D11DeviceContext* context);
 
     ComPtr<ID3D11VertexShader> vertexShader;
     ComPtr<ID3D11PixelShader> pixelShader;
     ComPtr<ID3D11InputLayout> inputLayout;
+    SCVertexFormat VertexFormat = SCVertexFormat::Standard;
 private:
 
-    bool CompileShaderFromFile(const wchar_t* fileName, const char* entryPoint, const char* shaderModel, ID3DBlob** blob);
+    static bool CompileShaderFromFile(const wchar_t* fileName, const char* entryPoint, const char* shaderModel, const D3D_SHADER_MACRO* defines, SCDerivedDataCache* cache, ComPtr<ID3DBlob>& blob);
 };
\ No newline at end of file
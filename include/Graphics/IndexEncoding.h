@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Index buffer widths. Mesh::Indices stays 32-bit for editing and processing; what goes to the
+// GPU or into a .scmesh uses UInt16 whenever every vertex fits, halving index memory and the
+// bandwidth of fetching them.
+enum class SCIndexFormat
+{
+	UInt16,
+	UInt32
+};
+
+unsigned int SCIndexSize(SCIndexFormat format);
+// UInt16 for fewer than 65,536 vertices, UInt32 otherwise.
+SCIndexFormat SCChooseIndexFormat(size_t vertexCount);
+
+// A read-only view of indices in either width, e.g. into a mapped .scmesh. Converts implicitly
+// from 32-bit spans.
+class SCIndexSpan
+{
+public:
+	SCIndexSpan() = default;
+	SCIndexSpan(const std::vector<uint32_t>& indices) : SCIndexSpan(std::span<const uint32_t>(indices)) {}
+	SCIndexSpan(std::span<const uint32_t> indices) : Format(SCIndexFormat::UInt32), Data(indices.data()), Count(indices.size()) {}
+	SCIndexSpan(std::span<const uint16_t> indices) : Format(SCIndexFormat::UInt16), Data(indices.data()), Count(indices.size()) {}
+	SCIndexSpan(SCIndexFormat format, const void* data, size_t count) : Format(format), Data(data), Count(count) {}
+
+	SCIndexFormat GetFormat() const { return Format; }
+	const void* GetData() const { return Data; }
+	size_t Size() const { return Count; }
+	size_t SizeBytes() const { return Count * SCIndexSize(Format); }
+	bool Empty() const { return Count == 0; }
+
+	uint32_t operator[](size_t i) const
+	{
+		return Format == SCIndexFormat::UInt16 ? static_cast<const uint16_t*>(Data)[i] : static_cast<const uint32_t*>(Data)[i];
+	}
+
+private:
+	SCIndexFormat Format = SCIndexFormat::UInt32;
+	const void* Data = nullptr;
+	size_t Count = 0;
+};
+
+class SCEncodedIndices
+{
+public:
+	SCIndexFormat Format = SCIndexFormat::UInt32;
+	std::vector<uint8_t> Data;
+	size_t Count = 0;
+
+	SCIndexSpan Span() const { return SCIndexSpan(Format, Data.data(), Count); }
+};
+
+// Narrowing to UInt16 assumes every index fits, which SCChooseIndexFormat guarantees for indices
+// into the vertex count it was given.
+SCEncodedIndices SCEncodeIndices(SCIndexSpan indices, SCIndexFormat format);
+std::vector<unsigned int> SCDecodeIndices(SCIndexSpan indices);
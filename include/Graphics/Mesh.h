@@ -1,5 +1,7 @@
 #pragma once
+#include <Graphics/IndexEncoding.h>
 #include <Graphics/Vertex.h>
+#include <cstdint>
 #include <vector>
 
 class SCMaterial { 
@@ -7,11 +9,24 @@ public:
 	virtual ~SCMaterial() = default;
 };
 
+// One level of detail: a range of Mesh::Indices over the shared vertices, and how far (in the
+// mesh's own units) its surface may stray from the full-detail one. See SCBuildLods.
+struct SCMeshLod
+{
+	uint32_t IndexOffset;
+	uint32_t IndexCount;
+	float Error;
+};
+
 class Mesh
 {
 public:
 	std::vector<SCVertex> Vertices;
 	std::vector<unsigned int> Indices;
+	// Width of the uploaded index buffer, picked from the vertex count when it is created.
+	SCIndexFormat IndexFormat = SCIndexFormat::UInt32;
+	// Finest first. Empty means one level made of all of Indices.
+	std::vector<SCMeshLod> Lods;
 	SCMaterial Material;
 
 	virtual ~Mesh() = default;
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <vector>
+#include <Graphics/Mesh.h>
+
+// Mesh processing on Mesh::Vertices/Indices (triangle lists), meant to run once after import or
+// authoring rather than per frame:
+//   weld      merge vertices that are equal within tolerances, found through a spatial hash
+//   cache     reorder triangles for the post-transform vertex cache (Forsyth's linear-speed
+//             algorithm)
+//   overdraw  cut the cache-ordered triangles into clusters at points that cost little cache
+//             efficiency, and draw outward-facing clusters first so they occlude the rest
+//   fetch     renumber vertices in first-use order, so vertex fetch walks memory forward
+// Each step assumes the ones before it; SCOptimizeMesh runs all four in order.
+
+struct SCWeldSettings
+{
+	float PositionTolerance = 1e-6f;	// per axis, world units
+	float NormalTolerance = 1e-3f;		// per component
+	float TexCoordTolerance = 1e-6f;	// per component, uv units
+};
+
+// Post-transform cache efficiency with a FIFO cache of the given size, the model the vertex cache
+// literature uses. ACMR is vertex shader runs per triangle: 3 means no reuse, around 0.5-0.7 is
+// the practical floor for regular meshes. ATVR is runs per vertex used: 1 is ideal.
+struct SCVertexCacheStats
+{
+	size_t Triangles = 0;
+	size_t Vertices = 0;		// referenced by at least one triangle
+	size_t Transforms = 0;
+	float ACMR = 0;
+	float ATVR = 0;
+};
+
+SCVertexCacheStats SCAnalyzeVertexCache(std::span<const unsigned int> indices, size_t vertexCount, unsigned int cacheSize = 16);
+
+// Returns the number of vertices removed. Triangles that collapse are removed as well.
+size_t SCWeldVertices(Mesh& mesh, const SCWeldSettings& settings = {});
+void SCOptimizeVertexCache(std::span<unsigned int> indices, size_t vertexCount);
+// threshold is how much worse than its cluster's ACMR a cut may make it; 1 keeps the cache order.
+void SCOptimizeOverdraw(std::span<unsigned int> indices, std::span<const SCVertex> vertices, float threshold = 1.05f, unsigned int cacheSize = 16);
+// Returns the number of unreferenced vertices dropped.
+size_t SCOptimizeVertexFetch(Mesh& mesh);
+
+struct SCMeshOptimizeSettings
+{
+	bool Weld = true;
+	SCWeldSettings WeldSettings;
+	bool Overdraw = true;
+	float OverdrawThreshold = 1.05f;
+	unsigned int CacheSize = 16;	// for the overdraw cuts and the report
+};
+
+struct SCMeshOptimizeReport
+{
+	size_t VerticesBefore = 0;
+	size_t VerticesAfter = 0;
+	SCVertexCacheStats Before;
+	SCVertexCacheStats After;
+};
+
+SCMeshOptimizeReport SCOptimizeMesh(Mesh& mesh, const SCMeshOptimizeSettings& settings = {});
+
+std::ostream& operator<<(std::ostream& stream, const SCMeshOptimizeReport& report);
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <Graphics/Camera.h>
+#include <Graphics/Mesh.h>
+
+// Quadric error simplification (Garland and Heckbert, "Surface Simplification Using Quadric Error
+// Metrics", 1997) by collapsing edges into one of their endpoints, so every level keeps indexing
+// the original vertices and all of a mesh's LODs share one vertex buffer.
+//
+// Open borders only collapse along themselves. Vertices on attribute seams (several vertices at
+// one position, e.g. a uv seam or a hard edge) and on non-manifold edges stay where they are,
+// which keeps seams closed but limits how far meshes made mostly of them can be reduced.
+
+// Simplifies a triangle list towards targetIndexCount without any collapse moving the surface
+// further than targetError. Returns the new index list; resultError, if given, receives the
+// largest error introduced.
+std::vector<unsigned int> SCSimplify(std::span<const unsigned int> indices, std::span<const SCVertex> vertices,
+	size_t targetIndexCount, float targetError, float* resultError = nullptr);
+
+struct SCLodSettings
+{
+	unsigned int MaxLods = 6;		// including the full-detail level
+	float Reduction = 0.5f;			// triangles kept per level
+	float MaxError = 0.05f;			// relative to the mesh's bounding radius
+	size_t MinTriangles = 32;		// stop once a level gets this small
+};
+
+// Appends a chain of coarser levels to mesh.Indices, each simplified from the one before and
+// ordered for the vertex cache, and fills mesh.Lods. The chain stops early once a level fails to
+// lose a tenth of its triangles within the error budget. Run it after SCOptimizeMesh, which
+// rewrites Indices as one level. Returns the number of levels.
+size_t SCBuildLods(Mesh& mesh, const SCLodSettings& settings = {});
+
+// Coarsest level whose error, projected at the given distance, stays within pixelError pixels on
+// a viewport viewportHeight pixels tall with vertical field of view fovY (radians).
+size_t SCSelectLod(std::span<const SCMeshLod> lods, float distance, float fovY, float viewportHeight, float pixelError = 1.0f);
+// Same, at the distance from the camera to the nearest point of a bounding sphere. Inside it the
+// finest level is used. Lod errors must be in the same units as the sphere, i.e. scaled along
+// with it.
+size_t SCSelectLod(std::span<const SCMeshLod> lods, const DXCamera3D& camera, const SCVector3f& center, float radius,
+	float viewportHeight, float pixelError = 1.0f);
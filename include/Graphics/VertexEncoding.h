@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <Graphics/Vertex.h>
+#include <Math/Vector.h>
+
+// Opt-in compact vertex layouts. SCVertex (32 bytes) stays the authoring format; meshes can be
+// encoded into one of these before upload:
+//   Compact          float3 position, octahedral SNORM16 normal, half texcoord      (20 bytes)
+//   CompactQuantized UNORM16 position within per-mesh bounds, same normal/texcoord (16 bytes)
+enum class SCVertexFormat
+{
+	Standard,
+	Compact,
+	CompactQuantized
+};
+
+struct SCCompactVertex
+{
+	SCVector3f Position;
+	int16_t Normal[2];
+	uint16_t TexCoord[2];
+};
+
+struct SCQuantizedVertex
+{
+	uint16_t Position[4]; // w is padding, DXGI has no 3-channel 16-bit format
+	int16_t Normal[2];
+	uint16_t TexCoord[2];
+};
+
+// Dequantization parameters for CompactQuantized: position = Min + unorm * Extent.
+// Laid out to be uploaded as-is to the VertexQuantization cbuffer (b1) in basic.hlsl.
+struct SCVertexQuantization
+{
+	SCVector3f Min;
+	float Pad0 = 0;
+	SCVector3f Extent;
+	float Pad1 = 0;
+};
+
+class SCEncodedVertices
+{
+public:
+	SCVertexFormat Format = SCVertexFormat::Standard;
+	std::vector<uint8_t> Data;
+	size_t Count = 0;
+	SCVertexQuantization Quantization;
+
+	unsigned int Stride() const;
+};
+
+struct SCVertexEncodingError
+{
+	float MaxPositionError = 0;   // world units
+	float MaxNormalError = 0;     // radians
+	float MaxTexCoordError = 0;   // uv units
+	float MeanPositionError = 0;
+	float MeanNormalError = 0;
+	float MeanTexCoordError = 0;
+};
+
+unsigned int SCVertexStride(SCVertexFormat format);
+
+uint16_t SCFloatToHalf(float value);
+float SCHalfToFloat(uint16_t value);
+
+// Octahedral normal encoding into two SNORM16 components. The input must be unit length.
+void SCEncodeOctahedral(const SCVector3f& normal, int16_t out[2]);
+SCVector3f SCDecodeOctahedral(const int16_t encoded[2]);
+
+SCEncodedVertices SCEncodeVertices(std::span<const SCVertex> vertices, SCVertexFormat format);
+std::vector<SCVertex> SCDecodeVertices(const SCEncodedVertices& encoded);
+
+// Round-trips the original vertices through the encoded form and reports the worst and mean error.
+SCVertexEncodingError SCMeasureEncodingError(const std::vector<SCVertex>& original, const SCEncodedVertices& encoded);
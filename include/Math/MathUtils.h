@@ -1,3 +1,95 @@
 #pragma once
 #include <iostream>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
 
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define SC_SIMD_X86 1
+#endif
+
+// GCC/Clang need per-function target attributes to emit AVX2 code in a TU built for baseline SSE2.
+// MSVC emits any intrinsic it sees, so the macro is empty there.
+#if defined(SC_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SC_TARGET_AVX2
+#endif
+
+// Zero-division / zero-length checks in the vector and matrix ops. On by default in Debug,
+// compiled out in Release. Define SC_MATH_CHECKS to 0 or 1 to override.
+#if !defined(SC_MATH_CHECKS)
+#if defined(NDEBUG)
+#define SC_MATH_CHECKS 0
+#else
+#define SC_MATH_CHECKS 1
+#endif
+#endif
+
+struct SCMathChecks
+{
+	static constexpr bool Enabled = SC_MATH_CHECKS != 0;
+};
+
+// Out of line so the inline vector ops don't drag iostream code into every caller.
+void SCMathCheckFailed(const char* message);
+
+enum class SCSimdLevel
+{
+	Scalar = 0,
+	SSE,
+	AVX2
+};
+
+// Highest instruction set the running CPU supports. Detected once, then cached.
+SCSimdLevel SCGetSupportedSimdLevel();
+// Instruction set the batch kernels currently dispatch to.
+SCSimdLevel SCGetSimdLevel();
+// Forces the batch kernels down to a lower level (clamped to what the CPU supports). Mostly for benchmarking.
+void SCSetSimdLevel(SCSimdLevel level);
+
+constexpr float SC_PI = 3.14159265358979323846f;
+
+constexpr float SCToRadians(float degrees)
+{
+	return degrees * (SC_PI / 180.0f);
+}
+
+constexpr float SCToDegrees(float radians)
+{
+	return radians * (180.0f / SC_PI);
+}
+
+constexpr std::size_t SCAlignUp(std::size_t value, std::size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+template<typename T, std::size_t Alignment = 32>
+class SCAlignedAllocator
+{
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind { using other = SCAlignedAllocator<U, Alignment>; };
+
+	SCAlignedAllocator() noexcept = default;
+	template<typename U>
+	SCAlignedAllocator(const SCAlignedAllocator<U, Alignment>&) noexcept {}
+
+	T* allocate(std::size_t count)
+	{
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+	}
+
+	void deallocate(T* ptr, std::size_t) noexcept
+	{
+		::operator delete(ptr, std::align_val_t(Alignment));
+	}
+
+	template<typename U>
+	bool operator==(const SCAlignedAllocator<U, Alignment>&) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const SCAlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
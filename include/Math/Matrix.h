@@ -0,0 +1,233 @@
+#pragma once
+#include <cmath>
+#include <Math/MathUtils.h>
+#include <Math/Vector.h>
+
+#if defined(SC_SIMD_X86)
+#include <xmmintrin.h>
+#endif
+
+// 4x4 float matrix, row-major storage with the row-vector convention (v * M), same as DirectXMath.
+// Uploading one to an HLSL cbuffer without transposing and using mul(M, v) in the shader
+// therefore behaves exactly like the XMMATRIX upload did.
+class alignas(16) SCMatrix4f
+{
+public:
+	float M[4][4];
+
+	SCMatrix4f()
+		: M{ { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } {}
+
+	SCMatrix4f(float m00, float m01, float m02, float m03,
+		float m10, float m11, float m12, float m13,
+		float m20, float m21, float m22, float m23,
+		float m30, float m31, float m32, float m33)
+		: M{ { m00, m01, m02, m03 }, { m10, m11, m12, m13 }, { m20, m21, m22, m23 }, { m30, m31, m32, m33 } } {}
+
+	const float* Data() const { return &M[0][0]; }
+	float* Data() { return &M[0][0]; }
+
+	static SCMatrix4f Identity() { return SCMatrix4f(); }
+
+	static SCMatrix4f Translation(float x, float y, float z)
+	{
+		return SCMatrix4f(
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0,
+			x, y, z, 1);
+	}
+
+	static SCMatrix4f Scaling(float x, float y, float z)
+	{
+		return SCMatrix4f(
+			x, 0, 0, 0,
+			0, y, 0, 0,
+			0, 0, z, 0,
+			0, 0, 0, 1);
+	}
+
+	static SCMatrix4f RotationX(float angle)
+	{
+		const float s = std::sin(angle), c = std::cos(angle);
+		return SCMatrix4f(
+			1, 0, 0, 0,
+			0, c, s, 0,
+			0, -s, c, 0,
+			0, 0, 0, 1);
+	}
+
+	static SCMatrix4f RotationY(float angle)
+	{
+		const float s = std::sin(angle), c = std::cos(angle);
+		return SCMatrix4f(
+			c, 0, -s, 0,
+			0, 1, 0, 0,
+			s, 0, c, 0,
+			0, 0, 0, 1);
+	}
+
+	static SCMatrix4f RotationZ(float angle)
+	{
+		const float s = std::sin(angle), c = std::cos(angle);
+		return SCMatrix4f(
+			c, s, 0, 0,
+			-s, c, 0, 0,
+			0, 0, 1, 0,
+			0, 0, 0, 1);
+	}
+
+	static SCMatrix4f LookAtLH(const SCVector3f& eye, const SCVector3f& target, const SCVector3f& up)
+	{
+		return LookTo(eye, target.Subtract(eye).Normalize(), up);
+	}
+
+	static SCMatrix4f LookAtRH(const SCVector3f& eye, const SCVector3f& target, const SCVector3f& up)
+	{
+		return LookTo(eye, eye.Subtract(target).Normalize(), up);
+	}
+
+	// Maps view-space depth [nearZ, farZ] to [0, 1], as D3D expects.
+	static SCMatrix4f PerspectiveFovLH(float fovY, float aspectRatio, float nearZ, float farZ)
+	{
+		const float h = 1.0f / std::tan(fovY * 0.5f);
+		const float w = h / aspectRatio;
+		const float range = farZ / (farZ - nearZ);
+		return SCMatrix4f(
+			w, 0, 0, 0,
+			0, h, 0, 0,
+			0, 0, range, 1,
+			0, 0, -range * nearZ, 0);
+	}
+
+	static SCMatrix4f PerspectiveFovRH(float fovY, float aspectRatio, float nearZ, float farZ)
+	{
+		const float h = 1.0f / std::tan(fovY * 0.5f);
+		const float w = h / aspectRatio;
+		const float range = farZ / (nearZ - farZ);
+		return SCMatrix4f(
+			w, 0, 0, 0,
+			0, h, 0, 0,
+			0, 0, range, -1,
+			0, 0, range * nearZ, 0);
+	}
+
+	SCMatrix4f Multiply(const SCMatrix4f& other) const
+	{
+		SCMatrix4f result;
+#if defined(SC_SIMD_X86)
+		const __m128 b0 = _mm_load_ps(other.M[0]);
+		const __m128 b1 = _mm_load_ps(other.M[1]);
+		const __m128 b2 = _mm_load_ps(other.M[2]);
+		const __m128 b3 = _mm_load_ps(other.M[3]);
+		for (int i = 0; i < 4; i++)
+		{
+			__m128 r = _mm_mul_ps(_mm_set1_ps(M[i][0]), b0);
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(M[i][1]), b1));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(M[i][2]), b2));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(M[i][3]), b3));
+			_mm_store_ps(result.M[i], r);
+		}
+#else
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				result.M[i][j] = M[i][0] * other.M[0][j] + M[i][1] * other.M[1][j] + M[i][2] * other.M[2][j] + M[i][3] * other.M[3][j];
+#endif
+		return result;
+	}
+
+	SCMatrix4f operator*(const SCMatrix4f& other) const { return Multiply(other); }
+
+	SCMatrix4f Transpose() const
+	{
+		SCMatrix4f result = *this;
+#if defined(SC_SIMD_X86)
+		__m128 r0 = _mm_load_ps(M[0]), r1 = _mm_load_ps(M[1]), r2 = _mm_load_ps(M[2]), r3 = _mm_load_ps(M[3]);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_store_ps(result.M[0], r0);
+		_mm_store_ps(result.M[1], r1);
+		_mm_store_ps(result.M[2], r2);
+		_mm_store_ps(result.M[3], r3);
+#else
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				result.M[i][j] = M[j][i];
+#endif
+		return result;
+	}
+
+	// General inverse by cofactor expansion. A singular matrix yields identity and a zero determinant.
+	SCMatrix4f Inverse(float* determinant = nullptr) const
+	{
+		const float* m = Data();
+		float inv[16];
+
+		inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+		inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+		inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+		inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+		inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+		inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+		inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+		inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+		inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+		inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+		inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+		inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+		inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+		inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+		inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+		inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+		const float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+		if (determinant)
+			*determinant = det;
+		if (det == 0)
+			return SCMatrix4f();
+
+		SCMatrix4f result;
+		const float invDet = 1.0f / det;
+		for (int i = 0; i < 16; i++)
+			result.Data()[i] = inv[i] * invDet;
+		return result;
+	}
+
+	// Transforms a point (w = 1) without the projective divide.
+	SCVector3f TransformPoint(const SCVector3f& v) const
+	{
+		return SCVector3f(
+			v.X * M[0][0] + v.Y * M[1][0] + v.Z * M[2][0] + M[3][0],
+			v.X * M[0][1] + v.Y * M[1][1] + v.Z * M[2][1] + M[3][1],
+			v.X * M[0][2] + v.Y * M[1][2] + v.Z * M[2][2] + M[3][2]);
+	}
+
+	// Transforms a direction (w = 0), ignoring translation.
+	SCVector3f TransformNormal(const SCVector3f& v) const
+	{
+		return SCVector3f(
+			v.X * M[0][0] + v.Y * M[1][0] + v.Z * M[2][0],
+			v.X * M[0][1] + v.Y * M[1][1] + v.Z * M[2][1],
+			v.X * M[0][2] + v.Y * M[1][2] + v.Z * M[2][2]);
+	}
+
+	SCVector4f Transform(const SCVector4f& v) const
+	{
+		return SCVector4f(
+			v.X * M[0][0] + v.Y * M[1][0] + v.Z * M[2][0] + v.W * M[3][0],
+			v.X * M[0][1] + v.Y * M[1][1] + v.Z * M[2][1] + v.W * M[3][1],
+			v.X * M[0][2] + v.Y * M[1][2] + v.Z * M[2][2] + v.W * M[3][2],
+			v.X * M[0][3] + v.Y * M[1][3] + v.Z * M[2][3] + v.W * M[3][3]);
+	}
+
+private:
+	static SCMatrix4f LookTo(const SCVector3f& eye, const SCVector3f& zAxis, const SCVector3f& up)
+	{
+		const SCVector3f xAxis = up.Cross(zAxis).Normalize();
+		const SCVector3f yAxis = zAxis.Cross(xAxis);
+		return SCMatrix4f(
+			xAxis.X, yAxis.X, zAxis.X, 0,
+			xAxis.Y, yAxis.Y, zAxis.Y, 0,
+			xAxis.Z, yAxis.Z, zAxis.Z, 0,
+			-xAxis.Dot(eye), -yAxis.Dot(eye), -zAxis.Dot(eye), 1);
+	}
+};
@@ -0,0 +1,133 @@
+#pragma once
+#include <cmath>
+#include <Math/MathUtils.h>
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
+
+#if defined(SC_SIMD_X86)
+#include <xmmintrin.h>
+#endif
+
+// Rotation quaternion. Multiply composes in the same order as SCMatrix4f:
+// a.Multiply(b) rotates by a first, then by b.
+class alignas(16) SCQuaternion
+{
+public:
+	float X, Y, Z, W;
+
+	SCQuaternion(float x = 0, float y = 0, float z = 0, float w = 1) : X(x), Y(y), Z(z), W(w) {}
+
+	static SCQuaternion Identity() { return SCQuaternion(); }
+
+	static SCQuaternion FromAxisAngle(const SCVector3f& axis, float angle)
+	{
+		const SCVector3f n = axis.Normalize();
+		const float s = std::sin(angle * 0.5f);
+		return SCQuaternion(n.X * s, n.Y * s, n.Z * s, std::cos(angle * 0.5f));
+	}
+
+	// Roll about Z, then pitch about X, then yaw about Y (same order as XMQuaternionRotationRollPitchYaw).
+	static SCQuaternion FromEuler(float pitch, float yaw, float roll)
+	{
+		return FromAxisAngle(SCVector3f(0, 0, 1), roll)
+			.Multiply(FromAxisAngle(SCVector3f(1, 0, 0), pitch))
+			.Multiply(FromAxisAngle(SCVector3f(0, 1, 0), yaw));
+	}
+
+	SCQuaternion Multiply(const SCQuaternion& other) const
+	{
+		// Hamilton product other * this, so that the left operand is applied first.
+		const SCQuaternion& a = other;
+		const SCQuaternion& b = *this;
+		return SCQuaternion(
+			a.W * b.X + a.X * b.W + a.Y * b.Z - a.Z * b.Y,
+			a.W * b.Y - a.X * b.Z + a.Y * b.W + a.Z * b.X,
+			a.W * b.Z + a.X * b.Y - a.Y * b.X + a.Z * b.W,
+			a.W * b.W - a.X * b.X - a.Y * b.Y - a.Z * b.Z);
+	}
+
+	SCQuaternion operator*(const SCQuaternion& other) const { return Multiply(other); }
+
+	float Dot(const SCQuaternion& other) const
+	{
+		return X * other.X + Y * other.Y + Z * other.Z + W * other.W;
+	}
+
+	SCQuaternion Conjugate() const { return SCQuaternion(-X, -Y, -Z, W); }
+
+	SCQuaternion Normalize() const
+	{
+#if defined(SC_SIMD_X86)
+		SCQuaternion result;
+		const __m128 q = _mm_load_ps(&X);
+		__m128 lengthSq = _mm_mul_ps(q, q);
+		lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(2, 3, 0, 1)));
+		lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1, 0, 3, 2)));
+		if (_mm_cvtss_f32(lengthSq) == 0)
+			return *this;
+		_mm_store_ps(&result.X, _mm_div_ps(q, _mm_sqrt_ps(lengthSq)));
+		return result;
+#else
+		const float length = std::sqrt(Dot(*this));
+		if (length == 0)
+			return *this;
+		return SCQuaternion(X / length, Y / length, Z / length, W / length);
+#endif
+	}
+
+	// Inverse of a unit quaternion.
+	SCQuaternion Inverse() const
+	{
+		const float lengthSq = Dot(*this);
+		if (lengthSq == 0)
+			return *this;
+		const SCQuaternion c = Conjugate();
+		return SCQuaternion(c.X / lengthSq, c.Y / lengthSq, c.Z / lengthSq, c.W / lengthSq);
+	}
+
+	SCVector3f Rotate(const SCVector3f& v) const
+	{
+		const SCVector3f q(X, Y, Z);
+		const SCVector3f t = q.Cross(v).ScalarMultiply(2.0f);
+		return v.Add(t.ScalarMultiply(W)).Add(q.Cross(t));
+	}
+
+	SCMatrix4f ToMatrix() const
+	{
+		const float xx = X * X, yy = Y * Y, zz = Z * Z;
+		const float xy = X * Y, xz = X * Z, yz = Y * Z;
+		const float wx = W * X, wy = W * Y, wz = W * Z;
+		return SCMatrix4f(
+			1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0,
+			2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0,
+			2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0,
+			0, 0, 0, 1);
+	}
+
+	static SCQuaternion Slerp(const SCQuaternion& a, const SCQuaternion& b, float t)
+	{
+		float cosTheta = a.Dot(b);
+		SCQuaternion end = b;
+		if (cosTheta < 0)
+		{
+			cosTheta = -cosTheta;
+			end = SCQuaternion(-b.X, -b.Y, -b.Z, -b.W);
+		}
+
+		float wa = 1.0f - t, wb = t;
+		// Fall back to lerp when the angle is tiny to avoid dividing by sin(~0).
+		if (cosTheta < 0.9995f)
+		{
+			const float theta = std::acos(cosTheta);
+			const float sinTheta = std::sin(theta);
+			wa = std::sin((1.0f - t) * theta) / sinTheta;
+			wb = std::sin(t * theta) / sinTheta;
+		}
+
+		return SCQuaternion(
+			a.X * wa + end.X * wb,
+			a.Y * wa + end.Y * wb,
+			a.Z * wa + end.Z * wb,
+			a.W * wa + end.W * wb).Normalize();
+	}
+};
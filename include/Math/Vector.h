@@ -1,20 +1,64 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <Math/MathUtils.h>
+
+// All vector ops are header-inline so they fold into callers. Divide/Normalize guard against
+// zero through SCMathChecks, which is compiled out in Release (see MathUtils.h); there the caller
+// is responsible for not dividing by zero.
+
 class SCVector2i
 {
 public:
 	int X, Y;
 
-    SCVector2i Multiply(const SCVector2i& other) const;
-    SCVector2i Divide(const SCVector2i& other) const;
-    SCVector2i Add(const SCVector2i& other) const;
-    SCVector2i Subtract(const SCVector2i& other) const;
-    int Dot(const SCVector2i& other) const;
-    int Cross(const SCVector2i& other) const;
-    SCVector2i Normalize() const;
-    SCVector2i ScalarMultiply(float scalar) const;
-    SCVector2i Clamp(int min, int max) const;
-
-	SCVector2i(int x = 0, int y = 0) : X(x), Y(y) {}
+    constexpr SCVector2i Multiply(const SCVector2i& other) const { return { X * other.X, Y * other.Y }; }
+    constexpr SCVector2i Divide(const SCVector2i& other) const
+    {
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (other.X == 0 || other.Y == 0)
+            {
+                SCMathCheckFailed("Vector2i division by zero is unavailable.");
+                return *this;
+            }
+        }
+        return { X / other.X, Y / other.Y };
+    }
+    constexpr SCVector2i Add(const SCVector2i& other) const { return { X + other.X, Y + other.Y }; }
+    constexpr SCVector2i Subtract(const SCVector2i& other) const { return { X - other.X, Y - other.Y }; }
+    constexpr int Dot(const SCVector2i& other) const { return X * other.X + Y * other.Y; }
+    constexpr int Cross(const SCVector2i& other) const { return X * other.Y - Y * other.X; }
+    SCVector2i Normalize() const
+    {
+        float length = std::sqrt(static_cast<float>(X * X + Y * Y));
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (length == 0)
+            {
+                SCMathCheckFailed("Vector2i normalization of length 0 is unavailable.");
+                return *this;
+            }
+        }
+        return { static_cast<int>(X / length), static_cast<int>(Y / length) };
+    }
+    constexpr SCVector2i ScalarMultiply(float scalar) const { return { static_cast<int>(X * scalar), static_cast<int>(Y * scalar) }; }
+    constexpr SCVector2i Clamp(int min, int max) const { return { std::clamp(X, min, max), std::clamp(Y, min, max) }; }
+
+    constexpr SCVector2i operator+(const SCVector2i& other) const { return Add(other); }
+    constexpr SCVector2i operator-(const SCVector2i& other) const { return Subtract(other); }
+    constexpr SCVector2i operator*(const SCVector2i& other) const { return Multiply(other); }
+    constexpr SCVector2i operator/(const SCVector2i& other) const { return Divide(other); }
+    constexpr SCVector2i operator*(float scalar) const { return ScalarMultiply(scalar); }
+    constexpr SCVector2i operator-() const { return { -X, -Y }; }
+    constexpr SCVector2i& operator+=(const SCVector2i& other) { return *this = Add(other); }
+    constexpr SCVector2i& operator-=(const SCVector2i& other) { return *this = Subtract(other); }
+    constexpr SCVector2i& operator*=(const SCVector2i& other) { return *this = Multiply(other); }
+    constexpr SCVector2i& operator/=(const SCVector2i& other) { return *this = Divide(other); }
+    constexpr bool operator==(const SCVector2i& other) const { return X == other.X && Y == other.Y; }
+    constexpr bool operator!=(const SCVector2i& other) const { return !(*this == other); }
+
+	constexpr SCVector2i(int x = 0, int y = 0) : X(x), Y(y) {}
 };
 
 class SCVector2f
@@ -22,17 +66,56 @@ class SCVector2f
 public:
     float X, Y;
 
-    SCVector2f Multiply(const SCVector2f& other) const;
-    SCVector2f Divide(const SCVector2f& other) const;
-    SCVector2f Add(const SCVector2f& other) const;
-    SCVector2f Subtract(const SCVector2f& other) const;
-    float Dot(const SCVector2f& other) const;
-    float Cross(const SCVector2f& other) const;
-    SCVector2f Normalize() const;
-    SCVector2f ScalarMultiply(float scalar) const;
-    SCVector2f Clamp(float min, float max) const;
-
-    SCVector2f(float x = 0, float y = 0) : X(x), Y(y) {}
+    constexpr SCVector2f Multiply(const SCVector2f& other) const { return { X * other.X, Y * other.Y }; }
+    constexpr SCVector2f Divide(const SCVector2f& other) const
+    {
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (other.X == 0 || other.Y == 0)
+            {
+                SCMathCheckFailed("Vector2f division by zero is unavailable.");
+                return *this;
+            }
+        }
+        return { X / other.X, Y / other.Y };
+    }
+    constexpr SCVector2f Add(const SCVector2f& other) const { return { X + other.X, Y + other.Y }; }
+    constexpr SCVector2f Subtract(const SCVector2f& other) const { return { X - other.X, Y - other.Y }; }
+    constexpr float Dot(const SCVector2f& other) const { return X * other.X + Y * other.Y; }
+    constexpr float Cross(const SCVector2f& other) const { return X * other.Y - Y * other.X; }
+    constexpr float LengthSquared() const { return Dot(*this); }
+    float Length() const { return std::sqrt(LengthSquared()); }
+    SCVector2f Normalize() const
+    {
+        float length = Length();
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (length == 0)
+            {
+                SCMathCheckFailed("Vector2f normalization of length 0 is unavailable.");
+                return *this;
+            }
+        }
+        return { X / length, Y / length };
+    }
+    constexpr SCVector2f ScalarMultiply(float scalar) const { return { X * scalar, Y * scalar }; }
+    constexpr SCVector2f Clamp(float min, float max) const { return { std::clamp(X, min, max), std::clamp(Y, min, max) }; }
+
+    constexpr SCVector2f operator+(const SCVector2f& other) const { return Add(other); }
+    constexpr SCVector2f operator-(const SCVector2f& other) const { return Subtract(other); }
+    constexpr SCVector2f operator*(const SCVector2f& other) const { return Multiply(other); }
+    constexpr SCVector2f operator/(const SCVector2f& other) const { return Divide(other); }
+    constexpr SCVector2f operator*(float scalar) const { return ScalarMultiply(scalar); }
+    constexpr SCVector2f operator-() const { return { -X, -Y }; }
+    constexpr SCVector2f& operator+=(const SCVector2f& other) { return *this = Add(other); }
+    constexpr SCVector2f& operator-=(const SCVector2f& other) { return *this = Subtract(other); }
+    constexpr SCVector2f& operator*=(const SCVector2f& other) { return *this = Multiply(other); }
+    constexpr SCVector2f& operator/=(const SCVector2f& other) { return *this = Divide(other); }
+    constexpr SCVector2f& operator*=(float scalar) { return *this = ScalarMultiply(scalar); }
+    constexpr bool operator==(const SCVector2f& other) const { return X == other.X && Y == other.Y; }
+    constexpr bool operator!=(const SCVector2f& other) const { return !(*this == other); }
+
+    constexpr SCVector2f(float x = 0, float y = 0) : X(x), Y(y) {}
 };
 
 class SCVector3f
@@ -40,23 +123,127 @@ class SCVector3f
 public:
     float X, Y, Z;
 
-    SCVector3f Multiply(const SCVector3f& other) const;
-    SCVector3f Divide(const SCVector3f& other) const;
-    SCVector3f Add(const SCVector3f& other) const;
-    SCVector3f Subtract(const SCVector3f& other) const;
-    float Dot(const SCVector3f& other) const;
-    SCVector3f Cross(const SCVector3f& other) const;
-    SCVector3f Normalize() const;
-    SCVector3f ScalarMultiply(float scalar) const;
-    SCVector3f Clamp(float min, float max) const;
-
-    SCVector3f(float x = 0, float y = 0, float z = 0) : X(x), Y(y), Z(z) {}
+    constexpr SCVector3f Multiply(const SCVector3f& other) const { return { X * other.X, Y * other.Y, Z * other.Z }; }
+    constexpr SCVector3f Divide(const SCVector3f& other) const
+    {
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (other.X == 0 || other.Y == 0 || other.Z == 0)
+            {
+                SCMathCheckFailed("Vector3f division by zero is unavailable.");
+                return *this;
+            }
+        }
+        return { X / other.X, Y / other.Y, Z / other.Z };
+    }
+    constexpr SCVector3f Add(const SCVector3f& other) const { return { X + other.X, Y + other.Y, Z + other.Z }; }
+    constexpr SCVector3f Subtract(const SCVector3f& other) const { return { X - other.X, Y - other.Y, Z - other.Z }; }
+    constexpr float Dot(const SCVector3f& other) const { return X * other.X + Y * other.Y + Z * other.Z; }
+    constexpr SCVector3f Cross(const SCVector3f& other) const
+    {
+        return {
+            Y * other.Z - Z * other.Y,
+            Z * other.X - X * other.Z,
+            X * other.Y - Y * other.X
+        };
+    }
+    constexpr float LengthSquared() const { return Dot(*this); }
+    float Length() const { return std::sqrt(LengthSquared()); }
+    SCVector3f Normalize() const
+    {
+        float length = Length();
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (length == 0)
+            {
+                SCMathCheckFailed("Vector3f normalization of length 0 is unavailable.");
+                return *this;
+            }
+        }
+        return { X / length, Y / length, Z / length };
+    }
+    constexpr SCVector3f ScalarMultiply(float scalar) const { return { X * scalar, Y * scalar, Z * scalar }; }
+    constexpr SCVector3f Clamp(float min, float max) const { return { std::clamp(X, min, max), std::clamp(Y, min, max), std::clamp(Z, min, max) }; }
+
+    constexpr SCVector3f operator+(const SCVector3f& other) const { return Add(other); }
+    constexpr SCVector3f operator-(const SCVector3f& other) const { return Subtract(other); }
+    constexpr SCVector3f operator*(const SCVector3f& other) const { return Multiply(other); }
+    constexpr SCVector3f operator/(const SCVector3f& other) const { return Divide(other); }
+    constexpr SCVector3f operator*(float scalar) const { return ScalarMultiply(scalar); }
+    constexpr SCVector3f operator-() const { return { -X, -Y, -Z }; }
+    constexpr SCVector3f& operator+=(const SCVector3f& other) { return *this = Add(other); }
+    constexpr SCVector3f& operator-=(const SCVector3f& other) { return *this = Subtract(other); }
+    constexpr SCVector3f& operator*=(const SCVector3f& other) { return *this = Multiply(other); }
+    constexpr SCVector3f& operator/=(const SCVector3f& other) { return *this = Divide(other); }
+    constexpr SCVector3f& operator*=(float scalar) { return *this = ScalarMultiply(scalar); }
+    constexpr bool operator==(const SCVector3f& other) const { return X == other.X && Y == other.Y && Z == other.Z; }
+    constexpr bool operator!=(const SCVector3f& other) const { return !(*this == other); }
+
+    constexpr SCVector3f(float x = 0, float y = 0, float z = 0) : X(x), Y(y), Z(z) {}
 };
 
 class SCVector4f
 {
 public:
     float X, Y, Z, W;
-    SCVector4f(float x = 0, float y = 0, float z = 0, float w = 0) : X(x), Y(y), Z(z), W(w) {}
-    // to-do: add in extra functions, prob.
-};
\ No newline at end of file
+
+    constexpr SCVector4f Multiply(const SCVector4f& other) const { return { X * other.X, Y * other.Y, Z * other.Z, W * other.W }; }
+    constexpr SCVector4f Divide(const SCVector4f& other) const
+    {
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (other.X == 0 || other.Y == 0 || other.Z == 0 || other.W == 0)
+            {
+                SCMathCheckFailed("Vector4f division by zero is unavailable.");
+                return *this;
+            }
+        }
+        return { X / other.X, Y / other.Y, Z / other.Z, W / other.W };
+    }
+    constexpr SCVector4f Add(const SCVector4f& other) const { return { X + other.X, Y + other.Y, Z + other.Z, W + other.W }; }
+    constexpr SCVector4f Subtract(const SCVector4f& other) const { return { X - other.X, Y - other.Y, Z - other.Z, W - other.W }; }
+    constexpr float Dot(const SCVector4f& other) const { return X * other.X + Y * other.Y + Z * other.Z + W * other.W; }
+    constexpr float LengthSquared() const { return Dot(*this); }
+    float Length() const { return std::sqrt(LengthSquared()); }
+    SCVector4f Normalize() const
+    {
+        float length = Length();
+        if constexpr (SCMathChecks::Enabled)
+        {
+            if (length == 0)
+            {
+                SCMathCheckFailed("Vector4f normalization of length 0 is unavailable.");
+                return *this;
+            }
+        }
+        return { X / length, Y / length, Z / length, W / length };
+    }
+    constexpr SCVector4f ScalarMultiply(float scalar) const { return { X * scalar, Y * scalar, Z * scalar, W * scalar }; }
+    constexpr SCVector4f Clamp(float min, float max) const
+    {
+        return { std::clamp(X, min, max), std::clamp(Y, min, max), std::clamp(Z, min, max), std::clamp(W, min, max) };
+    }
+    constexpr SCVector3f XYZ() const { return { X, Y, Z }; }
+
+    constexpr SCVector4f operator+(const SCVector4f& other) const { return Add(other); }
+    constexpr SCVector4f operator-(const SCVector4f& other) const { return Subtract(other); }
+    constexpr SCVector4f operator*(const SCVector4f& other) const { return Multiply(other); }
+    constexpr SCVector4f operator/(const SCVector4f& other) const { return Divide(other); }
+    constexpr SCVector4f operator*(float scalar) const { return ScalarMultiply(scalar); }
+    constexpr SCVector4f operator-() const { return { -X, -Y, -Z, -W }; }
+    constexpr SCVector4f& operator+=(const SCVector4f& other) { return *this = Add(other); }
+    constexpr SCVector4f& operator-=(const SCVector4f& other) { return *this = Subtract(other); }
+    constexpr SCVector4f& operator*=(const SCVector4f& other) { return *this = Multiply(other); }
+    constexpr SCVector4f& operator/=(const SCVector4f& other) { return *this = Divide(other); }
+    constexpr SCVector4f& operator*=(float scalar) { return *this = ScalarMultiply(scalar); }
+    constexpr bool operator==(const SCVector4f& other) const { return X == other.X && Y == other.Y && Z == other.Z && W == other.W; }
+    constexpr bool operator!=(const SCVector4f& other) const { return !(*this == other); }
+
+    constexpr SCVector4f(float x = 0, float y = 0, float z = 0, float w = 0) : X(x), Y(y), Z(z), W(w) {}
+    constexpr SCVector4f(const SCVector3f& xyz, float w) : X(xyz.X), Y(xyz.Y), Z(xyz.Z), W(w) {}
+};
+
+constexpr SCVector2i operator*(float scalar, const SCVector2i& v) { return v.ScalarMultiply(scalar); }
+constexpr SCVector2f operator*(float scalar, const SCVector2f& v) { return v.ScalarMultiply(scalar); }
+constexpr SCVector3f operator*(float scalar, const SCVector3f& v) { return v.ScalarMultiply(scalar); }
+constexpr SCVector4f operator*(float scalar, const SCVector4f& v) { return v.ScalarMultiply(scalar); }
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <Math/MathUtils.h>
+#include <Math/Vector.h>
+#include <Math/Matrix.h>
+
+using SCFloatStream = std::vector<float, SCAlignedAllocator<float, 32>>;
+
+// Structure-of-arrays storage for batches of SCVector3f.
+// Each component lives in its own 32-byte aligned array padded to a multiple of Lanes,
+// so the SIMD kernels never need a scalar tail loop. Padding lanes are kept at zero.
+class SCVector3fStream
+{
+public:
+	static constexpr size_t Lanes = 8;
+
+	SCFloatStream X, Y, Z;
+
+	SCVector3fStream() = default;
+	explicit SCVector3fStream(size_t count) { Resize(count); }
+
+	void Resize(size_t count);
+	void Clear();
+	size_t Size() const { return Count; }
+	size_t PaddedSize() const { return X.size(); }
+
+	void Set(size_t index, const SCVector3f& v) { X[index] = v.X; Y[index] = v.Y; Z[index] = v.Z; }
+	SCVector3f Get(size_t index) const { return SCVector3f(X[index], Y[index], Z[index]); }
+
+	// AoS <-> SoA conversion. stride is in bytes, so this works on SCVertex arrays directly.
+	void Gather(const SCVector3f* src, size_t count, size_t stride = sizeof(SCVector3f));
+	void Scatter(SCVector3f* dst, size_t stride = sizeof(SCVector3f)) const;
+
+	// Batch kernels. Output may alias either input.
+	void Add(const SCVector3fStream& other, SCVector3fStream& out) const;
+	void Subtract(const SCVector3fStream& other, SCVector3fStream& out) const;
+	void Multiply(const SCVector3fStream& other, SCVector3fStream& out) const;
+	void ScalarMultiply(float scalar, SCVector3fStream& out) const;
+	void Dot(const SCVector3fStream& other, SCFloatStream& out) const;
+	void Cross(const SCVector3fStream& other, SCVector3fStream& out) const;
+	// Zero-length vectors are passed through unchanged, same as SCVector3f::Normalize.
+	void Normalize(SCVector3fStream& out) const;
+	// Transforms points (w = 1) by a row-major 4x4 matrix using the row-vector convention (v * M),
+	// matching DirectXMath. The projective divide is not applied.
+	void Transform(const float matrix[16], SCVector3fStream& out) const;
+	void Transform(const SCMatrix4f& matrix, SCVector3fStream& out) const { Transform(matrix.Data(), out); }
+
+private:
+	size_t Count = 0;
+
+	void ZeroPadding();
+};
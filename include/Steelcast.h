@@ -3,4 +3,6 @@
 #include <Core/Window.h>
 #include <Events/EventArgs.h>
 #include <Events/Events.h>
-#include <Events/EventSystem.h>
\ No newline at end of file
+#include <Events/EventSystem.h>
+#include <Events/EventChannel.h>
+#include <Core/Task.h>
\ No newline at end of file
@@ -12,7 +12,7 @@ project "Steelcast"
     objdir ("bin-int/%{cfg.buildcfg}/%{prj.name}")
 
     files { "src/**.cpp", "src/**.h", "include/**.h" }
-    includedirs { "third_party/SDL/include", "C:/Program Files (x86)/Windows Kits/10/Include/10.0.22621.0/um", "include",  "third_party/glm/"}
+    includedirs { "third_party/SDL/include", "C:/Program Files (x86)/Windows Kits/10/Include/10.0.22621.0/um", "include" }
     
     libdirs { "third_party/SDL/VisualC/x64/Release", os.findlib("d3d11.lib"), os.findlib("dxgi.lib"), os.findlib("d3dcompiler.lib") }
     links { "SDL3", "d3d11", "d3dcompiler", "dxgi" }
@@ -36,3 +36,51 @@ project "Steelcast"
     filter "configurations:Release"
         defines { "NDEBUG" }
         optimize "On"
+
+-- Benchmarks and checks for the parts of the engine that need no window or device (see
+-- bench/Bench.h). Only the engine sources they exercise are compiled in.
+project "SteelcastBench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    targetdir ("bin/%{cfg.buildcfg}/%{prj.name}")
+    objdir ("bin-int/%{cfg.buildcfg}/%{prj.name}")
+
+    files {
+        "bench/**.cpp", "bench/**.h",
+        "src/Assets/AssetArchive.cpp",
+        "src/Assets/AssetFileSystem.cpp",
+        "src/Assets/AssetId.cpp",
+        "src/Assets/GltfImporter.cpp",
+        "src/Assets/MeshFile.cpp",
+        "src/Assets/MeshImporter.cpp",
+        "src/Assets/ObjImporter.cpp",
+        "src/Core/Compression.cpp",
+        "src/Core/DerivedDataCache.cpp",
+        "src/Core/MappedFile.cpp",
+        "src/Events/EventDispatchTable.cpp",
+        "src/Events/EventPool.cpp",
+        "src/Events/EventStats.cpp",
+        "src/Events/EventSystem.cpp",
+        "src/Events/EventTimers.cpp",
+        "src/Events/EventWorkerPool.cpp",
+        "src/Graphics/Camera.cpp",
+        "src/Graphics/IndexEncoding.cpp",
+        "src/Graphics/MeshOptimizer.cpp",
+        "src/Graphics/MeshSimplifier.cpp",
+        "src/Graphics/VertexEncoding.cpp",
+        "src/Math/MathUtils.cpp",
+        "src/Math/VectorStream.cpp"
+    }
+    includedirs { "include" }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "configurations:Debug"
+        defines { "DEBUG", "_DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+        optimize "On"
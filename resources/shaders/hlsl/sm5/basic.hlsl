@@ -1,7 +1,16 @@
+// SC_VERTEX_COMPACT / SC_VERTEX_QUANTIZED are defined by DX11Shader for the compact SCVertexFormats.
 struct VS_INPUT
 {
+#if defined(SC_VERTEX_QUANTIZED)
+    float4 Pos : POSITION; // UNORM16, dequantized with VertexQuantization
+#else
     float3 Pos : POSITION;
+#endif
+#if defined(SC_VERTEX_COMPACT)
+    float2 Normal : NORMAL; // octahedral SNORM16
+#else
     float3 Normal : NORMAL;
+#endif
     float2 TexCoord : TEXCOORD;
 };
 
@@ -18,12 +27,40 @@ cbuffer MatrixBuffer : register(b0)
     matrix MVP;
 };
 
+#if defined(SC_VERTEX_QUANTIZED)
+cbuffer VertexQuantization : register(b1)
+{
+    float3 PositionMin;
+    float3 PositionExtent;
+};
+#endif
+
+#if defined(SC_VERTEX_COMPACT)
+float3 OctDecode(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0)
+    {
+        n.xy = (1.0 - abs(n.yx)) * (n.xy >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+#endif
+
 PS_INPUT VS_Main(VS_INPUT input)
 {
     PS_INPUT output;
+#if defined(SC_VERTEX_QUANTIZED)
+    float4 pos = float4(PositionMin + input.Pos.xyz * PositionExtent, 1.0);
+#else
     float4 pos = float4(input.Pos, 1.0);
+#endif
     output.Pos = mul(MVP, pos);
+#if defined(SC_VERTEX_COMPACT)
+    output.normal = OctDecode(input.Normal);
+#else
     output.normal = input.Normal;
+#endif
     return output;
 }
 
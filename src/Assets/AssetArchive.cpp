@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <Assets/AssetArchive.h>
+#include <Assets/AssetId.h>
+#include <Core/Compression.h>
+
+std::string NormalizeAssetPath(std::string_view path)
+{
+	std::vector<std::string_view> segments;
+	while (!path.empty())
+	{
+		const size_t end = path.find_first_of("/\\");
+		const std::string_view segment = path.substr(0, end);
+		path = end == std::string_view::npos ? std::string_view() : path.substr(end + 1);
+
+		if (segment.empty() || segment == ".")
+			continue;
+		if (segment == ".." && !segments.empty() && segments.back() != "..")
+			segments.pop_back();
+		else
+			segments.push_back(segment);
+	}
+
+	std::string normalized;
+	for (std::string_view segment : segments)
+	{
+		if (!normalized.empty())
+			normalized.push_back('/');
+		normalized.append(segment);
+	}
+	return normalized;
+}
+
+static bool EntryLess(const ArchiveEntry& entry, std::string_view entryName, uint64_t hash, std::string_view path)
+{
+	return entry.PathHash != hash ? entry.PathHash < hash : entryName < path;
+}
+
+bool AssetArchive::Open(const std::string& path)
+{
+	Path = path;
+	Header = nullptr;
+	if (!File.Open(path))
+	{
+		std::cerr << "[ENGINE][ASSETS]: Could not map archive " << path << std::endl;
+		return false;
+	}
+
+	const uint64_t size = File.GetSize();
+	const ArchiveHeader* header = reinterpret_cast<const ArchiveHeader*>(File.GetData());
+	const char* problem = nullptr;
+	if (size < sizeof(ArchiveHeader) || std::memcmp(header->Magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0)
+		problem = "not a .scpak file";
+	else if (header->Version == 0 || header->Version > ArchiveVersion)
+		problem = "unsupported version";
+	else if (header->HeaderSize < sizeof(ArchiveHeader) || header->HeaderSize > size)
+		problem = "bad header size";
+	else if (header->TocOffset % alignof(ArchiveEntry) != 0 || header->TocOffset > size ||
+		header->EntryCount > (size - header->TocOffset) / sizeof(ArchiveEntry))
+		problem = "table of contents out of bounds";
+	else if (header->NamesOffset > size || header->NamesSize > size - header->NamesOffset)
+		problem = "names out of bounds";
+
+	if (!problem)
+	{
+		Entries = { reinterpret_cast<const ArchiveEntry*>(File.GetData() + header->TocOffset), header->EntryCount };
+		Names = { reinterpret_cast<const char*>(File.GetData() + header->NamesOffset), static_cast<size_t>(header->NamesSize) };
+
+		// One pass up front so lookups can trust every record.
+		for (size_t i = 0; i < Entries.size() && !problem; i++)
+		{
+			const ArchiveEntry& entry = Entries[i];
+			const bool compressed = (entry.Flags & ARCHIVE_ENTRY_COMPRESSED) != 0;
+			if (entry.Offset % ArchiveAlignment != 0 || entry.Offset > size || entry.StoredSize > size - entry.Offset)
+				problem = "entry out of bounds or misaligned";
+			else if (entry.NameOffset > Names.size() || entry.NameLength > Names.size() - entry.NameOffset)
+				problem = "entry name out of bounds";
+			else if (!compressed && entry.Size != entry.StoredSize)
+				problem = "stored entry size mismatch";
+			// An LZ4 byte expands to at most 255, so anything larger is corrupt; checked here so
+			// a bad size can't turn into a huge allocation when the entry is opened.
+			else if (compressed && (entry.StoredSize == 0 || entry.Size > entry.StoredSize * 255))
+				problem = "compressed entry size out of range";
+			else if (entry.PathHash != AssetId::HashPath(GetName(entry)))
+				problem = "entry hash mismatch";
+			else if (i > 0 && !EntryLess(Entries[i - 1], GetName(Entries[i - 1]), entry.PathHash, GetName(entry)))
+				problem = "table of contents not sorted";
+		}
+	}
+
+	if (problem)
+	{
+		std::cerr << "[ENGINE][ASSETS]: Invalid archive " << path << ": " << problem << std::endl;
+		Entries = {};
+		Names = {};
+		File.Close();
+		return false;
+	}
+
+	Header = header;
+	return true;
+}
+
+const ArchiveEntry* AssetArchive::Find(std::string_view path, uint64_t hash) const
+{
+	auto entry = std::lower_bound(Entries.begin(), Entries.end(), hash,
+		[](const ArchiveEntry& entry, uint64_t hash) { return entry.PathHash < hash; });
+	for (; entry != Entries.end() && entry->PathHash == hash; ++entry)
+		if (GetName(*entry) == path)
+			return &*entry;
+	return nullptr;
+}
+
+const ArchiveEntry* AssetArchive::Find(std::string_view path) const
+{
+	const std::string normalized = NormalizeAssetPath(path);
+	return Find(normalized, AssetId::HashPath(normalized));
+}
+
+void AssetArchive::Prefetch(const ArchiveEntry& entry, size_t offset, size_t size) const
+{
+	offset = std::min<uint64_t>(offset, entry.StoredSize);
+	File.Prefetch(entry.Offset + offset, std::min<uint64_t>(size, entry.StoredSize - offset));
+}
+
+// Writing
+
+static void PadTo(std::ofstream& out, uint64_t& position, uint64_t alignment)
+{
+	static const char zeros[ArchiveAlignment] = {};
+	const uint64_t padding = (alignment - position % alignment) % alignment;
+	out.write(zeros, static_cast<std::streamsize>(padding));
+	position += padding;
+}
+
+bool WriteAssetArchive(const std::string& archivePath, const std::vector<std::string>& files, bool compress)
+{
+	struct Source
+	{
+		std::string File;
+		std::string Name;
+		uint64_t Hash;
+	};
+	std::vector<Source> sources;
+	sources.reserve(files.size());
+	for (const std::string& file : files)
+	{
+		std::string name = NormalizeAssetPath(file);
+		const uint64_t hash = AssetId::HashPath(name);
+		sources.push_back({ file, std::move(name), hash });
+	}
+	std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b)
+		{
+			return a.Hash != b.Hash ? a.Hash < b.Hash : a.Name < b.Name;
+		});
+	for (size_t i = 1; i < sources.size(); i++)
+	{
+		if (sources[i].Name == sources[i - 1].Name)
+		{
+			std::cerr << "[ENGINE][ASSETS]: " << sources[i - 1].File << " and " << sources[i].File << " have the same archive path." << std::endl;
+			return false;
+		}
+	}
+
+	std::ofstream out(archivePath, std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		std::cerr << "[ENGINE][ASSETS]: Could not write archive " << archivePath << std::endl;
+		return false;
+	}
+
+	ArchiveHeader header = {};
+	std::memcpy(header.Magic, ArchiveMagic, sizeof(ArchiveMagic));
+	header.Version = ArchiveVersion;
+	header.HeaderSize = sizeof(ArchiveHeader);
+	header.EntryCount = static_cast<uint32_t>(sources.size());
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	uint64_t position = sizeof(header);
+
+	std::vector<ArchiveEntry> entries;
+	std::string names;
+	std::vector<uint8_t> compressed;
+	for (const Source& source : sources)
+	{
+		std::ifstream in(source.File, std::ios::binary);
+		if (!in)
+		{
+			std::cerr << "[ENGINE][ASSETS]: Could not read " << source.File << " for archive " << archivePath << std::endl;
+			return false;
+		}
+		const std::vector<uint8_t> data{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+
+		ArchiveEntry entry = {};
+		entry.PathHash = source.Hash;
+		entry.Size = data.size();
+		entry.NameOffset = static_cast<uint32_t>(names.size());
+		entry.NameLength = static_cast<uint32_t>(source.Name.size());
+		names += source.Name;
+
+		std::span<const uint8_t> stored = data;
+		if (compress && !data.empty())
+		{
+			compressed.resize(SCCompressBound(data.size()));
+			const size_t size = SCCompress(data, compressed);
+			if (size > 0 && size <= data.size() - data.size() / 8)
+			{
+				stored = std::span<const uint8_t>(compressed.data(), size);
+				entry.Flags |= ARCHIVE_ENTRY_COMPRESSED;
+			}
+		}
+
+		PadTo(out, position, ArchiveAlignment);
+		entry.Offset = position;
+		entry.StoredSize = stored.size();
+		out.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+		position += stored.size();
+		entries.push_back(entry);
+	}
+
+	if (names.size() > std::numeric_limits<uint32_t>::max())
+	{
+		std::cerr << "[ENGINE][ASSETS]: Too many paths for archive " << archivePath << std::endl;
+		return false;
+	}
+
+	PadTo(out, position, alignof(ArchiveEntry));
+	header.TocOffset = position;
+	out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(ArchiveEntry)));
+	position += entries.size() * sizeof(ArchiveEntry);
+	header.NamesOffset = position;
+	header.NamesSize = names.size();
+	out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.close();
+	if (!out)
+	{
+		std::cerr << "[ENGINE][ASSETS]: Could not write archive " << archivePath << std::endl;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,141 @@
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <Assets/AssetFileSystem.h>
+#include <Assets/AssetId.h>
+#include <Core/Compression.h>
+
+AssetFile::AssetFile(AssetFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+AssetFile& AssetFile::operator=(AssetFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		// Moving the vector and the mapping keeps their storage where it is, so Data stays valid.
+		Data = std::exchange(other.Data, nullptr);
+		Size = std::exchange(other.Size, 0);
+		Opened = std::exchange(other.Opened, false);
+		Mapped = std::move(other.Mapped);
+		Decompressed = std::move(other.Decompressed);
+		Archive = std::move(other.Archive);
+		Entry = std::exchange(other.Entry, nullptr);
+	}
+	return *this;
+}
+
+void AssetFile::Prefetch(size_t offset, size_t size) const
+{
+	if (Mapped.IsOpen())
+		Mapped.Prefetch(offset, size);
+	else if (Archive && Decompressed.empty())
+		Archive->Prefetch(*Entry, offset, size);
+}
+
+bool AssetFileSystem::Mount(const std::string& archivePath)
+{
+	auto archive = std::make_shared<AssetArchive>();
+	if (!archive->Open(archivePath))
+		return false;
+
+	std::unique_lock<std::shared_mutex> lock(Mutex);
+	Archives.insert(Archives.begin(), std::move(archive));
+	return true;
+}
+
+void AssetFileSystem::UnmountAll()
+{
+	// Files already opened from them keep their archive alive.
+	std::unique_lock<std::shared_mutex> lock(Mutex);
+	Archives.clear();
+}
+
+size_t AssetFileSystem::GetMountCount() const
+{
+	std::shared_lock<std::shared_mutex> lock(Mutex);
+	return Archives.size();
+}
+
+const ArchiveEntry* AssetFileSystem::FindPacked(std::string_view path, std::shared_ptr<const AssetArchive>& archive) const
+{
+	std::shared_lock<std::shared_mutex> lock(Mutex);
+	if (Archives.empty())
+		return nullptr;
+
+	const std::string normalized = NormalizeAssetPath(path);
+	const uint64_t hash = AssetId::HashPath(normalized);
+	for (const std::shared_ptr<const AssetArchive>& mounted : Archives)
+	{
+		if (const ArchiveEntry* entry = mounted->Find(normalized, hash))
+		{
+			archive = mounted;
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+AssetFile AssetFileSystem::Open(std::string_view path) const
+{
+	std::shared_ptr<const AssetArchive> archive;
+	const ArchiveEntry* entry = FindPacked(path, archive);
+	if (!entry)
+		return OpenLoose(std::string(path));
+
+	AssetFile file;
+	const std::span<const uint8_t> stored = archive->GetStored(*entry);
+	if (entry->Flags & ARCHIVE_ENTRY_COMPRESSED)
+	{
+		file.Decompressed.resize(entry->Size);
+		if (!SCDecompress(stored, file.Decompressed))
+		{
+			std::cerr << "[ENGINE][ASSETS]: Corrupt entry " << archive->GetName(*entry) << " in archive " << archive->GetPath() << std::endl;
+			return AssetFile();
+		}
+		file.Data = file.Decompressed.data();
+	}
+	else
+	{
+		file.Data = stored.data();
+	}
+	file.Size = entry->Size;
+	file.Opened = true;
+	file.Archive = std::move(archive);
+	file.Entry = entry;
+	return file;
+}
+
+bool AssetFileSystem::Exists(std::string_view path) const
+{
+	std::shared_ptr<const AssetArchive> archive;
+	if (FindPacked(path, archive))
+		return true;
+	return ExistsLoose(std::string(path));
+}
+
+bool AssetFileSystem::ExistsLoose(const std::string& path)
+{
+	std::error_code error;
+	return std::filesystem::is_regular_file(path, error);
+}
+
+AssetFile AssetFileSystem::OpenLoose(const std::string& path)
+{
+	AssetFile file;
+	if (file.Mapped.Open(path))
+	{
+		file.Data = file.Mapped.GetData();
+		file.Size = file.Mapped.GetSize();
+		file.Opened = true;
+	}
+	else
+	{
+		// Empty files can't be mapped but are still files.
+		std::error_code error;
+		file.Opened = std::filesystem::is_regular_file(path, error) && std::filesystem::file_size(path, error) == 0 && !error;
+	}
+	return file;
+}
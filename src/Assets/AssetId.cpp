@@ -0,0 +1,80 @@
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <Assets/AssetId.h>
+#include <Core/IdMap.h>
+
+struct AssetPathTable
+{
+	std::mutex Mutex; // Intern's slow path
+	std::deque<std::string> Paths; // stable addresses; entries are never removed
+	SCConcurrentIdMap<const std::string*> Ids;
+};
+
+static AssetPathTable& PathTable()
+{
+	static AssetPathTable table;
+	return table;
+}
+
+// FNV-1a over the bytes, then a 64-bit finalizer so the low bits the maps index by are well mixed.
+uint64_t AssetId::HashPath(std::string_view path, uint64_t seed)
+{
+	uint64_t hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+	for (char c : path)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 0x100000001b3ull;
+	}
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return hash != 0 ? hash : 1;
+}
+
+// Follows the same seed sequence Intern used, which only goes past seed 0 after a collision.
+AssetId AssetId::Find(std::string_view path)
+{
+	const AssetPathTable& table = PathTable();
+	for (uint64_t seed = 0;; seed++)
+	{
+		const uint64_t value = HashPath(path, seed);
+		const std::string* interned = table.Ids.Find(value);
+		if (!interned)
+			return AssetId();
+		if (*interned == path)
+			return AssetId(value);
+	}
+}
+
+AssetId AssetId::Intern(std::string_view path)
+{
+	if (AssetId id = Find(path); id.IsValid())
+		return id;
+
+	AssetPathTable& table = PathTable();
+	std::lock_guard<std::mutex> lock(table.Mutex);
+	for (uint64_t seed = 0;; seed++)
+	{
+		const uint64_t value = HashPath(path, seed);
+		const std::string* interned = table.Ids.Find(value);
+		if (!interned)
+		{
+			table.Paths.emplace_back(path);
+			table.Ids.Assign(value, &table.Paths.back());
+			return AssetId(value);
+		}
+		if (*interned == path)
+			return AssetId(value); // interned by another thread since Find
+		std::cerr << "[ENGINE][ASSETS]: Asset id collision between \"" << *interned << "\" and \"" << path << "\", rehashing" << std::endl;
+	}
+}
+
+const std::string& AssetId::Path() const
+{
+	static const std::string empty;
+	const std::string* interned = PathTable().Ids.Find(Value);
+	return interned ? *interned : empty;
+}
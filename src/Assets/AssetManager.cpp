@@ -1,37 +1,795 @@
+#include <algorithm>
+#include <filesystem>
 #include <Assets/AssetManager.h>
 #include <Core/Application.h>
 #include <Events/Events.h>
 #include <Events/EventArgs.h>
 
-std::shared_ptr<Asset> AssetManager::LoadAsset(const AssetType& type, std::string path)
+static std::shared_ptr<Asset> CreateAsset(AssetType type, SCDerivedDataCache& cache, const AssetFileSystem& fileSystem)
 {
-	if (this->IsAssetLoaded(path))
-	{
-		SC_ErrorEvent("Attempted to load already-loaded asset.");
-		return nullptr;
-	}
-
-	std::shared_ptr<Asset> asset = nullptr;
+	std::shared_ptr<Asset> asset;
 	switch (type)
 	{
 		case AssetType::DX11_SHADER:
 			asset = std::make_shared<ShaderAsset>();
-			AssetDict.emplace(path, asset);
-			asset->Load(path);
 			break;
-		default:
-			SC_ErrorEvent("Could not load asset.");
+		case AssetType::MODEL:
+			asset = std::make_shared<ModelAsset>();
 			break;
+		case AssetType::MATERIAL:
+			asset = std::make_shared<MaterialAsset>();
+			break;
+		default:
+			return nullptr;
+	}
+	asset->Cache = &cache;
+	asset->FileSystem = &fileSystem;
+	return asset;
+}
+
+AssetManager::AssetManager(unsigned int loaderThreads, std::string cacheDirectory) : DerivedData(std::move(cacheDirectory))
+{
+	if (loaderThreads == 0)
+		loaderThreads = std::max(1u, std::thread::hardware_concurrency() / 2);
+	for (unsigned int i = 0; i < loaderThreads; i++)
+		Loaders.emplace_back(&AssetManager::LoaderLoop, this);
+}
+
+AssetManager::~AssetManager()
+{
+	{
+		std::lock_guard<std::mutex> lock(QueueMutex);
+		Stopping = true;
+	}
+	QueueCondition.notify_all();
+	for (std::thread& loader : Loaders)
+		loader.join();
+
+	// Anything not uploaded yet resolves to nullptr rather than leaving a broken promise.
+	for (std::unique_ptr<PendingLoad>& load : Queue)
+		load->Promise.set_value(nullptr);
+	for (std::unique_ptr<PendingLoad>& load : Uploads)
+		load->Promise.set_value(nullptr);
+}
+
+std::shared_ptr<Asset> AssetManager::LoadAsset(const AssetType& type, const std::string& path)
+{
+	const AssetId id = AssetId::Intern(path);
+	if (this->IsAssetLoaded(id))
+	{
+		SC_ErrorEvent("Attempted to load already-loaded asset.");
+		return nullptr;
+	}
+
+	std::shared_ptr<Asset> asset = CreateAsset(type, DerivedData, FileSystem);
+	if (!asset)
+	{
+		SC_ErrorEvent("Could not load asset.");
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		if (Loading.Find(id.Value))
+		{
+			SC_ErrorEvent("Attempted to load an asset that is already loading asynchronously.");
+			return nullptr;
+		}
+	}
+
+	SyncLoads.push_back(id);
+	std::vector<AssetId> uses;
+	std::vector<std::shared_ptr<Asset>> dependencies;
+	const bool loaded = asset->Read(path) && LoadDependencies(*asset, path, uses, dependencies) && asset->Link(dependencies) && asset->Upload();
+	SyncLoads.pop_back();
+	if (!loaded)
+	{
+		SC_ErrorEvent("Could not load asset.");
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	return Register(id, type, std::move(asset), std::move(uses));
+}
+
+// LoadAsset's dependencies, loaded depth first on the frame thread.
+bool AssetManager::LoadDependencies(Asset& asset, const std::string& path, std::vector<AssetId>& ids, std::vector<std::shared_ptr<Asset>>& dependencies)
+{
+	for (const AssetDependency& dependency : asset.GetAssetDependencies())
+	{
+		const AssetId id = AssetId::Intern(dependency.Path);
+		if (std::find(SyncLoads.begin(), SyncLoads.end(), id) != SyncLoads.end())
+		{
+			std::cerr << "[ENGINE][ASSETS]: " << path << " depends on " << dependency.Path << ", which depends on it." << std::endl;
+			return false;
+		}
+		std::shared_ptr<Asset> loaded = GetAsset(id);
+		if (!loaded)
+			loaded = LoadAsset(dependency.Type, dependency.Path);
+		if (!loaded)
+		{
+			std::cerr << "[ENGINE][ASSETS]: Could not load " << path << ": its dependency " << dependency.Path << " failed to load." << std::endl;
+			return false;
+		}
+		ids.push_back(id);
+		dependencies.push_back(std::move(loaded));
+	}
+	return true;
+}
+
+AssetFuture AssetManager::LoadAssetAsync(const AssetType& type, const std::string& path)
+{
+	return QueueLoad(type, path, false);
+}
+
+// Urgent loads go to the front of the queue, for dependencies something is already waiting on.
+AssetFuture AssetManager::QueueLoad(AssetType type, const std::string& path, bool urgent)
+{
+	const AssetId id = AssetId::Intern(path);
+	auto ready = [](std::shared_ptr<Asset> asset)
+		{
+			std::promise<std::shared_ptr<Asset>> promise;
+			promise.set_value(std::move(asset));
+			return promise.get_future().share();
+		};
+	if (Entry* entry = Registry.Find(id.Value))
+		if (std::shared_ptr<Asset> asset = Acquire(*entry))
+			return ready(std::move(asset));
+
+	std::unique_ptr<PendingLoad> load;
+	AssetFuture future;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		if (const AssetFuture* loading = Loading.Find(id.Value))
+			return *loading;
+		// Resolved between the lock-free check and taking the lock.
+		if (const Entry* entry = Registry.Find(id.Value); entry && entry->Resident.load(std::memory_order_relaxed))
+			return ready(entry->Loaded);
+
+		load = std::make_unique<PendingLoad>();
+		load->Id = id;
+		load->Type = type;
+		load->Path = path;
+		future = load->Promise.get_future().share();
+		Loading.Emplace(id.Value, future);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(QueueMutex);
+		if (urgent)
+			Queue.push_front(std::move(load));
+		else
+			Queue.push_back(std::move(load));
+	}
+	QueueCondition.notify_one();
+	return future;
+}
+
+void AssetManager::LoaderLoop()
+{
+	while (true)
+	{
+		std::unique_ptr<PendingLoad> load;
+		{
+			std::unique_lock<std::mutex> lock(QueueMutex);
+			QueueCondition.wait(lock, [this] { return Stopping || !Queue.empty(); });
+			if (Stopping)
+				return;
+			load = std::move(Queue.front());
+			Queue.pop_front();
+		}
+
+		load->Loaded = CreateAsset(load->Type, DerivedData, FileSystem);
+		load->ReadOk = load->Loaded && load->Loaded->Read(load->Path) && RequestDependencies(*load);
+
+		std::lock_guard<std::mutex> lock(Mutex);
+		Uploads.push_back(std::move(load));
+	}
+}
+
+// Loader thread. Starts loading what the asset just read says it depends on. The loads only ever
+// wait for each other in Update, never on a loader thread, so a cycle would just never finish;
+// it is refused here instead.
+bool AssetManager::RequestDependencies(PendingLoad& load)
+{
+	const std::vector<AssetDependency> dependencies = load.Loaded->GetAssetDependencies();
+	if (dependencies.empty())
+		return true;
+
+	for (const AssetDependency& dependency : dependencies)
+		load.DependencyIds.push_back(AssetId::Intern(dependency.Path));
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		for (AssetId id : load.DependencyIds)
+		{
+			if (WaitsOn(id, load.Id))
+			{
+				std::cerr << "[ENGINE][ASSETS]: " << load.Path << " depends on " << id.Path() << ", which depends on it." << std::endl;
+				return false;
+			}
+		}
+		*Waiting.Emplace(load.Id.Value).first = load.DependencyIds;
+	}
+
+	for (size_t i = 0; i < dependencies.size(); i++)
+		load.Dependencies.push_back(QueueLoad(dependencies[i].Type, dependencies[i].Path, true));
+	return true;
+}
+
+// Called with Mutex held. True if from is to, or from's load waits on to's, directly or not.
+bool AssetManager::WaitsOn(AssetId from, AssetId to) const
+{
+	std::vector<AssetId> stack{ from };
+	std::vector<AssetId> seen;
+	while (!stack.empty())
+	{
+		const AssetId id = stack.back();
+		stack.pop_back();
+		if (id == to)
+			return true;
+		if (std::find(seen.begin(), seen.end(), id) != seen.end())
+			continue;
+		seen.push_back(id);
+		if (const std::vector<AssetId>* waits = Waiting.Find(id.Value))
+			stack.insert(stack.end(), waits->begin(), waits->end());
 	}
+	return false;
+}
 
+bool AssetManager::DependenciesReady(const PendingLoad& load)
+{
+	for (const AssetFuture& dependency : load.Dependencies)
+		if (dependency.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return false;
+	return true;
+}
+
+// Frame thread, with the dependencies resolved.
+void AssetManager::FinishLoad(PendingLoad& load)
+{
+	bool ok = load.ReadOk;
+	std::vector<std::shared_ptr<Asset>> dependencies;
+	for (size_t i = 0; ok && i < load.Dependencies.size(); i++)
+	{
+		std::shared_ptr<Asset> dependency = load.Dependencies[i].get();
+		// A failed hot reload resolves to nullptr but keeps the old version loaded.
+		if (!dependency)
+			dependency = GetAsset(load.DependencyIds[i]);
+		if (!dependency)
+		{
+			std::cerr << "[ENGINE][ASSETS]: Could not load " << load.Path << ": its dependency " << load.DependencyIds[i].Path() << " failed to load." << std::endl;
+			ok = false;
+		}
+		dependencies.push_back(std::move(dependency));
+	}
+	ok = ok && load.Loaded->Link(dependencies) && load.Loaded->Upload();
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	Waiting.Erase(load.Id.Value);
+	if (load.HotReload)
+	{
+		FinishHotReload(load, ok);
+		return;
+	}
+	if (!ok)
+		SC_ErrorEvent("Could not load asset.");
+	Resolve(load, ok ? load.Loaded : nullptr);
+}
+
+// Readers announce themselves before looking at Resident, and Evict looks at Readers after
+// clearing it (both seq_cst), so either the reader sees Resident false and leaves Loaded alone or
+// Evict sees the reader and backs off. A reader that already left holds a copy, which Evict sees
+// in use_count.
+std::shared_ptr<Asset> AssetManager::Acquire(Entry& entry)
+{
+	entry.Readers.fetch_add(1, std::memory_order_seq_cst);
+	std::shared_ptr<Asset> asset;
+	if (entry.Resident.load(std::memory_order_seq_cst))
+	{
+		asset = entry.Loaded;
+		// Only write the bit when it changes, so hot assets don't bounce their cache line.
+		if (!entry.Referenced.load(std::memory_order_relaxed))
+			entry.Referenced.store(true, std::memory_order_relaxed);
+	}
+	entry.Readers.fetch_sub(1, std::memory_order_seq_cst);
 	return asset;
 }
 
-bool AssetManager::IsAssetLoaded(std::string path)
+// Called with Mutex held. If the id is already resident the existing asset wins.
+std::shared_ptr<Asset> AssetManager::Register(AssetId id, AssetType type, std::shared_ptr<Asset> asset, std::vector<AssetId> uses)
 {
-	// Debugging output
-	std::cout << "Checking if asset is loaded: " << path << std::endl;
-	std::cout << "Size of AssetDict: " << AssetDict.size() << std::endl;
+	const size_t index = static_cast<size_t>(type);
+	if (index >= AssetTypeCount)
+		return nullptr;
 
-	return AssetDict.find(path) != AssetDict.end();
-}
\ No newline at end of file
+	Entry* entry = Registry.Find(id.Value);
+	if (!entry)
+	{
+		Entries.push_back(std::make_unique<Entry>());
+		entry = Entries.back().get();
+		entry->Id = id;
+		entry->Type = type;
+		Clock[index].push_back(entry);
+		Registry.Assign(id.Value, entry);
+	}
+	else if (entry->Resident.load(std::memory_order_relaxed))
+	{
+		return entry->Loaded;
+	}
+	else if (entry->Type != type)
+	{
+		std::cerr << "[ENGINE][ASSETS]: " << id.Path() << " was evicted as one asset type and reloaded as another." << std::endl;
+		return nullptr;
+	}
+
+	AssetTypeResidency& stats = Residency.Types[index];
+	entry->Loaded = std::move(asset);
+	entry->Bytes = entry->Loaded->GetMemorySize();
+	entry->Referenced.store(true, std::memory_order_relaxed);
+	stats.Loads++;
+	if (entry->Evicted)
+		stats.Reloads++;
+	stats.Resident++;
+	stats.Bytes += entry->Bytes;
+	stats.PeakBytes = std::max(stats.PeakBytes, stats.Bytes);
+	entry->Resident.store(true, std::memory_order_seq_cst); // publishes Loaded
+	SetUses(*entry, std::move(uses));
+	if (TrackFiles)
+		IndexFiles(*entry);
+	return entry->Loaded;
+}
+
+// Called with Mutex held. Replaces the entry's edges in the dependency graph. Its dependencies
+// were registered before it, so their entries exist.
+void AssetManager::SetUses(Entry& entry, std::vector<AssetId> uses)
+{
+	for (AssetId id : entry.Uses)
+		if (Entry* used = Registry.Find(id.Value))
+			used->UsedBy.erase(std::remove(used->UsedBy.begin(), used->UsedBy.end(), entry.Id), used->UsedBy.end());
+
+	entry.Uses = std::move(uses);
+	for (AssetId id : entry.Uses)
+		if (Entry* used = Registry.Find(id.Value); used && std::find(used->UsedBy.begin(), used->UsedBy.end(), entry.Id) == used->UsedBy.end())
+			used->UsedBy.push_back(entry.Id);
+}
+
+// Called with Mutex held.
+void AssetManager::Resolve(PendingLoad& load, std::shared_ptr<Asset> result)
+{
+	Loading.Erase(load.Id.Value);
+	if (result)
+		result = Register(load.Id, load.Type, std::move(result), std::move(load.DependencyIds));
+	load.Promise.set_value(std::move(result));
+}
+
+void AssetManager::Update()
+{
+	if (Watcher)
+	{
+		const std::vector<std::string> changed = Watcher->TakeChanges();
+		if (!changed.empty())
+			QueueHotReloads(changed);
+	}
+
+	std::vector<std::unique_ptr<PendingLoad>> uploads;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		uploads.swap(Uploads);
+	}
+
+	// Finishing a load can make others ready, so pass over them until nothing changes: a chain
+	// whose reads are done uploads in one Update, dependencies first. Loads still waiting on reads
+	// go back for the next one.
+	for (bool progress = true; progress;)
+	{
+		progress = false;
+		for (std::unique_ptr<PendingLoad>& load : uploads)
+		{
+			if (!load || !DependenciesReady(*load))
+				continue;
+			FinishLoad(*load);
+			load.reset(); // drop the load's references before sweeping
+			progress = true;
+		}
+	}
+	uploads.erase(std::remove(uploads.begin(), uploads.end(), nullptr), uploads.end());
+	if (!uploads.empty())
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		Uploads.insert(Uploads.end(), std::make_move_iterator(uploads.begin()), std::make_move_iterator(uploads.end()));
+	}
+
+	Trim();
+}
+
+std::shared_ptr<Asset> AssetManager::GetAsset(AssetId id) const
+{
+	Entry* entry = Registry.Find(id.Value);
+	return entry ? Acquire(*entry) : nullptr;
+}
+
+std::shared_ptr<Asset> AssetManager::GetAsset(std::string_view path) const
+{
+	return GetAsset(AssetId::Find(path));
+}
+
+bool AssetManager::IsAssetLoaded(AssetId id) const
+{
+	const Entry* entry = Registry.Find(id.Value);
+	return entry && entry->Resident.load(std::memory_order_acquire);
+}
+
+bool AssetManager::IsAssetLoaded(std::string_view path) const
+{
+	return IsAssetLoaded(AssetId::Find(path));
+}
+
+AssetType AssetManager::GetAssetType(AssetId id) const
+{
+	const Entry* entry = Registry.Find(id.Value);
+	return entry && entry->Resident.load(std::memory_order_acquire) ? entry->Type : AssetType::UNKNOWN;
+}
+
+AssetType AssetManager::GetAssetType(std::string_view path) const
+{
+	return GetAssetType(AssetId::Find(path));
+}
+
+std::vector<std::shared_ptr<Asset>> AssetManager::GetAllAssets() const
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	std::vector<std::shared_ptr<Asset>> assets;
+	assets.reserve(Entries.size());
+	for (const std::unique_ptr<Entry>& entry : Entries)
+		if (entry->Resident.load(std::memory_order_relaxed))
+			assets.push_back(entry->Loaded);
+	return assets;
+}
+
+std::vector<std::shared_ptr<Asset>> AssetManager::GetAssetsOfType(const AssetType& type) const
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	std::vector<std::shared_ptr<Asset>> assets;
+	for (const std::unique_ptr<Entry>& entry : Entries)
+		if (entry->Type == type && entry->Resident.load(std::memory_order_relaxed))
+			assets.push_back(entry->Loaded);
+	return assets;
+}
+
+// Residency
+
+void AssetManager::SetBudget(AssetType type, size_t bytes)
+{
+	const size_t index = static_cast<size_t>(type);
+	if (index >= AssetTypeCount)
+		return;
+	std::lock_guard<std::mutex> lock(Mutex);
+	Residency.Types[index].Budget = bytes;
+}
+
+size_t AssetManager::GetBudget(AssetType type) const
+{
+	const size_t index = static_cast<size_t>(type);
+	if (index >= AssetTypeCount)
+		return 0;
+	std::lock_guard<std::mutex> lock(Mutex);
+	return Residency.Types[index].Budget;
+}
+
+bool AssetManager::Pin(AssetId id)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	Entry* entry = Registry.Find(id.Value);
+	if (!entry || !entry->Resident.load(std::memory_order_relaxed))
+		return false;
+	entry->Pins++;
+	return true;
+}
+
+void AssetManager::Unpin(AssetId id)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	Entry* entry = Registry.Find(id.Value);
+	if (entry && entry->Pins > 0)
+		entry->Pins--;
+}
+
+void AssetManager::SetEvictionCallback(AssetEvictionCallback callback)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	OnEvict = std::move(callback);
+}
+
+AssetResidencyStats AssetManager::GetResidencyStats() const
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	return Residency;
+}
+
+// Called with Mutex held. Only the frame thread evicts, since dropping the last reference
+// destroys the asset's renderer objects.
+bool AssetManager::Evict(Entry& entry, std::vector<Eviction>& evicted)
+{
+	if (!entry.Resident.load(std::memory_order_relaxed) || entry.Pins != 0 || entry.Loaded.use_count() != 1)
+		return false;
+
+	entry.Resident.store(false, std::memory_order_seq_cst);
+	if (entry.Readers.load(std::memory_order_seq_cst) != 0 || entry.Loaded.use_count() != 1)
+	{
+		// Lost a race with Acquire. Readers that looked in the meantime got nullptr.
+		entry.Resident.store(true, std::memory_order_seq_cst);
+		return false;
+	}
+
+	AssetTypeResidency& stats = Residency.Types[static_cast<size_t>(entry.Type)];
+	stats.Resident--;
+	stats.Bytes -= entry.Bytes;
+	stats.Evictions++;
+	stats.EvictedBytes += entry.Bytes;
+	evicted.push_back({ entry.Id, entry.Type, entry.Bytes, std::move(entry.Loaded) });
+	entry.Loaded.reset();
+	entry.Bytes = 0;
+	entry.Evicted = true;
+	return true;
+}
+
+// Called with Mutex held. Second-chance clock: the hand clears the reference bit of assets read
+// since it last passed and takes the first one it finds clear, so two turns are enough to find
+// every candidate.
+void AssetManager::Sweep(size_t type, size_t target, std::vector<Eviction>& evicted)
+{
+	std::vector<Entry*>& ring = Clock[type];
+	size_t& hand = ClockHand[type];
+	for (size_t step = 0; step < ring.size() * 2 && Residency.Types[type].Bytes > target; step++)
+	{
+		Entry& entry = *ring[hand];
+		hand = hand + 1 < ring.size() ? hand + 1 : 0;
+		if (!entry.Resident.load(std::memory_order_relaxed) || entry.Pins != 0 || entry.Loaded.use_count() != 1)
+			continue;
+		if (entry.Referenced.exchange(false, std::memory_order_relaxed))
+			continue;
+		Evict(entry, evicted);
+	}
+}
+
+// Destroys the evicted assets and runs the callback outside the lock, so either may load assets.
+void AssetManager::FinishEvictions(std::vector<Eviction>& evicted)
+{
+	if (evicted.empty())
+		return;
+	AssetEvictionCallback callback;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		callback = OnEvict;
+	}
+	for (Eviction& eviction : evicted)
+	{
+		eviction.Loaded.reset();
+		if (callback)
+			callback(eviction.Id, eviction.Type, eviction.Bytes);
+	}
+}
+
+void AssetManager::Trim()
+{
+	std::vector<Eviction> evicted;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		for (size_t type = 0; type < AssetTypeCount; type++)
+		{
+			const AssetTypeResidency& stats = Residency.Types[type];
+			if (stats.Budget != 0 && stats.Bytes > stats.Budget)
+				Sweep(type, stats.Budget, evicted);
+		}
+	}
+	FinishEvictions(evicted);
+}
+
+void AssetManager::EvictUnused()
+{
+	std::vector<Eviction> evicted;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		for (const std::unique_ptr<Entry>& entry : Entries)
+			Evict(*entry, evicted);
+	}
+	FinishEvictions(evicted);
+}
+
+std::ostream& operator<<(std::ostream& stream, const AssetResidencyStats& stats)
+{
+	static const char* const names[] = { "DX11_SHADER", "MODEL", "TEXTURE", "SCRIPT", "MATERIAL" };
+	static_assert(std::size(names) == AssetTypeCount);
+	for (size_t type = 0; type < AssetTypeCount; type++)
+	{
+		const AssetTypeResidency& residency = stats.Types[type];
+		if (residency.Loads == 0 && residency.Budget == 0)
+			continue;
+		stream << names[type] << ": " << residency.Resident << " resident, " << residency.Bytes << " bytes";
+		if (residency.Budget != 0)
+			stream << " of " << residency.Budget;
+		stream << " (peak " << residency.PeakBytes << "), " << residency.Loads << " loads, " << residency.Reloads
+			<< " reloads, " << residency.Evictions << " evictions (" << residency.EvictedBytes << " bytes), "
+			<< residency.HotReloads << " hot reloads, " << residency.Relinks << " relinks\n";
+	}
+	return stream;
+}
+
+// Hot reload
+
+// Paths from the watcher, the assets and the preprocessor are spelled differently (relative,
+// absolute, backslashes), so files are keyed by their canonical form.
+static uint64_t FileKey(const std::string& path)
+{
+	std::error_code error;
+	const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+	return AssetId::HashPath(error ? std::filesystem::path(path).generic_string() : canonical.generic_string());
+}
+
+bool AssetManager::EnableHotReload(const std::string& directory, std::chrono::milliseconds debounce)
+{
+	if (!Watcher)
+		Watcher = std::make_unique<SCFileWatcher>(debounce);
+	if (!Watcher->Watch(directory))
+		return false;
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	if (!TrackFiles)
+	{
+		TrackFiles = true;
+		for (const std::unique_ptr<Entry>& entry : Entries)
+			if (entry->Resident.load(std::memory_order_relaxed))
+				IndexFiles(*entry);
+	}
+	return true;
+}
+
+// Called with Mutex held. Replaces the entry's files in Dependents with its current ones.
+void AssetManager::IndexFiles(Entry& entry)
+{
+	for (uint64_t key : entry.Files)
+	{
+		std::vector<AssetId>* ids = Dependents.Find(key);
+		if (!ids)
+			continue;
+		ids->erase(std::remove(ids->begin(), ids->end(), entry.Id), ids->end());
+		if (ids->empty())
+			Dependents.Erase(key);
+	}
+
+	entry.Files.clear();
+	entry.Files.push_back(FileKey(entry.Id.Path()));
+	for (const std::string& file : entry.Loaded->GetDependencies())
+		entry.Files.push_back(FileKey(file));
+	std::sort(entry.Files.begin(), entry.Files.end());
+	entry.Files.erase(std::unique(entry.Files.begin(), entry.Files.end()), entry.Files.end());
+
+	for (uint64_t key : entry.Files)
+		Dependents.Emplace(key).first->push_back(entry.Id);
+}
+
+void AssetManager::QueueHotReloads(const std::vector<std::string>& changed)
+{
+	std::vector<std::unique_ptr<PendingLoad>> loads;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		std::vector<AssetId> ids;
+		for (const std::string& path : changed)
+			if (const std::vector<AssetId>* dependents = Dependents.Find(FileKey(path)))
+				ids.insert(ids.end(), dependents->begin(), dependents->end());
+		std::sort(ids.begin(), ids.end(), [](AssetId a, AssetId b) { return a.Value < b.Value; });
+		ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+		for (AssetId id : ids)
+		{
+			const Entry* entry = Registry.Find(id.Value);
+			// Evicted assets load the new version next time anyway.
+			if (!entry || !entry->Resident.load(std::memory_order_relaxed) || Loading.Find(id.Value))
+				continue;
+
+			auto load = std::make_unique<PendingLoad>();
+			load->Id = id;
+			load->Type = entry->Type;
+			load->Path = id.Path();
+			load->HotReload = true;
+			Loading.Emplace(id.Value, load->Promise.get_future().share());
+			loads.push_back(std::move(load));
+		}
+	}
+	if (loads.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(QueueMutex);
+		for (std::unique_ptr<PendingLoad>& load : loads)
+			Queue.push_back(std::move(load));
+	}
+	QueueCondition.notify_all();
+}
+
+// Called with Mutex held, on the frame thread.
+void AssetManager::FinishHotReload(PendingLoad& load, bool ok)
+{
+	Loading.Erase(load.Id.Value);
+	Entry* entry = Registry.Find(load.Id.Value);
+	if (!ok || !entry || !entry->Resident.load(std::memory_order_relaxed) || !entry->Loaded->Replace(*load.Loaded))
+	{
+		if (!ok)
+			std::cerr << "[ENGINE][ASSETS]: Could not reload " << load.Path << "; keeping the loaded version." << std::endl;
+		else if (entry && entry->Resident.load(std::memory_order_relaxed))
+			std::cerr << "[ENGINE][ASSETS]: " << load.Path << " doesn't support hot reload." << std::endl;
+		load.Promise.set_value(nullptr);
+		return;
+	}
+
+	AssetTypeResidency& stats = Residency.Types[static_cast<size_t>(entry->Type)];
+	stats.Bytes -= entry->Bytes;
+	entry->Bytes = entry->Loaded->GetMemorySize();
+	stats.Bytes += entry->Bytes;
+	stats.PeakBytes = std::max(stats.PeakBytes, stats.Bytes);
+	stats.HotReloads++;
+	SetUses(*entry, std::move(load.DependencyIds));
+	IndexFiles(*entry);
+	RelinkUsers(*entry);
+	load.Promise.set_value(entry->Loaded);
+}
+
+// Called with Mutex held, on the frame thread. Links the resident assets built on changed,
+// directly or not, again, each after the ones it uses within that subgraph (Kahn's algorithm).
+void AssetManager::RelinkUsers(Entry& changed)
+{
+	SCIdMap<size_t> waits; // affected asset -> its affected dependencies not relinked yet
+	std::vector<Entry*> affected;
+	std::vector<Entry*> stack{ &changed };
+	while (!stack.empty())
+	{
+		Entry* entry = stack.back();
+		stack.pop_back();
+		for (AssetId id : entry->UsedBy)
+		{
+			Entry* user = Registry.Find(id.Value);
+			if (user && user != &changed && user->Resident.load(std::memory_order_relaxed) && waits.Emplace(id.Value, 0).second)
+			{
+				affected.push_back(user);
+				stack.push_back(user);
+			}
+		}
+	}
+	if (affected.empty())
+		return;
+
+	std::vector<Entry*> ready;
+	for (Entry* user : affected)
+	{
+		// Count each dependency once, the way UsedBy lists each user once.
+		size_t& count = *waits.Find(user->Id.Value);
+		for (auto id = user->Uses.begin(); id != user->Uses.end(); ++id)
+			if (waits.Find(id->Value) && std::find(user->Uses.begin(), id, *id) == id)
+				count++;
+		if (count == 0)
+			ready.push_back(user);
+	}
+
+	size_t relinked = 0;
+	while (!ready.empty())
+	{
+		Entry* user = ready.back();
+		ready.pop_back();
+		relinked++;
+
+		std::vector<std::shared_ptr<Asset>> dependencies;
+		for (AssetId id : user->Uses)
+			if (Entry* used = Registry.Find(id.Value))
+				if (std::shared_ptr<Asset> asset = Acquire(*used))
+					dependencies.push_back(std::move(asset));
+		if (dependencies.size() != user->Uses.size() || !user->Loaded->Link(dependencies))
+			std::cerr << "[ENGINE][ASSETS]: Could not relink " << user->Id.Path() << " after " << changed.Id.Path() << " reloaded." << std::endl;
+		Residency.Types[static_cast<size_t>(user->Type)].Relinks++;
+
+		for (AssetId id : user->UsedBy)
+			if (size_t* count = waits.Find(id.Value); count && --*count == 0)
+				ready.push_back(Registry.Find(id.Value));
+	}
+	if (relinked != affected.size())
+		std::cerr << "[ENGINE][ASSETS]: Dependency cycle through " << changed.Id.Path() << "; some assets weren't relinked." << std::endl;
+}
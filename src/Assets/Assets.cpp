@@ -1,20 +1,279 @@
 #include <Assets/Assets.h>
 #include <Core/Application.h>
 #include <Graphics/DX11/DX11Renderer.h>
+#include <Events/EventArgs.h>
+#include <algorithm>
+#include <deque>
+#include <filesystem>
 #include <iostream>
+#include <sstream>
+#include <unordered_map>
 
-void ShaderAsset::Load(const std::string& path)
+// Opens #includes through the asset's filesystem, so shaders in an archive include from it too,
+// relative to the including file. Records every file it opened.
+class AssetIncludeHandler : public ID3DInclude
 {
-	auto rend = Application::Get().GetDX11Renderer();
-	auto p = (wchar_t*)path.c_str();
-	std::cout << (char*)p << std::endl;
-	this->ShaderObj = rend.CreateShader(p);
+public:
+	AssetIncludeHandler(const Asset& asset, const std::string& rootPath, std::vector<std::string>& opened)
+		: Owner(asset), RootPath(rootPath), Opened(opened) {}
+
+	HRESULT __stdcall Open(D3D_INCLUDE_TYPE /*type*/, LPCSTR fileName, LPCVOID parentData, LPCVOID* data, UINT* bytes) override
+	{
+		// The top-level source isn't one of ours, so anything unknown is included from it.
+		const auto parent = Parents.find(parentData);
+		const std::filesystem::path directory = std::filesystem::path(parent != Parents.end() ? parent->second : RootPath).parent_path();
+		const std::string path = (directory / fileName).lexically_normal().generic_string();
+
+		AssetFile file = Owner.OpenFile(path);
+		if (!file.IsOpen())
+			return E_FAIL;
+		*data = file.GetSize() > 0 ? static_cast<const void*>(file.GetData()) : "";
+		*bytes = static_cast<UINT>(file.GetSize());
+		Parents[*data] = path;
+		if (std::find(Opened.begin(), Opened.end(), path) == Opened.end())
+			Opened.push_back(path);
+		Files.push_back(std::move(file));
+		return S_OK;
+	}
+
+	// Files stay open until the handler goes away; the compiler may reopen them per stage.
+	HRESULT __stdcall Close(LPCVOID /*data*/) override { return S_OK; }
+
+private:
+	const Asset& Owner;
+	const std::string& RootPath;
+	std::vector<std::string>& Opened;
+	std::deque<AssetFile> Files;
+	std::unordered_map<const void*, std::string> Parents;
+};
+
+bool ShaderAsset::Read(const std::string& path)
+{
+	const AssetFile file = OpenFile(path);
+	if (!file.IsOpen())
+	{
+		SC_ErrorEvent("Could not open shader file.");
+		return false;
+	}
+
+	SourceFiles.assign(1, path);
+	AssetIncludeHandler include(*this, path, SourceFiles);
+	return DX11Shader::CompileSource(std::string(file.Text()), path.c_str(), SCVertexFormat::Standard, VertexBlob, PixelBlob, Cache, nullptr, &include);
+}
+
+bool ShaderAsset::Upload()
+{
+	auto& rend = Application::Get().GetDX11Renderer();
+	this->ShaderObj = rend.CreateShader(VertexBlob.Get(), PixelBlob.Get());
+	BytecodeSize = (VertexBlob ? VertexBlob->GetBufferSize() : 0) + (PixelBlob ? PixelBlob->GetBufferSize() : 0);
+	VertexBlob.Reset();
+	PixelBlob.Reset();
+	return ShaderObj && ShaderObj->vertexShader;
+}
+
+bool ModelAsset::Read(const std::string& path)
+{
+	if (!File.Open(OpenFile(path), path))
+	{
+		SC_ErrorEvent("Could not open model file.");
+		return false;
+	}
+	File.Prefetch();
+
+	const std::string material = std::filesystem::path(path).replace_extension(".scmat").generic_string();
+	MaterialPath = HasFile(material) ? material : std::string();
+	return true;
+}
+
+bool ModelAsset::Upload()
+{
+	auto& rend = Application::Get().GetDX11Renderer();
+	this->MeshObj = rend.CreateMesh(File.Vertices(), File.Indices(), File.Lods());
+	if (MeshObj && Material)
+		MeshObj->Material = Material->MaterialObj;
+	if (MeshObj)
+	{
+		const MeshFileHeader& header = File.GetHeader();
+		const SCVector3f min(header.BoundsMin[0], header.BoundsMin[1], header.BoundsMin[2]);
+		const SCVector3f max(header.BoundsMax[0], header.BoundsMax[1], header.BoundsMax[2]);
+		BoundsCenter = (min + max) * 0.5f;
+		BoundsRadius = (max - min).Length() * 0.5f;
+		BufferSize = File.Vertices().size() * MeshObj->VertexStride + MeshObj->IndexCount * SCIndexSize(MeshObj->IndexFormat);
+	}
+	// The GPU has everything now; holding the mapping would keep the file from being replaced
+	// (Windows refuses outright) and leave readers exposed to it being rewritten.
+	File.Close();
+	return MeshObj != nullptr;
+}
+
+std::vector<AssetDependency> ModelAsset::GetAssetDependencies() const
+{
+	if (MaterialPath.empty())
+		return {};
+	return { { AssetType::MATERIAL, MaterialPath } };
+}
+
+bool ModelAsset::Link(std::span<const std::shared_ptr<Asset>> dependencies)
+{
+	if (MaterialPath.empty())
+		return true;
+	Material = dependencies.empty() ? nullptr : std::dynamic_pointer_cast<MaterialAsset>(dependencies[0]);
+	if (!Material)
+		return false;
+	if (MeshObj)
+		MeshObj->Material = Material->MaterialObj;
+	return true;
+}
+
+bool ShaderAsset::Replace(Asset& fresh)
+{
+	ShaderAsset* other = dynamic_cast<ShaderAsset*>(&fresh);
+	if (!other || !other->ShaderObj)
+		return false;
+	if (ShaderObj)
+		*ShaderObj = std::move(*other->ShaderObj);
+	else
+		ShaderObj = other->ShaderObj;
+	BytecodeSize = other->BytecodeSize;
+	SourceFiles = std::move(other->SourceFiles);
+	return true;
+}
+
+bool ModelAsset::Replace(Asset& fresh)
+{
+	ModelAsset* other = dynamic_cast<ModelAsset*>(&fresh);
+	if (!other || !other->MeshObj)
+		return false;
+	BoundsCenter = other->BoundsCenter;
+	BoundsRadius = other->BoundsRadius;
+	BufferSize = other->BufferSize;
+	if (other->Material)
+	{
+		MaterialPath = other->MaterialPath;
+		Material = other->Material;
+	}
+	if (!MeshObj)
+	{
+		MeshObj = other->MeshObj;
+		return true;
+	}
+	if (other->Material)
+		MeshObj->Material = other->MeshObj->Material;
+	MeshObj->VertexBuffer = other->MeshObj->VertexBuffer;
+	MeshObj->IndexBuffer = other->MeshObj->IndexBuffer;
+	MeshObj->VertexFormat = other->MeshObj->VertexFormat;
+	MeshObj->VertexStride = other->MeshObj->VertexStride;
+	MeshObj->QuantizationBuffer = other->MeshObj->QuantizationBuffer;
+	MeshObj->IndexCount = other->MeshObj->IndexCount;
+	MeshObj->IndexFormat = other->MeshObj->IndexFormat;
+	MeshObj->Lods = std::move(other->MeshObj->Lods);
+	return true;
+}
+
+std::span<const SCMeshLod> ModelAsset::GetLods() const
+{
+	if (!MeshObj)
+		return {};
+	return MeshObj->Lods;
+}
+
+void ModelAsset::GetBoundingSphere(SCVector3f& center, float& radius) const
+{
+	center = BoundsCenter;
+	radius = BoundsRadius;
+}
+
+size_t ModelAsset::GetMemorySize() const
+{
+	return File.GetSize() + BufferSize;
 }
 
 std::shared_ptr<SCMaterial> ShaderAsset::PackMat()
 {
-	auto rend = Application::Get().GetDX11Renderer();
+	auto& rend = Application::Get().GetDX11Renderer();
 	auto spec = std::make_shared<DX11MaterialSpec>(ShaderObj, rend.CreateConstantBuffer(nullptr));
 	auto mat = rend.CreateMaterial(spec);
 	return mat;
-}
\ No newline at end of file
+}
+
+bool MaterialAsset::Read(const std::string& path)
+{
+	const AssetFile file = OpenFile(path);
+	if (!file.IsOpen())
+	{
+		SC_ErrorEvent("Could not open material file.");
+		return false;
+	}
+
+	const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+	std::istringstream text{ std::string(file.Text()) };
+	std::string line;
+	ShaderPath.clear();
+	for (size_t number = 1; std::getline(text, line); number++)
+	{
+		line.erase(std::min(line.find('#'), line.size()));
+		std::istringstream fields(line);
+		std::string key, value;
+		if (!(fields >> key))
+			continue;
+		if (!(fields >> value))
+		{
+			std::cerr << "[ENGINE][ASSETS]: " << path << ":" << number << ": " << key << " needs a value." << std::endl;
+			return false;
+		}
+
+		if (key == "shader")
+		{
+			ShaderPath = (directory / value).lexically_normal().generic_string();
+		}
+		else
+		{
+			std::cerr << "[ENGINE][ASSETS]: " << path << ":" << number << ": unknown key " << key << "." << std::endl;
+			return false;
+		}
+	}
+
+	if (ShaderPath.empty())
+	{
+		std::cerr << "[ENGINE][ASSETS]: " << path << " has no shader." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+std::vector<AssetDependency> MaterialAsset::GetAssetDependencies() const
+{
+	return { { AssetType::DX11_SHADER, ShaderPath } };
+}
+
+bool MaterialAsset::Link(std::span<const std::shared_ptr<Asset>> dependencies)
+{
+	Shader = dependencies.empty() ? nullptr : std::dynamic_pointer_cast<ShaderAsset>(dependencies[0]);
+	if (!Shader)
+		return false;
+	if (MaterialObj)
+		MaterialObj->Shader = Shader->ShaderObj;
+	return true;
+}
+
+bool MaterialAsset::Upload()
+{
+	if (!Shader)
+		return false;
+	MaterialObj = std::dynamic_pointer_cast<DX11Material>(Shader->PackMat());
+	return MaterialObj != nullptr;
+}
+
+bool MaterialAsset::Replace(Asset& fresh)
+{
+	MaterialAsset* other = dynamic_cast<MaterialAsset*>(&fresh);
+	if (!other || !other->MaterialObj)
+		return false;
+	ShaderPath = std::move(other->ShaderPath);
+	Shader = std::move(other->Shader);
+	if (MaterialObj)
+		MaterialObj->Shader = other->MaterialObj->Shader;
+	else
+		MaterialObj = other->MaterialObj;
+	return true;
+}
@@ -0,0 +1,804 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <Assets/MeshImporter.h>
+#include <Assets/MeshFile.h>
+#include <Core/MappedFile.h>
+#include <Graphics/MeshOptimizer.h>
+#include <Graphics/MeshSimplifier.h>
+
+// JSON, just enough for glTF: the whole document as a tree of values.
+
+class JsonValue
+{
+public:
+	enum class Kind
+	{
+		Null,
+		Bool,
+		Number,
+		String,
+		Array,
+		Object
+	};
+
+	Kind Type = Kind::Null;
+	bool Bool = false;
+	double Number = 0;
+	std::string String;
+	std::vector<JsonValue> Items;
+	std::vector<std::pair<std::string, JsonValue>> Members;
+
+	// Missing members and out of range items are null, so lookups can be chained.
+	const JsonValue& operator[](std::string_view key) const
+	{
+		for (const auto& member : Members)
+			if (member.first == key)
+				return member.second;
+		return Null();
+	}
+
+	const JsonValue& operator[](size_t index) const
+	{
+		return index < Items.size() ? Items[index] : Null();
+	}
+
+	bool IsNull() const { return Type == Kind::Null; }
+	size_t Size() const { return Items.size(); }
+	double AsNumber(double fallback = 0) const { return Type == Kind::Number ? Number : fallback; }
+	// -1 unless a non-negative integer, which is how glTF indices are checked.
+	int64_t AsIndex() const { return Type == Kind::Number && Number >= 0 && Number == std::floor(Number) ? static_cast<int64_t>(Number) : -1; }
+
+	static const JsonValue& Null()
+	{
+		static const JsonValue null;
+		return null;
+	}
+};
+
+class JsonParser
+{
+public:
+	JsonParser(std::string_view text) : P(text.data()), End(text.data() + text.size()) {}
+
+	bool Parse(JsonValue& value)
+	{
+		if (!ParseValue(value, 0))
+			return false;
+		SkipSpace();
+		return P == End;
+	}
+
+private:
+	static constexpr int MaxDepth = 256;
+
+	void SkipSpace()
+	{
+		while (P < End && (*P == ' ' || *P == '\t' || *P == '\n' || *P == '\r'))
+			P++;
+	}
+
+	bool Literal(std::string_view word)
+	{
+		if (static_cast<size_t>(End - P) < word.size() || std::string_view(P, word.size()) != word)
+			return false;
+		P += word.size();
+		return true;
+	}
+
+	bool ParseValue(JsonValue& value, int depth)
+	{
+		if (depth > MaxDepth)
+			return false;
+		SkipSpace();
+		if (P >= End)
+			return false;
+
+		switch (*P)
+		{
+		case '{':
+		{
+			value.Type = JsonValue::Kind::Object;
+			P++;
+			SkipSpace();
+			if (P < End && *P == '}')
+				return ++P, true;
+			while (true)
+			{
+				SkipSpace();
+				std::string key;
+				if (!ParseString(key))
+					return false;
+				SkipSpace();
+				if (P >= End || *P++ != ':')
+					return false;
+				value.Members.emplace_back(std::move(key), JsonValue());
+				if (!ParseValue(value.Members.back().second, depth + 1))
+					return false;
+				SkipSpace();
+				if (P < End && *P == ',')
+				{
+					P++;
+					continue;
+				}
+				return P < End && *P++ == '}';
+			}
+		}
+		case '[':
+		{
+			value.Type = JsonValue::Kind::Array;
+			P++;
+			SkipSpace();
+			if (P < End && *P == ']')
+				return ++P, true;
+			while (true)
+			{
+				value.Items.emplace_back();
+				if (!ParseValue(value.Items.back(), depth + 1))
+					return false;
+				SkipSpace();
+				if (P < End && *P == ',')
+				{
+					P++;
+					continue;
+				}
+				return P < End && *P++ == ']';
+			}
+		}
+		case '"':
+			value.Type = JsonValue::Kind::String;
+			return ParseString(value.String);
+		case 't':
+			value.Type = JsonValue::Kind::Bool;
+			value.Bool = true;
+			return Literal("true");
+		case 'f':
+			value.Type = JsonValue::Kind::Bool;
+			return Literal("false");
+		case 'n':
+			return Literal("null");
+		default:
+		{
+			value.Type = JsonValue::Kind::Number;
+			const std::from_chars_result result = std::from_chars(P, End, value.Number);
+			if (result.ec != std::errc())
+				return false;
+			P = result.ptr;
+			return true;
+		}
+		}
+	}
+
+	static void AppendUtf8(std::string& out, uint32_t code)
+	{
+		if (code < 0x80)
+		{
+			out += static_cast<char>(code);
+		}
+		else if (code < 0x800)
+		{
+			out += static_cast<char>(0xC0 | (code >> 6));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else if (code < 0x10000)
+		{
+			out += static_cast<char>(0xE0 | (code >> 12));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else
+		{
+			out += static_cast<char>(0xF0 | (code >> 18));
+			out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+	}
+
+	bool ParseHex4(uint32_t& code)
+	{
+		if (End - P < 4)
+			return false;
+		const std::from_chars_result result = std::from_chars(P, P + 4, code, 16);
+		if (result.ptr != P + 4)
+			return false;
+		P += 4;
+		return true;
+	}
+
+	bool ParseString(std::string& out)
+	{
+		if (P >= End || *P != '"')
+			return false;
+		P++;
+		while (P < End && *P != '"')
+		{
+			if (*P != '\\')
+			{
+				out += *P++;
+				continue;
+			}
+			if (++P >= End)
+				return false;
+			switch (*P++)
+			{
+			case '"': out += '"'; break;
+			case '\\': out += '\\'; break;
+			case '/': out += '/'; break;
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'n': out += '\n'; break;
+			case 'r': out += '\r'; break;
+			case 't': out += '\t'; break;
+			case 'u':
+			{
+				uint32_t code = 0;
+				if (!ParseHex4(code))
+					return false;
+				if (code >= 0xD800 && code < 0xDC00 && End - P >= 6 && P[0] == '\\' && P[1] == 'u')
+				{
+					P += 2;
+					uint32_t low = 0;
+					if (!ParseHex4(low) || low < 0xDC00 || low >= 0xE000)
+						return false;
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				}
+				AppendUtf8(out, code);
+			}
+			break;
+			default:
+				return false;
+			}
+		}
+		return P < End && *P++ == '"';
+	}
+
+	const char* P;
+	const char* End;
+};
+
+// glTF
+
+constexpr uint32_t GlbMagic = 0x46546C67;		// "glTF"
+constexpr uint32_t GlbJsonChunk = 0x4E4F534A;	// "JSON"
+constexpr uint32_t GlbBinChunk = 0x004E4942;	// "BIN\0"
+
+enum GltfComponentType
+{
+	GLTF_BYTE = 5120,
+	GLTF_UNSIGNED_BYTE = 5121,
+	GLTF_SHORT = 5122,
+	GLTF_UNSIGNED_SHORT = 5123,
+	GLTF_UNSIGNED_INT = 5125,
+	GLTF_FLOAT = 5126
+};
+
+constexpr int64_t GltfTriangles = 4;
+
+static size_t ComponentSize(int64_t type)
+{
+	switch (type)
+	{
+	case GLTF_BYTE: case GLTF_UNSIGNED_BYTE: return 1;
+	case GLTF_SHORT: case GLTF_UNSIGNED_SHORT: return 2;
+	case GLTF_UNSIGNED_INT: case GLTF_FLOAT: return 4;
+	default: return 0;
+	}
+}
+
+static int ComponentCount(const std::string& type)
+{
+	if (type == "SCALAR") return 1;
+	if (type == "VEC2") return 2;
+	if (type == "VEC3") return 3;
+	if (type == "VEC4") return 4;
+	return 0;
+}
+
+static bool DecodeBase64(std::string_view text, std::vector<uint8_t>& out)
+{
+	uint32_t bits = 0;
+	int count = 0;
+	for (char c : text)
+	{
+		int value;
+		if (c >= 'A' && c <= 'Z') value = c - 'A';
+		else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+		else if (c >= '0' && c <= '9') value = c - '0' + 52;
+		else if (c == '+' || c == '-') value = 62;
+		else if (c == '/' || c == '_') value = 63;
+		else if (c == '=') break;
+		else return false;
+		bits = (bits << 6) | static_cast<uint32_t>(value);
+		count += 6;
+		if (count >= 8)
+		{
+			count -= 8;
+			out.push_back(static_cast<uint8_t>(bits >> count));
+		}
+	}
+	return true;
+}
+
+static std::string DecodeUri(std::string_view uri)
+{
+	std::string decoded;
+	for (size_t i = 0; i < uri.size(); i++)
+	{
+		unsigned int code = 0;
+		if (uri[i] == '%' && i + 2 < uri.size() && std::from_chars(uri.data() + i + 1, uri.data() + i + 3, code, 16).ptr == uri.data() + i + 3)
+		{
+			decoded += static_cast<char>(code);
+			i += 2;
+		}
+		else
+		{
+			decoded += uri[i];
+		}
+	}
+	return decoded;
+}
+
+// Column-major 4x4, as glTF stores it.
+struct GltfMatrix
+{
+	float M[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+	GltfMatrix operator*(const GltfMatrix& other) const
+	{
+		GltfMatrix result;
+		for (int column = 0; column < 4; column++)
+			for (int row = 0; row < 4; row++)
+			{
+				float sum = 0;
+				for (int k = 0; k < 4; k++)
+					sum += M[k * 4 + row] * other.M[column * 4 + k];
+				result.M[column * 4 + row] = sum;
+			}
+		return result;
+	}
+
+	SCVector3f TransformPoint(const SCVector3f& p) const
+	{
+		return SCVector3f(M[0] * p.X + M[4] * p.Y + M[8] * p.Z + M[12],
+			M[1] * p.X + M[5] * p.Y + M[9] * p.Z + M[13],
+			M[2] * p.X + M[6] * p.Y + M[10] * p.Z + M[14]);
+	}
+
+	float Determinant3() const
+	{
+		return M[0] * (M[5] * M[10] - M[9] * M[6]) - M[4] * (M[1] * M[10] - M[9] * M[2]) + M[8] * (M[1] * M[6] - M[5] * M[2]);
+	}
+
+	// The cofactor matrix is the inverse transpose scaled by the determinant, which is all a
+	// normal needs before it is renormalized, and it exists for singular matrices too.
+	SCVector3f TransformNormal(const SCVector3f& n) const
+	{
+		const SCVector3f x(M[0], M[1], M[2]), y(M[4], M[5], M[6]), z(M[8], M[9], M[10]);
+		const SCVector3f cx = y.Cross(z), cy = z.Cross(x), cz = x.Cross(y);
+		const SCVector3f result = cx * n.X + cy * n.Y + cz * n.Z;
+		const float length = std::sqrt(result.Dot(result));
+		return length > 0 ? result * (1.0f / length) : n;
+	}
+};
+
+static GltfMatrix NodeTransform(const JsonValue& node)
+{
+	GltfMatrix local;
+	if (node["matrix"].Size() == 16)
+	{
+		for (size_t i = 0; i < 16; i++)
+			local.M[i] = static_cast<float>(node["matrix"][i].AsNumber());
+		return local;
+	}
+
+	const JsonValue& t = node["translation"];
+	const JsonValue& r = node["rotation"];
+	const JsonValue& s = node["scale"];
+	const float x = static_cast<float>(r[0].AsNumber(0)), y = static_cast<float>(r[1].AsNumber(0));
+	const float z = static_cast<float>(r[2].AsNumber(0)), w = static_cast<float>(r[3].AsNumber(1));
+	const float sx = static_cast<float>(s[0].AsNumber(1)), sy = static_cast<float>(s[1].AsNumber(1)), sz = static_cast<float>(s[2].AsNumber(1));
+
+	// T * R * S
+	local.M[0] = (1 - 2 * (y * y + z * z)) * sx;
+	local.M[1] = (2 * (x * y + z * w)) * sx;
+	local.M[2] = (2 * (x * z - y * w)) * sx;
+	local.M[4] = (2 * (x * y - z * w)) * sy;
+	local.M[5] = (1 - 2 * (x * x + z * z)) * sy;
+	local.M[6] = (2 * (y * z + x * w)) * sy;
+	local.M[8] = (2 * (x * z + y * w)) * sz;
+	local.M[9] = (2 * (y * z - x * w)) * sz;
+	local.M[10] = (1 - 2 * (x * x + y * y)) * sz;
+	local.M[12] = static_cast<float>(t[0].AsNumber());
+	local.M[13] = static_cast<float>(t[1].AsNumber());
+	local.M[14] = static_cast<float>(t[2].AsNumber());
+	return local;
+}
+
+class GltfImporter
+{
+public:
+	GltfImporter(const std::string& path, Mesh& mesh, const MeshImportSettings& settings)
+		: Path(path), Output(mesh), Settings(settings) {}
+
+	bool Import();
+
+private:
+	bool Fail(const std::string& message)
+	{
+		std::cerr << "[ENGINE][ASSETS]: " << Path << ": " << message << std::endl;
+		return false;
+	}
+
+	bool LoadDocument();
+	bool LoadBuffers();
+	bool AccessorData(int64_t index, size_t& count, size_t& stride, const uint8_t*& data, int64_t& componentType, int components);
+	bool ReadFloats(int64_t index, int components, std::vector<float>& out);
+	bool ReadIndices(int64_t index, std::vector<unsigned int>& out);
+	bool AddNode(int64_t index, const GltfMatrix& parent, int depth);
+	bool AddMesh(int64_t index, const GltfMatrix& transform);
+	bool AddPrimitive(const JsonValue& primitive, const GltfMatrix& transform);
+
+	std::string Path;
+	Mesh& Output;
+	const MeshImportSettings& Settings;
+
+	JsonValue Document;
+	SCMappedFile File;
+	std::span<const uint8_t> GlbBin;
+	std::vector<SCMappedFile> ExternalBuffers;
+	std::vector<std::vector<uint8_t>> EmbeddedBuffers;
+	std::vector<std::span<const uint8_t>> Buffers;
+};
+
+bool GltfImporter::LoadDocument()
+{
+	if (!File.Open(Path))
+		return Fail("could not open file");
+
+	std::string_view json(reinterpret_cast<const char*>(File.GetData()), File.GetSize());
+	uint32_t header[3];
+	if (File.GetSize() >= sizeof(header) && (std::memcpy(header, File.GetData(), sizeof(header)), header[0] == GlbMagic))
+	{
+		// GLB: a 12-byte header, then 8-byte aligned chunks (length, type, data). JSON comes first.
+		if (header[1] != 2 || header[2] > File.GetSize())
+			return Fail("unsupported GLB version or truncated file");
+		json = {};
+		for (size_t offset = sizeof(header); offset + 8 <= header[2];)
+		{
+			uint32_t chunk[2];
+			std::memcpy(chunk, File.GetData() + offset, sizeof(chunk));
+			offset += sizeof(chunk);
+			if (chunk[0] > header[2] - offset)
+				return Fail("truncated GLB chunk");
+			if (chunk[1] == GlbJsonChunk && json.empty())
+				json = std::string_view(reinterpret_cast<const char*>(File.GetData() + offset), chunk[0]);
+			else if (chunk[1] == GlbBinChunk && GlbBin.empty())
+				GlbBin = std::span<const uint8_t>(File.GetData() + offset, chunk[0]);
+			offset += (chunk[0] + 3) & ~size_t(3);
+		}
+	}
+
+	if (!JsonParser(json).Parse(Document) || Document.Type != JsonValue::Kind::Object)
+		return Fail("invalid JSON");
+	if (Document["asset"]["version"].String.rfind("2.", 0) != 0)
+		return Fail("not a glTF 2.0 asset");
+	return true;
+}
+
+bool GltfImporter::LoadBuffers()
+{
+	const std::string directory = Path.substr(0, Path.find_last_of("/\\") + 1);
+	const JsonValue& buffers = Document["buffers"];
+	ExternalBuffers.resize(buffers.Size());
+	EmbeddedBuffers.resize(buffers.Size());
+	for (size_t i = 0; i < buffers.Size(); i++)
+	{
+		const JsonValue& buffer = buffers[i];
+		const std::string& uri = buffer["uri"].String;
+		std::span<const uint8_t> data;
+		if (uri.empty())
+		{
+			data = GlbBin;
+		}
+		else if (uri.rfind("data:", 0) == 0)
+		{
+			const size_t comma = uri.find(',');
+			if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos
+				|| !DecodeBase64(std::string_view(uri).substr(comma + 1), EmbeddedBuffers[i]))
+				return Fail("unsupported data URI in buffer " + std::to_string(i));
+			data = EmbeddedBuffers[i];
+		}
+		else
+		{
+			if (!ExternalBuffers[i].Open(directory + DecodeUri(uri)))
+				return Fail("could not open buffer " + uri);
+			data = ExternalBuffers[i].Bytes();
+		}
+
+		const int64_t length = buffer["byteLength"].AsIndex();
+		if (length < 0 || static_cast<size_t>(length) > data.size())
+			return Fail("buffer " + std::to_string(i) + " is shorter than its byteLength");
+		Buffers.push_back(data.first(static_cast<size_t>(length)));
+	}
+	return true;
+}
+
+// Resolves an accessor to its first element and stride, checking everything lies in its buffer.
+bool GltfImporter::AccessorData(int64_t index, size_t& count, size_t& stride, const uint8_t*& data, int64_t& componentType, int components)
+{
+	const JsonValue& accessor = Document["accessors"][static_cast<size_t>(index)];
+	if (index < 0 || accessor.IsNull())
+		return Fail("missing accessor");
+	if (!accessor["sparse"].IsNull())
+		return Fail("sparse accessors are not supported");
+
+	componentType = accessor["componentType"].AsIndex();
+	const int64_t accessorCount = accessor["count"].AsIndex();
+	const size_t elementSize = ComponentSize(componentType) * components;
+	if (ComponentCount(accessor["type"].String) != components || elementSize == 0 || accessorCount < 0)
+		return Fail("unexpected accessor layout");
+	count = static_cast<size_t>(accessorCount);
+
+	if (accessor["bufferView"].IsNull())
+	{
+		data = nullptr; // all zeros
+		stride = 0;
+		return true;
+	}
+	const JsonValue& view = Document["bufferViews"][static_cast<size_t>(accessor["bufferView"].AsIndex())];
+	const int64_t bufferIndex = view["buffer"].AsIndex();
+	if (view.IsNull() || bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= Buffers.size())
+		return Fail("missing buffer view");
+
+	const std::span<const uint8_t> buffer = Buffers[static_cast<size_t>(bufferIndex)];
+	const uint64_t viewOffset = static_cast<uint64_t>(std::max<int64_t>(view["byteOffset"].AsIndex(), 0));
+	const uint64_t viewLength = static_cast<uint64_t>(std::max<int64_t>(view["byteLength"].AsIndex(), 0));
+	const uint64_t offset = static_cast<uint64_t>(std::max<int64_t>(accessor["byteOffset"].AsIndex(), 0));
+	stride = view["byteStride"].IsNull() ? elementSize : static_cast<size_t>(std::max<int64_t>(view["byteStride"].AsIndex(), 0));
+	if (stride < elementSize || viewOffset + viewLength > buffer.size()
+		|| (count > 0 && offset + (count - 1) * stride + elementSize > viewLength))
+		return Fail("accessor out of bounds");
+
+	data = buffer.data() + viewOffset + offset;
+	return true;
+}
+
+bool GltfImporter::ReadFloats(int64_t index, int components, std::vector<float>& out)
+{
+	size_t count, stride;
+	const uint8_t* data;
+	int64_t type;
+	if (!AccessorData(index, count, stride, data, type, components))
+		return false;
+	const bool normalized = Document["accessors"][static_cast<size_t>(index)]["normalized"].Bool;
+	if (type != GLTF_FLOAT && !normalized)
+		return Fail("unsupported non-float attribute");
+
+	out.assign(count * components, 0.0f);
+	if (!data)
+		return true;
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint8_t* element = data + i * stride;
+		for (int c = 0; c < components; c++)
+		{
+			float& value = out[i * components + c];
+			switch (type)
+			{
+			case GLTF_FLOAT: std::memcpy(&value, element + c * 4, 4); break;
+			case GLTF_UNSIGNED_BYTE: value = element[c] / 255.0f; break;
+			case GLTF_BYTE: value = std::max(static_cast<int8_t>(element[c]) / 127.0f, -1.0f); break;
+			case GLTF_UNSIGNED_SHORT: { uint16_t v; std::memcpy(&v, element + c * 2, 2); value = v / 65535.0f; } break;
+			case GLTF_SHORT: { int16_t v; std::memcpy(&v, element + c * 2, 2); value = std::max(v / 32767.0f, -1.0f); } break;
+			default: return Fail("unsupported component type");
+			}
+		}
+	}
+	return true;
+}
+
+bool GltfImporter::ReadIndices(int64_t index, std::vector<unsigned int>& out)
+{
+	size_t count, stride;
+	const uint8_t* data;
+	int64_t type;
+	if (!AccessorData(index, count, stride, data, type, 1))
+		return false;
+
+	out.resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint8_t* element = data ? data + i * stride : nullptr;
+		switch (type)
+		{
+		case GLTF_UNSIGNED_BYTE: out[i] = element ? element[0] : 0; break;
+		case GLTF_UNSIGNED_SHORT: { uint16_t v = 0; if (element) std::memcpy(&v, element, 2); out[i] = v; } break;
+		case GLTF_UNSIGNED_INT: { uint32_t v = 0; if (element) std::memcpy(&v, element, 4); out[i] = v; } break;
+		default: return Fail("unsupported index type");
+		}
+	}
+	return true;
+}
+
+bool GltfImporter::AddPrimitive(const JsonValue& primitive, const GltfMatrix& transform)
+{
+	if (primitive["mode"].AsNumber(GltfTriangles) != GltfTriangles)
+	{
+		std::cerr << "[ENGINE][ASSETS]: " << Path << ": skipping a non-triangle primitive" << std::endl;
+		return true;
+	}
+
+	const JsonValue& attributes = primitive["attributes"];
+	std::vector<float> positions, normals, texCoords;
+	if (attributes["POSITION"].IsNull() || !ReadFloats(attributes["POSITION"].AsIndex(), 3, positions))
+		return Fail("primitive without readable positions");
+	if (!attributes["NORMAL"].IsNull() && !ReadFloats(attributes["NORMAL"].AsIndex(), 3, normals))
+		return false;
+	if (!attributes["TEXCOORD_0"].IsNull() && !ReadFloats(attributes["TEXCOORD_0"].AsIndex(), 2, texCoords))
+		return false;
+
+	const size_t count = positions.size() / 3;
+	if ((!normals.empty() && normals.size() != count * 3) || (!texCoords.empty() && texCoords.size() != count * 2))
+		return Fail("attribute counts differ");
+
+	std::vector<SCVertex> vertices(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		vertices[i].Position = transform.TransformPoint(SCVector3f(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]));
+		if (!normals.empty())
+			vertices[i].Normal = transform.TransformNormal(SCVector3f(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]));
+		if (!texCoords.empty())
+			vertices[i].TexCoord = SCVector2f(texCoords[i * 2], texCoords[i * 2 + 1]);
+	}
+
+	std::vector<unsigned int> indices;
+	if (primitive["indices"].IsNull())
+	{
+		indices.resize(count - count % 3);
+		for (size_t i = 0; i < indices.size(); i++)
+			indices[i] = static_cast<unsigned int>(i);
+	}
+	else if (!ReadIndices(primitive["indices"].AsIndex(), indices))
+	{
+		return false;
+	}
+	indices.resize(indices.size() - indices.size() % 3);
+	for (unsigned int index : indices)
+		if (index >= count)
+			return Fail("index out of range");
+
+	// A mirroring transform turns the winding around; swap it back.
+	if (transform.Determinant3() < 0)
+		for (size_t i = 0; i < indices.size(); i += 3)
+			std::swap(indices[i + 1], indices[i + 2]);
+
+	if (normals.empty() && Settings.GenerateNormals)
+		ComputeSmoothNormals(vertices, indices);
+
+	const size_t base = Output.Vertices.size();
+	if (base + vertices.size() > std::numeric_limits<uint32_t>::max())
+		return Fail("too many vertices for 32-bit indices");
+	Output.Vertices.insert(Output.Vertices.end(), vertices.begin(), vertices.end());
+	for (unsigned int index : indices)
+		Output.Indices.push_back(static_cast<unsigned int>(base + index));
+	return true;
+}
+
+bool GltfImporter::AddMesh(int64_t index, const GltfMatrix& transform)
+{
+	const JsonValue& mesh = Document["meshes"][static_cast<size_t>(index)];
+	if (index < 0 || mesh.IsNull())
+		return Fail("missing mesh");
+	for (const JsonValue& primitive : mesh["primitives"].Items)
+		if (!AddPrimitive(primitive, transform))
+			return false;
+	return true;
+}
+
+bool GltfImporter::AddNode(int64_t index, const GltfMatrix& parent, int depth)
+{
+	const JsonValue& node = Document["nodes"][static_cast<size_t>(index)];
+	if (index < 0 || node.IsNull() || depth > 64)
+		return Fail("missing node or node cycle");
+
+	const GltfMatrix transform = parent * NodeTransform(node);
+	if (!node["mesh"].IsNull() && !AddMesh(node["mesh"].AsIndex(), transform))
+		return false;
+	for (const JsonValue& child : node["children"].Items)
+		if (!AddNode(child.AsIndex(), transform, depth + 1))
+			return false;
+	return true;
+}
+
+// Identical vertices merged, first occurrence kept, in one linear-probing pass.
+static void DeduplicateVertices(Mesh& mesh)
+{
+	auto hashVertex = [](const SCVertex& vertex)
+		{
+			uint64_t hash = 0xcbf29ce484222325ull;
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&vertex);
+			for (size_t i = 0; i < sizeof(SCVertex); i++)
+				hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+			return hash ^ (hash >> 32);
+		};
+
+	size_t tableSize = 16;
+	while (tableSize < mesh.Vertices.size() * 2)
+		tableSize *= 2;
+	std::vector<uint32_t> table(tableSize, UINT32_MAX);
+	std::vector<uint32_t> remap(mesh.Vertices.size());
+	std::vector<SCVertex> unique;
+	unique.reserve(mesh.Vertices.size());
+
+	for (size_t i = 0; i < mesh.Vertices.size(); i++)
+	{
+		const SCVertex& vertex = mesh.Vertices[i];
+		size_t slot = hashVertex(vertex) & (tableSize - 1);
+		while (table[slot] != UINT32_MAX && std::memcmp(&unique[table[slot]], &vertex, sizeof(SCVertex)) != 0)
+			slot = (slot + 1) & (tableSize - 1);
+		if (table[slot] == UINT32_MAX)
+		{
+			table[slot] = static_cast<uint32_t>(unique.size());
+			unique.push_back(vertex);
+		}
+		remap[i] = table[slot];
+	}
+
+	for (unsigned int& index : mesh.Indices)
+		index = remap[index];
+	mesh.Vertices = std::move(unique);
+}
+
+bool GltfImporter::Import()
+{
+	if (!LoadDocument() || !LoadBuffers())
+		return false;
+
+	Output.Vertices.clear();
+	Output.Indices.clear();
+	Output.Lods.clear();
+
+	const JsonValue& scenes = Document["scenes"];
+	if (scenes.Size() > 0)
+	{
+		const int64_t sceneIndex = Document["scene"].IsNull() ? 0 : Document["scene"].AsIndex();
+		const JsonValue& scene = scenes[static_cast<size_t>(sceneIndex)];
+		if (sceneIndex < 0 || scene.IsNull())
+			return Fail("missing default scene");
+		for (const JsonValue& node : scene["nodes"].Items)
+			if (!AddNode(node.AsIndex(), GltfMatrix(), 0))
+				return false;
+	}
+	else
+	{
+		// No scene: every mesh once, untransformed.
+		for (size_t i = 0; i < Document["meshes"].Size(); i++)
+			if (!AddMesh(static_cast<int64_t>(i), GltfMatrix()))
+				return false;
+	}
+
+	if (Settings.Deduplicate)
+		DeduplicateVertices(Output);
+	SCMeshOptimizeReport report;
+	if (Settings.Optimize)
+		report = SCOptimizeMesh(Output);
+	if (Settings.Report)
+		*Settings.Report = report;
+	if (Settings.GenerateLods)
+		SCBuildLods(Output);
+
+	if (!Settings.CachePath.empty())
+		return WriteMeshFile(Settings.CachePath, Output.Vertices, Output.Indices, Output.Lods);
+	return true;
+}
+
+bool ImportGltf(const std::string& path, Mesh& mesh, const MeshImportSettings& settings)
+{
+	return GltfImporter(path, mesh, settings).Import();
+}
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <Assets/MeshFile.h>
+
+static size_t AlignUp(size_t value)
+{
+	return (value + MeshFileAlignment - 1) & ~(MeshFileAlignment - 1);
+}
+
+// True if [offset, offset + count * size) is aligned and lies within the file.
+static bool BlobInBounds(uint64_t offset, uint64_t count, uint64_t size, uint64_t fileSize)
+{
+	if (offset % MeshFileAlignment != 0 || offset > fileSize)
+		return false;
+	return count <= (fileSize - offset) / size;
+}
+
+bool MeshFile::Open(const std::string& path)
+{
+	return Open(AssetFileSystem::OpenLoose(path), path);
+}
+
+bool MeshFile::Open(AssetFile file, const std::string& name)
+{
+	Close();
+	if (!file.IsOpen())
+	{
+		std::cerr << "[ENGINE][ASSETS]: Could not map mesh file " << name << std::endl;
+		return false;
+	}
+	File = std::move(file);
+
+	const char* problem = nullptr;
+	const MeshFileHeader* header = reinterpret_cast<const MeshFileHeader*>(File.GetData());
+	// Older headers are shorter; fields past MeshFileHeaderV2Size are only read from version 3 on.
+	if (File.GetSize() < MeshFileHeaderV2Size || std::memcmp(header->Magic, MeshFileMagic, sizeof(MeshFileMagic)) != 0)
+		problem = "not a .scmesh file";
+	else if (header->Version == 0 || header->Version > MeshFileVersion)
+		problem = "unsupported version";
+	else if (header->HeaderSize < (header->Version >= 3 ? sizeof(MeshFileHeader) : MeshFileHeaderV2Size) || header->HeaderSize > File.GetSize())
+		problem = "bad header size";
+	else if (header->VertexStride != sizeof(SCVertex)
+		|| (header->IndexSize != sizeof(uint32_t) && (header->Version < 2 || header->IndexSize != sizeof(uint16_t))))
+		problem = "vertex or index layout does not match this build";
+	else if (!BlobInBounds(header->VertexOffset, header->VertexCount, header->VertexStride, File.GetSize())
+		|| !BlobInBounds(header->IndexOffset, header->IndexCount, header->IndexSize, File.GetSize()))
+		problem = "blob out of bounds or misaligned";
+	else if (header->VertexCount > std::numeric_limits<uint32_t>::max())
+		problem = "too many vertices for 32-bit indices";
+	else if (header->IndexSize == sizeof(uint16_t) && SCChooseIndexFormat(header->VertexCount) != SCIndexFormat::UInt16)
+		problem = "too many vertices for 16-bit indices";
+	else if (header->Version >= 3 && header->LodCount > 0 && !BlobInBounds(header->LodOffset, header->LodCount, sizeof(SCMeshLod), File.GetSize()))
+		problem = "LOD table out of bounds or misaligned";
+
+	if (!problem && header->Version >= 3)
+	{
+		const SCMeshLod* lods = reinterpret_cast<const SCMeshLod*>(File.GetData() + header->LodOffset);
+		for (uint32_t i = 0; i < header->LodCount && !problem; i++)
+			if (lods[i].IndexOffset > header->IndexCount || lods[i].IndexCount > header->IndexCount - lods[i].IndexOffset)
+				problem = "LOD out of the index range";
+	}
+
+	if (problem)
+	{
+		std::cerr << "[ENGINE][ASSETS]: Invalid mesh file " << name << ": " << problem << std::endl;
+		File = AssetFile();
+		return false;
+	}
+
+	Header = header;
+	return true;
+}
+
+void MeshFile::Close()
+{
+	Header = nullptr;
+	File = AssetFile();
+}
+
+void MeshFile::Prefetch() const
+{
+	if (!Header)
+		return;
+	File.Prefetch(Header->VertexOffset, Header->VertexCount * Header->VertexStride);
+	File.Prefetch(Header->IndexOffset, Header->IndexCount * Header->IndexSize);
+}
+
+std::span<const SCVertex> MeshFile::Vertices() const
+{
+	if (!Header)
+		return {};
+	return { reinterpret_cast<const SCVertex*>(File.GetData() + Header->VertexOffset), static_cast<size_t>(Header->VertexCount) };
+}
+
+SCIndexSpan MeshFile::Indices() const
+{
+	if (!Header)
+		return {};
+	const SCIndexFormat format = Header->IndexSize == sizeof(uint16_t) ? SCIndexFormat::UInt16 : SCIndexFormat::UInt32;
+	return SCIndexSpan(format, File.GetData() + Header->IndexOffset, static_cast<size_t>(Header->IndexCount));
+}
+
+std::span<const SCMeshLod> MeshFile::Lods() const
+{
+	if (!Header || Header->Version < 3 || Header->LodCount == 0)
+		return {};
+	return { reinterpret_cast<const SCMeshLod*>(File.GetData() + Header->LodOffset), Header->LodCount };
+}
+
+bool WriteMeshFile(const std::string& path, std::span<const SCVertex> vertices, SCIndexSpan indices, std::span<const SCMeshLod> lods)
+{
+	const SCIndexFormat format = SCChooseIndexFormat(vertices.size());
+	SCEncodedIndices encoded;
+	if (indices.GetFormat() != format)
+	{
+		encoded = SCEncodeIndices(indices, format);
+		indices = encoded.Span();
+	}
+
+	MeshFileHeader header = {};
+	std::memcpy(header.Magic, MeshFileMagic, sizeof(MeshFileMagic));
+	header.Version = MeshFileVersion;
+	header.HeaderSize = sizeof(MeshFileHeader);
+	header.VertexStride = sizeof(SCVertex);
+	header.IndexSize = SCIndexSize(format);
+	header.VertexCount = vertices.size();
+	header.IndexCount = indices.Size();
+	header.VertexOffset = AlignUp(sizeof(MeshFileHeader));
+	header.IndexOffset = AlignUp(header.VertexOffset + vertices.size_bytes());
+	header.LodOffset = lods.empty() ? 0 : AlignUp(header.IndexOffset + indices.SizeBytes());
+	header.LodCount = static_cast<uint32_t>(lods.size());
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		header.BoundsMin[axis] = vertices.empty() ? 0.0f : std::numeric_limits<float>::max();
+		header.BoundsMax[axis] = vertices.empty() ? 0.0f : -std::numeric_limits<float>::max();
+	}
+	for (const SCVertex& vertex : vertices)
+	{
+		const float position[3] = { vertex.Position.X, vertex.Position.Y, vertex.Position.Z };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			header.BoundsMin[axis] = std::min(header.BoundsMin[axis], position[axis]);
+			header.BoundsMax[axis] = std::max(header.BoundsMax[axis], position[axis]);
+		}
+	}
+
+	// Written beside the target and renamed over it, so a reader (or a file watcher) never sees
+	// it half written and a mapping of the old file is never truncated under it.
+	namespace fs = std::filesystem;
+	const uint64_t writer = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+		static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	const std::string temp = path + "." + std::to_string(writer) + ".tmp";
+
+	bool ok;
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		static const char padding[MeshFileAlignment] = {};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(padding, header.VertexOffset - sizeof(header));
+		file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size_bytes());
+		file.write(padding, header.IndexOffset - (header.VertexOffset + vertices.size_bytes()));
+		file.write(static_cast<const char*>(indices.GetData()), indices.SizeBytes());
+		if (!lods.empty())
+		{
+			file.write(padding, header.LodOffset - (header.IndexOffset + indices.SizeBytes()));
+			file.write(reinterpret_cast<const char*>(lods.data()), lods.size_bytes());
+		}
+		file.close();
+		ok = !file.fail();
+	}
+
+	std::error_code error;
+	if (ok)
+	{
+		fs::rename(temp, path, error);
+		ok = !error;
+	}
+	if (!ok)
+	{
+		fs::remove(temp, error);
+		std::cerr << "[ENGINE][ASSETS]: Could not write mesh file " << path << std::endl;
+		return false;
+	}
+	return true;
+}
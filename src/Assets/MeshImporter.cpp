@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <Assets/MeshFile.h>
+#include <Assets/MeshImporter.h>
+#include <Core/MappedFile.h>
+
+// Cached imports are the vertices, the LOD table and the indices back to back after their
+// counts and the optimizer's report, the indices in SCChooseIndexFormat width like a .scmesh.
+struct CachedMeshHeader
+{
+	uint64_t VertexCount;
+	uint64_t IndexCount;
+	uint32_t IndexSize;
+	uint32_t LodCount;
+	SCMeshOptimizeReport Report;
+};
+
+static_assert(sizeof(CachedMeshHeader) % sizeof(uint32_t) == 0 && sizeof(SCVertex) % sizeof(uint32_t) == 0
+	&& sizeof(SCMeshLod) % sizeof(uint32_t) == 0 && std::is_trivially_copyable_v<SCMeshLod>
+	&& std::is_trivially_copyable_v<SCMeshOptimizeReport>);
+
+static std::vector<uint8_t> PackMesh(const Mesh& mesh, const SCMeshOptimizeReport& report)
+{
+	const SCEncodedIndices indices = SCEncodeIndices(mesh.Indices, SCChooseIndexFormat(mesh.Vertices.size()));
+	const CachedMeshHeader header = { mesh.Vertices.size(), indices.Count, SCIndexSize(indices.Format), static_cast<uint32_t>(mesh.Lods.size()), report };
+	const size_t vertexBytes = mesh.Vertices.size() * sizeof(SCVertex);
+	const size_t lodBytes = mesh.Lods.size() * sizeof(SCMeshLod);
+	std::vector<uint8_t> blob(sizeof(header) + vertexBytes + lodBytes + indices.Data.size());
+	uint8_t* data = blob.data();
+	std::memcpy(data, &header, sizeof(header));
+	std::memcpy(data += sizeof(header), mesh.Vertices.data(), vertexBytes);
+	std::memcpy(data += vertexBytes, mesh.Lods.data(), lodBytes);
+	std::memcpy(data += lodBytes, indices.Data.data(), indices.Data.size());
+	return blob;
+}
+
+static bool UnpackMesh(const std::vector<uint8_t>& blob, Mesh& mesh, SCMeshOptimizeReport& report)
+{
+	CachedMeshHeader header;
+	if (blob.size() < sizeof(header))
+		return false;
+	std::memcpy(&header, blob.data(), sizeof(header));
+	if (header.IndexSize != sizeof(uint16_t) && header.IndexSize != sizeof(uint32_t))
+		return false;
+	uint64_t payload = blob.size() - sizeof(header);
+	if (header.VertexCount > payload / sizeof(SCVertex))
+		return false;
+	payload -= header.VertexCount * sizeof(SCVertex);
+	if (header.LodCount > payload / sizeof(SCMeshLod))
+		return false;
+	const uint64_t indexBytes = payload - header.LodCount * sizeof(SCMeshLod);
+	if (indexBytes % header.IndexSize != 0 || indexBytes / header.IndexSize != header.IndexCount)
+		return false;
+
+	report = header.Report;
+	const uint8_t* data = blob.data() + sizeof(header);
+	mesh.Vertices.resize(header.VertexCount);
+	std::memcpy(mesh.Vertices.data(), data, header.VertexCount * sizeof(SCVertex));
+	data += header.VertexCount * sizeof(SCVertex);
+	mesh.Lods.resize(header.LodCount);
+	std::memcpy(mesh.Lods.data(), data, header.LodCount * sizeof(SCMeshLod));
+	data += header.LodCount * sizeof(SCMeshLod);
+	for (const SCMeshLod& lod : mesh.Lods)
+		if (lod.IndexOffset > header.IndexCount || lod.IndexCount > header.IndexCount - lod.IndexOffset)
+			return false;
+
+	// The static_assert above keeps the indices aligned within the blob.
+	const SCIndexFormat format = header.IndexSize == sizeof(uint16_t) ? SCIndexFormat::UInt16 : SCIndexFormat::UInt32;
+	mesh.Indices = SCDecodeIndices(SCIndexSpan(format, data, header.IndexCount));
+	for (unsigned int index : mesh.Indices)
+		if (index >= header.VertexCount)
+			return false;
+	return true;
+}
+
+static bool RunImporter(const std::string& extension, const std::string& path, Mesh& mesh, const MeshImportSettings& settings)
+{
+	if (extension == "obj")
+		return ImportObj(path, mesh, settings);
+	if (extension == "gltf" || extension == "glb")
+		return ImportGltf(path, mesh, settings);
+
+	std::cerr << "[ENGINE][ASSETS]: No importer for " << path << std::endl;
+	return false;
+}
+
+bool ImportMesh(const std::string& path, Mesh& mesh, const MeshImportSettings& settings)
+{
+	const size_t dot = path.find_last_of('.');
+	std::string extension = dot == std::string::npos ? std::string() : path.substr(dot + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	SCMappedFile source;
+	if (!settings.Cache || !settings.Cache->IsEnabled() || (extension != "obj" && extension != "glb") || !source.Open(path))
+		return RunImporter(extension, path, mesh, settings);
+
+	// Threads and ChunkBytes don't change the output, so they stay out of the key.
+	const SCDerivedDataKey key = SCDerivedDataKeyBuilder(extension == "obj" ? "ObjImporter" : "GltfImporter", MeshImporterVersion)
+		.Add(source.GetData(), source.GetSize())
+		.Add(settings.Deduplicate).Add(settings.FlipV).Add(settings.GenerateNormals).Add(settings.Optimize).Add(settings.GenerateLods)
+		.Finish();
+	source.Close();
+
+	SCMeshOptimizeReport report;
+	std::vector<uint8_t> blob;
+	if (settings.Cache->Get(key, blob))
+	{
+		if (UnpackMesh(blob, mesh, report))
+		{
+			if (settings.Report)
+				*settings.Report = report;
+			return settings.CachePath.empty() || WriteMeshFile(settings.CachePath, mesh.Vertices, mesh.Indices, mesh.Lods);
+		}
+		std::cerr << "[ENGINE][ASSETS]: Discarding malformed cached import of " << path << std::endl;
+	}
+
+	// The report is cached whether or not this caller asked for it.
+	MeshImportSettings importSettings = settings;
+	importSettings.Report = &report;
+	if (!RunImporter(extension, path, mesh, importSettings))
+		return false;
+	settings.Cache->Put(key, PackMesh(mesh, report));
+	if (settings.Report)
+		*settings.Report = report;
+	return true;
+}
+
+void ComputeSmoothNormals(std::vector<SCVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	for (SCVertex& vertex : vertices)
+		vertex.Normal = SCVector3f();
+
+	// The unnormalized cross product is twice the triangle's area, which is the weighting wanted.
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		SCVertex& a = vertices[indices[i]];
+		SCVertex& b = vertices[indices[i + 1]];
+		SCVertex& c = vertices[indices[i + 2]];
+		const SCVector3f normal = (b.Position - a.Position).Cross(c.Position - a.Position);
+		a.Normal += normal;
+		b.Normal += normal;
+		c.Normal += normal;
+	}
+
+	for (SCVertex& vertex : vertices)
+	{
+		const float length = std::sqrt(vertex.Normal.Dot(vertex.Normal));
+		vertex.Normal = length > 0 ? vertex.Normal * (1.0f / length) : SCVector3f(0, 1, 0);
+	}
+}
@@ -0,0 +1,669 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <Assets/MeshImporter.h>
+#include <Assets/MeshFile.h>
+#include <Core/MappedFile.h>
+#include <Graphics/MeshOptimizer.h>
+#include <Graphics/MeshSimplifier.h>
+
+// Runs function(i) for every i in [0, count) on up to threads threads (the caller included),
+// handing out indices one at a time so uneven chunks balance out.
+template<typename F>
+static void ParallelFor(size_t count, unsigned int threads, F&& function)
+{
+	std::atomic<size_t> next{ 0 };
+	auto worker = [&]()
+		{
+			for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+				function(i);
+		};
+
+	const size_t helpers = std::min<size_t>(threads, count) - (count > 0 ? 1 : 0);
+	std::vector<std::thread> pool;
+	for (size_t t = 0; t < helpers; t++)
+		pool.emplace_back(worker);
+	worker();
+	for (std::thread& thread : pool)
+		thread.join();
+}
+
+// Number parsing
+
+static bool IsSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool IsDigit(char c)
+{
+	return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Eight ASCII digits at once, SIMD-within-a-register: the check and the conversion are a handful
+// of 64-bit operations instead of eight dependent multiply-adds.
+static bool IsEightDigits(uint64_t chunk)
+{
+	return ((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+static uint32_t ParseEightDigits(uint64_t chunk)
+{
+	chunk -= 0x3030303030303030ull;
+	chunk = (chunk * 10) + (chunk >> 8);
+	chunk = (((chunk & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))
+		+ (((chunk >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+	return static_cast<uint32_t>(chunk);
+}
+
+static bool LoadEightDigits(const char* p, const char* end, uint64_t& chunk)
+{
+	if (end - p < 8)
+		return false;
+	std::memcpy(&chunk, p, sizeof(chunk));
+	return IsEightDigits(chunk);
+}
+
+// Decimal floats as written by exporters. Up to 19 significant digits are kept exactly; with a
+// decimal exponent within +-22 the value is one correctly rounded double operation away, which is
+// then rounded to float. Anything else (hex floats, inf/nan, huge exponents) goes to from_chars.
+static bool ParseFloat(const char*& p, const char* end, float& out)
+{
+	static constexpr double PowersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const char* start = p;
+	const bool negative = p < end && *p == '-';
+	if (p < end && (*p == '-' || *p == '+'))
+		p++;
+
+	uint64_t mantissa = 0;
+	int significant = 0;
+	int exponent = 0;
+	bool anyDigits = false;
+	auto digits = [&](bool fraction)
+		{
+			for (uint64_t chunk; significant <= 11 && LoadEightDigits(p, end, chunk); p += 8)
+			{
+				mantissa = mantissa * 100000000 + ParseEightDigits(chunk);
+				significant = mantissa != 0 ? significant + 8 : 0; // leading zeros don't use up precision
+				exponent -= fraction ? 8 : 0;
+				anyDigits = true;
+			}
+			for (; p < end && IsDigit(*p); p++)
+			{
+				anyDigits = true;
+				if (mantissa == 0 && *p == '0')
+				{
+					exponent -= fraction ? 1 : 0;
+				}
+				else if (significant < 19)
+				{
+					mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+					significant++;
+					exponent -= fraction ? 1 : 0;
+				}
+				else if (!fraction)
+				{
+					exponent++;
+				}
+			}
+		};
+
+	digits(false);
+	if (p < end && *p == '.')
+	{
+		p++;
+		digits(true);
+	}
+
+	if (anyDigits && p < end && (*p == 'e' || *p == 'E'))
+	{
+		const char* exponentStart = p++;
+		const bool exponentNegative = p < end && *p == '-';
+		if (p < end && (*p == '-' || *p == '+'))
+			p++;
+		if (p < end && IsDigit(*p))
+		{
+			int value = 0;
+			for (; p < end && IsDigit(*p); p++)
+				value = std::min(value * 10 + (*p - '0'), 100000);
+			exponent += exponentNegative ? -value : value;
+		}
+		else
+		{
+			p = exponentStart; // "1e" is 1 followed by junk
+		}
+	}
+
+	if (anyDigits && mantissa < (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+	{
+		double value = static_cast<double>(mantissa);
+		value = exponent < 0 ? value / PowersOfTen[-exponent] : value * PowersOfTen[exponent];
+		out = static_cast<float>(negative ? -value : value);
+		return true;
+	}
+
+	const std::from_chars_result result = std::from_chars(start + (start < end && *start == '+' ? 1 : 0), end, out);
+	if (result.ec == std::errc::result_out_of_range)
+	{
+		// from_chars leaves out alone here; overflow to infinity and underflow to zero.
+		const float magnitude = exponent + significant > 0 ? std::numeric_limits<float>::infinity() : 0.0f;
+		out = negative ? -magnitude : magnitude;
+	}
+	else if (result.ec != std::errc())
+	{
+		p = start;
+		return false;
+	}
+	p = result.ptr;
+	return true;
+}
+
+static bool ParseInteger(const char*& p, const char* end, int64_t& out)
+{
+	const bool negative = p < end && *p == '-';
+	if (p < end && (*p == '-' || *p == '+'))
+		p++;
+	if (p >= end || !IsDigit(*p))
+		return false;
+	int64_t value = 0;
+	for (; p < end && IsDigit(*p); p++)
+		value = std::min<int64_t>(value * 10 + (*p - '0'), int64_t(1) << 40);
+	out = negative ? -value : value;
+	return true;
+}
+
+static void SkipSpaces(const char*& p, const char* end)
+{
+	while (p < end && IsSpace(*p))
+		p++;
+}
+
+// Chunked parse
+
+constexpr uint32_t NoIndex = std::numeric_limits<uint32_t>::max();
+
+struct ObjCorner
+{
+	uint32_t Position;
+	uint32_t TexCoord;
+	uint32_t Normal;
+
+	bool operator==(const ObjCorner& other) const = default;
+};
+
+struct ObjCounts
+{
+	size_t Lines = 0;
+	size_t Positions = 0;
+	size_t TexCoords = 0;
+	size_t Normals = 0;
+	size_t Triangles = 0;
+
+	ObjCounts& operator+=(const ObjCounts& other)
+	{
+		Lines += other.Lines;
+		Positions += other.Positions;
+		TexCoords += other.TexCoords;
+		Normals += other.Normals;
+		Triangles += other.Triangles;
+		return *this;
+	}
+};
+
+struct ObjChunk
+{
+	const char* Begin;
+	const char* End;
+	ObjCounts Counts; // of this chunk, then (after the prefix sum) of everything before it
+	const char* Error = nullptr;
+	size_t ErrorLine = 0;
+};
+
+enum class ObjLine
+{
+	Other,
+	Position,
+	TexCoord,
+	Normal,
+	Face
+};
+
+// Classifies the line and leaves p after the keyword.
+static ObjLine Classify(const char*& p, const char* end)
+{
+	SkipSpaces(p, end);
+	if (end - p < 2 || !(IsSpace(p[1]) || (p[0] == 'v' && end - p >= 3 && IsSpace(p[2]))))
+		return ObjLine::Other;
+	if (p[0] == 'f' && IsSpace(p[1]))
+	{
+		p += 2;
+		return ObjLine::Face;
+	}
+	if (p[0] != 'v')
+		return ObjLine::Other;
+	if (IsSpace(p[1]))
+	{
+		p += 2;
+		return ObjLine::Position;
+	}
+	const char kind = p[1];
+	p += 3;
+	return kind == 't' ? ObjLine::TexCoord : kind == 'n' ? ObjLine::Normal : ObjLine::Other;
+}
+
+// Face tokens up to the end of the line or a comment.
+template<typename F>
+static bool ForEachFaceToken(const char* p, const char* end, F&& function)
+{
+	while (true)
+	{
+		SkipSpaces(p, end);
+		if (p >= end || *p == '#')
+			return true;
+		const char* token = p;
+		while (p < end && !IsSpace(*p))
+			p++;
+		if (!function(token, p))
+			return false;
+	}
+}
+
+// First pass: only counts, so the second pass can write straight into the final arrays.
+static void CountChunk(ObjChunk& chunk)
+{
+	for (const char* p = chunk.Begin; p < chunk.End;)
+	{
+		const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.End - p));
+		if (!lineEnd)
+			lineEnd = chunk.End;
+		chunk.Counts.Lines++;
+
+		switch (Classify(p, lineEnd))
+		{
+		case ObjLine::Position: chunk.Counts.Positions++; break;
+		case ObjLine::TexCoord: chunk.Counts.TexCoords++; break;
+		case ObjLine::Normal: chunk.Counts.Normals++; break;
+		case ObjLine::Face:
+		{
+			size_t tokens = 0;
+			ForEachFaceToken(p, lineEnd, [&](const char*, const char*) { tokens++; return true; });
+			chunk.Counts.Triangles += tokens >= 3 ? tokens - 2 : 0;
+		}
+		break;
+		default: break;
+		}
+
+		p = lineEnd + 1;
+	}
+}
+
+struct ObjData
+{
+	std::vector<SCVector3f> Positions;
+	std::vector<SCVector2f> TexCoords;
+	std::vector<SCVector3f> Normals;
+	std::vector<ObjCorner> Corners; // three per triangle
+};
+
+// OBJ indices are 1-based, or negative to count back from the latest element.
+static uint32_t ResolveIndex(int64_t index, size_t seen)
+{
+	const int64_t resolved = index > 0 ? index - 1 : static_cast<int64_t>(seen) + index;
+	return resolved >= 0 && resolved < static_cast<int64_t>(seen) ? static_cast<uint32_t>(resolved) : NoIndex;
+}
+
+static bool ParseCorner(const char* p, const char* end, const ObjCounts& seen, ObjCorner& corner)
+{
+	int64_t index;
+	if (!ParseInteger(p, end, index) || (corner.Position = ResolveIndex(index, seen.Positions)) == NoIndex)
+		return false;
+	corner.TexCoord = NoIndex;
+	corner.Normal = NoIndex;
+	if (p < end && *p == '/')
+	{
+		p++;
+		if (p < end && *p != '/')
+		{
+			if (!ParseInteger(p, end, index) || (corner.TexCoord = ResolveIndex(index, seen.TexCoords)) == NoIndex)
+				return false;
+		}
+		if (p < end && *p == '/')
+		{
+			p++;
+			if (!ParseInteger(p, end, index) || (corner.Normal = ResolveIndex(index, seen.Normals)) == NoIndex)
+				return false;
+		}
+	}
+	return p == end;
+}
+
+static bool ParseFloats(const char*& p, const char* end, float* out, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		SkipSpaces(p, end);
+		if (!ParseFloat(p, end, out[i]))
+			return false;
+	}
+	return true;
+}
+
+// Second pass. chunk.Counts holds the totals of the chunks before this one, which is where its
+// elements go and what its negative indices are relative to.
+static void ParseChunk(ObjChunk& chunk, ObjData& data, bool flipV)
+{
+	ObjCounts seen = chunk.Counts;
+	std::vector<ObjCorner> face;
+
+	auto fail = [&](const char* message)
+		{
+			chunk.Error = message;
+			chunk.ErrorLine = seen.Lines + 1;
+		};
+
+	for (const char* p = chunk.Begin; p < chunk.End; seen.Lines++)
+	{
+		const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.End - p));
+		if (!lineEnd)
+			lineEnd = chunk.End;
+
+		switch (Classify(p, lineEnd))
+		{
+		case ObjLine::Position:
+		{
+			float xyz[3];
+			if (!ParseFloats(p, lineEnd, xyz, 3))
+				return fail("bad vertex position");
+			data.Positions[seen.Positions++] = SCVector3f(xyz[0], xyz[1], xyz[2]);
+		}
+		break;
+		case ObjLine::TexCoord:
+		{
+			float uv[2] = { 0, 0 };
+			if (!ParseFloats(p, lineEnd, uv, 1))
+				return fail("bad texture coordinate");
+			ParseFloats(p, lineEnd, uv + 1, 1); // v is optional
+			data.TexCoords[seen.TexCoords++] = SCVector2f(uv[0], flipV ? 1.0f - uv[1] : uv[1]);
+		}
+		break;
+		case ObjLine::Normal:
+		{
+			float xyz[3];
+			if (!ParseFloats(p, lineEnd, xyz, 3))
+				return fail("bad vertex normal");
+			data.Normals[seen.Normals++] = SCVector3f(xyz[0], xyz[1], xyz[2]);
+		}
+		break;
+		case ObjLine::Face:
+		{
+			face.clear();
+			const bool ok = ForEachFaceToken(p, lineEnd, [&](const char* token, const char* tokenEnd)
+				{
+					ObjCorner corner;
+					if (!ParseCorner(token, tokenEnd, seen, corner))
+						return false;
+					face.push_back(corner);
+					return true;
+				});
+			if (!ok)
+				return fail("bad or out of range face index");
+			// Fan triangulation, which is what exporters assume for convex polygons.
+			for (size_t i = 2; i < face.size(); i++)
+			{
+				ObjCorner* triangle = &data.Corners[seen.Triangles++ * 3];
+				triangle[0] = face[0];
+				triangle[1] = face[i - 1];
+				triangle[2] = face[i];
+			}
+		}
+		break;
+		default: break;
+		}
+
+		p = lineEnd + 1;
+	}
+}
+
+// Vertex building
+
+static uint64_t HashCorner(const ObjCorner& corner)
+{
+	uint64_t hash = (static_cast<uint64_t>(corner.Position) << 32) ^ (static_cast<uint64_t>(corner.TexCoord) << 16) ^ corner.Normal;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+static SCVertex BuildVertex(const ObjData& data, const ObjCorner& corner)
+{
+	SCVertex vertex;
+	vertex.Position = data.Positions[corner.Position];
+	vertex.TexCoord = corner.TexCoord != NoIndex ? data.TexCoords[corner.TexCoord] : SCVector2f();
+	vertex.Normal = corner.Normal != NoIndex ? data.Normals[corner.Normal] : SCVector3f();
+	return vertex;
+}
+
+// Merges identical corners into shared vertices. Corners are partitioned into hash shards that
+// are deduplicated independently, one per thread, and the vertices are then numbered in order of
+// first use so the result matches a sequential pass and keeps the file's locality.
+static void DeduplicateCorners(const ObjData& data, Mesh& mesh, unsigned int threads)
+{
+	const std::vector<ObjCorner>& corners = data.Corners;
+	const size_t count = corners.size();
+	const size_t blockSize = 1 << 16;
+	const size_t blocks = (count + blockSize - 1) / blockSize;
+	uint32_t shardBits = 0;
+	while ((1u << shardBits) < threads * 8 && shardBits < 10)
+		shardBits++;
+	const size_t shards = size_t(1) << shardBits;
+	auto shardOf = [&](const ObjCorner& corner) { return shardBits ? static_cast<size_t>(HashCorner(corner) >> (64 - shardBits)) : 0; };
+
+	// Counting sort of corner indices by shard, keeping each shard's corners in file order.
+	std::vector<uint32_t> blockCounts(blocks * shards);
+	ParallelFor(blocks, threads, [&](size_t block)
+		{
+			uint32_t* counts = &blockCounts[block * shards];
+			for (size_t i = block * blockSize; i < std::min(count, (block + 1) * blockSize); i++)
+				counts[shardOf(corners[i])]++;
+		});
+	std::vector<size_t> shardStart(shards + 1);
+	std::vector<size_t> blockOffsets(blocks * shards);
+	size_t offset = 0;
+	for (size_t shard = 0; shard < shards; shard++)
+	{
+		shardStart[shard] = offset;
+		for (size_t block = 0; block < blocks; block++)
+		{
+			blockOffsets[block * shards + shard] = offset;
+			offset += blockCounts[block * shards + shard];
+		}
+	}
+	shardStart[shards] = offset;
+	std::vector<uint32_t> sorted(count);
+	ParallelFor(blocks, threads, [&](size_t block)
+		{
+			size_t* offsets = &blockOffsets[block * shards];
+			for (size_t i = block * blockSize; i < std::min(count, (block + 1) * blockSize); i++)
+				sorted[offsets[shardOf(corners[i])]++] = static_cast<uint32_t>(i);
+		});
+	blockOffsets = {};
+
+	// Per shard: a linear-probing table of first occurrences. Indices[i] gets the shard-local id.
+	mesh.Indices.resize(count);
+	std::vector<std::vector<uint32_t>> firstUse(shards);
+	std::vector<uint8_t> isFirst(count);
+	ParallelFor(shards, threads, [&](size_t shard)
+		{
+			const size_t begin = shardStart[shard];
+			const size_t end = shardStart[shard + 1];
+			size_t tableSize = 16;
+			while (tableSize < (end - begin) * 2)
+				tableSize *= 2;
+			std::vector<uint32_t> table(tableSize, NoIndex); // local ids
+			std::vector<uint32_t>& first = firstUse[shard];
+
+			for (size_t k = begin; k < end; k++)
+			{
+				const uint32_t i = sorted[k];
+				const ObjCorner& corner = corners[i];
+				for (size_t slot = (HashCorner(corner) & (tableSize - 1));; slot = (slot + 1) & (tableSize - 1))
+				{
+					const uint32_t local = table[slot];
+					if (local == NoIndex)
+					{
+						table[slot] = static_cast<uint32_t>(first.size());
+						mesh.Indices[i] = table[slot];
+						first.push_back(i);
+						isFirst[i] = 1;
+						break;
+					}
+					if (corners[first[local]] == corner)
+					{
+						mesh.Indices[i] = local;
+						break;
+					}
+				}
+			}
+		});
+	sorted = {};
+
+	// Number vertices by their first corner: a prefix sum of isFirst over the blocks.
+	std::vector<size_t> blockFirsts(blocks + 1);
+	ParallelFor(blocks, threads, [&](size_t block)
+		{
+			size_t firsts = 0;
+			for (size_t i = block * blockSize; i < std::min(count, (block + 1) * blockSize); i++)
+				firsts += isFirst[i];
+			blockFirsts[block + 1] = firsts;
+		});
+	for (size_t block = 0; block < blocks; block++)
+		blockFirsts[block + 1] += blockFirsts[block];
+
+	std::vector<std::vector<uint32_t>> globalIds(shards);
+	for (size_t shard = 0; shard < shards; shard++)
+		globalIds[shard].resize(firstUse[shard].size());
+	ParallelFor(blocks, threads, [&](size_t block)
+		{
+			size_t next = blockFirsts[block];
+			for (size_t i = block * blockSize; i < std::min(count, (block + 1) * blockSize); i++)
+				if (isFirst[i])
+					globalIds[shardOf(corners[i])][mesh.Indices[i]] = static_cast<uint32_t>(next++);
+		});
+	isFirst = {};
+
+	mesh.Vertices.resize(blockFirsts[blocks]);
+	ParallelFor(shards, threads, [&](size_t shard)
+		{
+			for (size_t local = 0; local < firstUse[shard].size(); local++)
+				mesh.Vertices[globalIds[shard][local]] = BuildVertex(data, corners[firstUse[shard][local]]);
+		});
+	ParallelFor(blocks, threads, [&](size_t block)
+		{
+			for (size_t i = block * blockSize; i < std::min(count, (block + 1) * blockSize); i++)
+				mesh.Indices[i] = globalIds[shardOf(corners[i])][mesh.Indices[i]];
+		});
+}
+
+bool ImportObj(const std::string& path, Mesh& mesh, const MeshImportSettings& settings)
+{
+	SCMappedFile file;
+	if (!file.Open(path))
+	{
+		std::cerr << "[ENGINE][ASSETS]: Could not open " << path << std::endl;
+		return false;
+	}
+	const unsigned int threads = settings.Threads ? settings.Threads : std::max(1u, std::thread::hardware_concurrency());
+
+	// Chunks end just after a newline, so no line is split between two of them.
+	std::vector<ObjChunk> chunks;
+	const char* text = reinterpret_cast<const char*>(file.GetData());
+	const char* textEnd = text + file.GetSize();
+	for (const char* begin = text; begin < textEnd;)
+	{
+		const char* end = begin + std::min<size_t>(std::max<size_t>(settings.ChunkBytes, 1), textEnd - begin);
+		if (end < textEnd)
+		{
+			const char* newline = static_cast<const char*>(std::memchr(end, '\n', textEnd - end));
+			end = newline ? newline + 1 : textEnd;
+		}
+		chunks.push_back({ begin, end, {} });
+		begin = end;
+	}
+
+	ParallelFor(chunks.size(), threads, [&](size_t i) { CountChunk(chunks[i]); });
+	ObjCounts total;
+	for (ObjChunk& chunk : chunks)
+	{
+		const ObjCounts counts = chunk.Counts;
+		chunk.Counts = total;
+		total += counts;
+	}
+	if (total.Triangles * 3 > std::numeric_limits<uint32_t>::max() || total.Positions >= NoIndex)
+	{
+		std::cerr << "[ENGINE][ASSETS]: " << path << " is too large for 32-bit indices" << std::endl;
+		return false;
+	}
+
+	ObjData data;
+	data.Positions.resize(total.Positions);
+	data.TexCoords.resize(total.TexCoords);
+	data.Normals.resize(total.Normals);
+	data.Corners.resize(total.Triangles * 3);
+	ParallelFor(chunks.size(), threads, [&](size_t i) { ParseChunk(chunks[i], data, settings.FlipV); });
+	for (const ObjChunk& chunk : chunks)
+	{
+		if (chunk.Error)
+		{
+			std::cerr << "[ENGINE][ASSETS]: " << path << ":" << chunk.ErrorLine << ": " << chunk.Error << std::endl;
+			return false;
+		}
+	}
+	file.Close();
+
+	mesh.Vertices.clear();
+	mesh.Indices.clear();
+	mesh.Lods.clear();
+	if (settings.Deduplicate)
+	{
+		DeduplicateCorners(data, mesh, threads);
+	}
+	else
+	{
+		const size_t count = data.Corners.size();
+		const size_t blockSize = 1 << 16;
+		mesh.Vertices.resize(count);
+		mesh.Indices.resize(count);
+		ParallelFor((count + blockSize - 1) / blockSize, threads, [&](size_t block)
+			{
+				for (size_t i = block * blockSize; i < std::min(count, (block + 1) * blockSize); i++)
+				{
+					mesh.Vertices[i] = BuildVertex(data, data.Corners[i]);
+					mesh.Indices[i] = static_cast<unsigned int>(i);
+				}
+			});
+	}
+
+	if (data.Normals.empty() && settings.GenerateNormals)
+		ComputeSmoothNormals(mesh.Vertices, mesh.Indices);
+	SCMeshOptimizeReport report;
+	if (settings.Optimize)
+		report = SCOptimizeMesh(mesh);
+	if (settings.Report)
+		*settings.Report = report;
+	if (settings.GenerateLods)
+		SCBuildLods(mesh);
+
+	if (!settings.CachePath.empty())
+		return WriteMeshFile(settings.CachePath, mesh.Vertices, mesh.Indices, mesh.Lods);
+	return true;
+}
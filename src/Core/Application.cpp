@@ -1,5 +1,6 @@
 #include <Core/Application.h>
 #include <Events/EventArgs.h>
+#include <Events/EventChannel.h>
 #include <Graphics/Camera.h>
 
 Application* Application::instance = nullptr;
@@ -11,6 +12,7 @@ Application::Application(const AppSettings& settings)
         instance = this;
         AppWindow = std::make_unique<Window>(settings.Title, settings.Size);
         RenderAPI = settings.RenderAPI;
+        EventDispatch = settings.EventDispatch;
     }
     else
     {
@@ -44,15 +46,16 @@ void Application::Init()
 void Application::Close()
 {
     EventSys->Halt();
+    Tasks.reset(); // after Halt, so no dispatch is still resuming coroutines
     SDL_DestroyWindow(AppWindow->SDLWindow.get());
     SDL_Quit();
 }
 
 struct MatrixBuffer
 {
-    XMMATRIX World;
-    XMMATRIX View;
-    XMMATRIX MVP;
+    SCMatrix4f World;
+    SCMatrix4f View;
+    SCMatrix4f MVP;
     float padding;
 };
 
@@ -195,8 +198,19 @@ void Application::Run()
 {
     Init();
 
-    EventSys = std::make_unique<EventSystem>();
+    EventSys = std::make_unique<EventSystem>(EventQueueSettings(), EventDispatch);
+    EventSys->SetCoalescing(EventType::APP_RENDER_LOOP, true);
+    Tasks = std::make_unique<SCTaskScheduler>(*EventSys);
     AssetMan = std::make_unique<AssetManager>();
+    if (RenderAPI == RendererAPI::DirectX11)
+        GetDX11Renderer().SetShaderCache(&AssetMan->GetDerivedDataCache());
+#ifndef NDEBUG
+    AssetMan->EnableHotReload("resources");
+#else
+    // Shipping builds read resources from the packed archive when there is one.
+    if (AssetMan->GetFileSystem().Exists("resources.scpak"))
+        AssetMan->GetFileSystem().Mount("resources.scpak");
+#endif
     EventSys->Launch();
 
     std::vector<SCVertex> vertices = {
@@ -266,26 +280,26 @@ void Application::Run()
     }
 
     DXCamera3D camera(
-        XMFLOAT3(0.0f, 1.0f, -3.0f), // Position
-        XMFLOAT3(0.0f, 0.0f, -1.0f),  // Target
-        XMFLOAT3(0.0f, 1.0f, 0.0f)   // Up
+        SCVector3f(0.0f, 1.0f, -3.0f), // Position
+        SCVector3f(0.0f, 0.0f, -1.0f),  // Target
+        SCVector3f(0.0f, 1.0f, 0.0f)   // Up
     );
 
-    constexpr float fovY = XMConvertToRadians(45.0f);
+    constexpr float fovY = SCToRadians(45.0f);
 
     camera.FOV = fovY;
 
     auto Proj = camera.ComputeProjectionMatrix(800/600);
 
-    //Proj = XMMatrixTranspose(Proj);
+    //Proj = Proj.Transpose();
 
     auto View = camera.ComputeViewMatrix();
 
-    //View = XMMatrixTranspose(View);
+    //View = View.Transpose();
     
     MatrixBuffer buffer;
 
-    auto world = XMMatrixIdentity();
+    auto world = SCMatrix4f::Identity();
 
     buffer.World = world;
     buffer.View = View;
@@ -324,55 +338,59 @@ void Application::Run()
             }
             if (event.type == SDL_EVENT_KEY_DOWN)
             {
-                XMVECTOR forwardVector = XMVector3Normalize(XMLoadFloat3(&camera.Target) - XMLoadFloat3(&camera.Position));
-                XMVECTOR rightVector = XMVector3Normalize(XMVector3Cross(forwardVector, XMLoadFloat3(&camera.Up)));
-
-                XMFLOAT3 forward;
-                XMFLOAT3 back;
-                XMFLOAT3 left;
-                XMFLOAT3 right;
-                XMStoreFloat3(&forward, forwardVector * deltaTime * 2.f);
-                XMStoreFloat3(&right, rightVector * deltaTime * 2.f);
-                XMStoreFloat3(&back, -forwardVector * deltaTime * 2.f);
-                XMStoreFloat3(&left, -rightVector * deltaTime * 2.f);
+                SCVector3f forwardVector = (camera.Target - camera.Position).Normalize();
+                SCVector3f rightVector = forwardVector.Cross(camera.Up).Normalize();
+
+                SCVector3f forward = forwardVector * deltaTime * 2.f;
+                SCVector3f right = rightVector * deltaTime * 2.f;
+                SCVector3f back = -forwardVector * deltaTime * 2.f;
+                SCVector3f left = -rightVector * deltaTime * 2.f;
 
                 switch (event.key.key)
                 {
                     case SDLK_W:
                         
-                        camera.Position = AddFloat3(camera.Position, forward);
-                        std::cout << "X: " << camera.Position.x << "Y: " << camera.Position.y << "Z: " << camera.Position.z << std::endl;
+                        camera.Position += forward;
+                        std::cout << "X: " << camera.Position.X << "Y: " << camera.Position.Y << "Z: " << camera.Position.Z << std::endl;
                         break;
                     case SDLK_S:
                         std::cout << "hello?" << std::endl;
-                        camera.Position = AddFloat3(camera.Position, back);
-                        std::cout << "X: " << camera.Position.x << "Y: " << camera.Position.y << "Z: " << camera.Position.z << std::endl;
+                        camera.Position += back;
+                        std::cout << "X: " << camera.Position.X << "Y: " << camera.Position.Y << "Z: " << camera.Position.Z << std::endl;
                         break;
                     case SDLK_A:
                         std::cout << "hello?" << std::endl;
-                        camera.Position = AddFloat3(camera.Position, right);
-                        std::cout << "X: " << camera.Position.x << "Y: " << camera.Position.y << "Z: " << camera.Position.z << std::endl;
+                        camera.Position += right;
+                        std::cout << "X: " << camera.Position.X << "Y: " << camera.Position.Y << "Z: " << camera.Position.Z << std::endl;
                         break;
                     case SDLK_D:
                         std::cout << "hello?" << std::endl;
-                        camera.Position = AddFloat3(camera.Position, left);
-                        std::cout << "X: " << camera.Position.x << "Y: " << camera.Position.y << "Z: " << camera.Position.z << std::endl;
+                        camera.Position += left;
+                        std::cout << "X: " << camera.Position.X << "Y: " << camera.Position.Y << "Z: " << camera.Position.Z << std::endl;
                         break;
                     case SDLK_Q:
-                        camera.Position = AddFloat3(camera.Position, XMFLOAT3(0,1,0));
+                        camera.Position += SCVector3f(0, 1, 0);
                         break;
                     case SDLK_E:
-                        camera.Position = AddFloat3(camera.Position, XMFLOAT3(0, -1, 0));
+                        camera.Position += SCVector3f(0, -1, 0);
                         break;
                 }
 
-                XMVECTOR newTarget = XMLoadFloat3(&camera.Position) + forwardVector;
-                XMStoreFloat3(&camera.Target, newTarget);
+                camera.Target = camera.Position + forwardVector;
             }
         }
 
+        // Timers fire on frame time. Deferred dispatch mode handles the frame's events here, after
+        // input and before rendering, followed by anything posted to typed channels and the uploads
+        // of assets whose async load finished reading.
+        EventSys->AdvanceTimers(deltaTime);
+        EventSys->Flush();
+        EventChannelBase::FlushAll();
+        AssetMan->Update();
+        Tasks->Tick(deltaTime);
+
         auto View = camera.ComputeViewMatrix();
-        world = XMMatrixTranslation(1, 0, 1) * XMMatrixScaling(1,1,1);
+        world = SCMatrix4f::Translation(1, 0, 1) * SCMatrix4f::Scaling(1, 1, 1);
         buffer.World = world;
         buffer.View = View;
         buffer.MVP = camera.ComputeMVPMatrix(static_cast<float>(AppWindow->GetSize().X) / static_cast<float>(AppWindow->GetSize().Y), world);
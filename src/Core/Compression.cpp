@@ -0,0 +1,186 @@
+#include <cstring>
+#include <vector>
+#include <Core/Compression.h>
+
+// Format constants from the LZ4 block specification.
+static constexpr size_t MinMatch = 4;
+static constexpr size_t LastLiterals = 5;	// the last 5 bytes are always literals
+static constexpr size_t MatchFindLimit = 12;	// and no match starts in the last 12
+static constexpr size_t MaxOffset = 65535;
+static constexpr int HashBits = 16;
+
+static uint32_t Read32(const uint8_t* p)
+{
+	uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static uint32_t Hash(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HashBits);
+}
+
+static uint8_t* WriteLength(uint8_t* op, size_t length)
+{
+	for (; length >= 255; length -= 255)
+		*op++ = 255;
+	*op++ = static_cast<uint8_t>(length);
+	return op;
+}
+
+size_t SCCompressBound(size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+size_t SCCompress(std::span<const uint8_t> src, std::span<uint8_t> dst)
+{
+	if (dst.size() < SCCompressBound(src.size()))
+		return 0;
+
+	const uint8_t* const base = src.data();
+	const size_t size = src.size();
+	uint8_t* op = dst.data();
+	size_t anchor = 0;
+
+	auto emit = [&](size_t literalEnd, size_t offset, size_t matchLength)
+		{
+			const size_t literals = literalEnd - anchor;
+			uint8_t* token = op++;
+			*token = static_cast<uint8_t>((literals >= 15 ? 15 : literals) << 4);
+			if (literals >= 15)
+				op = WriteLength(op, literals - 15);
+			if (literals > 0)
+				std::memcpy(op, base + anchor, literals);
+			op += literals;
+			if (matchLength == 0)
+				return;
+
+			*op++ = static_cast<uint8_t>(offset);
+			*op++ = static_cast<uint8_t>(offset >> 8);
+			const size_t extra = matchLength - MinMatch;
+			*token |= static_cast<uint8_t>(extra >= 15 ? 15 : extra);
+			if (extra >= 15)
+				op = WriteLength(op, extra - 15);
+		};
+
+	if (size > MatchFindLimit)
+	{
+		// Positions are stored +1 so 0 means empty.
+		std::vector<uint32_t> table(size_t(1) << HashBits, 0);
+		const size_t matchLimit = size - LastLiterals;
+		const size_t findLimit = size - MatchFindLimit;
+
+		for (size_t ip = 0; ip < findLimit;)
+		{
+			const uint32_t sequence = Read32(base + ip);
+			uint32_t& slot = table[Hash(sequence)];
+			size_t match = slot;
+			slot = static_cast<uint32_t>(ip + 1);
+
+			if (match == 0 || ip - (match - 1) > MaxOffset || Read32(base + match - 1) != sequence)
+			{
+				// Step faster through data that isn't matching.
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+			match--;
+
+			while (ip > anchor && match > 0 && base[ip - 1] == base[match - 1])
+			{
+				ip--;
+				match--;
+			}
+			size_t length = MinMatch;
+			while (ip + length < matchLimit && base[ip + length] == base[match + length])
+				length++;
+
+			emit(ip, ip - match, length);
+			ip += length;
+			anchor = ip;
+			if (ip - 2 < findLimit)
+				table[Hash(Read32(base + ip - 2))] = static_cast<uint32_t>(ip - 2 + 1);
+		}
+	}
+
+	emit(size, 0, 0);
+	return static_cast<size_t>(op - dst.data());
+}
+
+bool SCDecompress(std::span<const uint8_t> src, std::span<uint8_t> dst)
+{
+	const uint8_t* ip = src.data();
+	const uint8_t* const srcEnd = ip + src.size();
+	uint8_t* op = dst.data();
+	uint8_t* const dstEnd = op + dst.size();
+
+	auto readLength = [&](size_t& length)
+		{
+			uint8_t byte;
+			do
+			{
+				if (ip == srcEnd)
+					return false;
+				byte = *ip++;
+				length += byte;
+			} while (byte == 255);
+			return true;
+		};
+
+	while (ip < srcEnd)
+	{
+		const uint8_t token = *ip++;
+		size_t literals = token >> 4;
+		if (literals == 15 && !readLength(literals))
+			return false;
+		if (literals > static_cast<size_t>(srcEnd - ip) || literals > static_cast<size_t>(dstEnd - op))
+			return false;
+		// Short runs copy a fixed 16 bytes when both sides have the slack, which beats a
+		// variable-length memcpy; the extra bytes are overwritten by what follows.
+		if (literals <= 16 && srcEnd - ip >= 16 && dstEnd - op >= 16)
+			std::memcpy(op, ip, 16);
+		else if (literals > 0)
+			std::memcpy(op, ip, literals);
+		ip += literals;
+		op += literals;
+		if (ip == srcEnd)
+			return op == dstEnd; // the last sequence has no match
+
+		if (srcEnd - ip < 2)
+			return false;
+		const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<size_t>(op - dst.data()))
+			return false;
+
+		size_t length = token & 15;
+		if (length == 15 && !readLength(length))
+			return false;
+		length += MinMatch;
+		if (length > static_cast<size_t>(dstEnd - op))
+			return false;
+
+		const uint8_t* match = op - offset;
+		if (offset >= 8 && static_cast<size_t>(dstEnd - op) >= length + 8)
+		{
+			// Eight bytes at a time, possibly past the end of the match. Each chunk's source was
+			// written at least eight bytes earlier, so overlap doesn't matter.
+			for (size_t i = 0; i < length; i += 8)
+				std::memcpy(op + i, match + i, 8);
+			op += length;
+		}
+		else if (offset >= length)
+		{
+			std::memcpy(op, match, length);
+			op += length;
+		}
+		else
+		{
+			// Overlapping: the match repeats the last offset bytes.
+			for (size_t i = 0; i < length; i++)
+				*op++ = match[i];
+		}
+	}
+	return false; // ended on a match, or empty
+}
@@ -0,0 +1,240 @@
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <Core/DerivedDataCache.h>
+
+// Hashing. xxHash64-style stripes of four lanes for the bulk, with a second accumulator through
+// the tail so short inputs still get two independent halves.
+
+static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+static uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static uint64_t Read64(const uint8_t* p)
+{
+	uint64_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static uint64_t Round(uint64_t acc, uint64_t input)
+{
+	acc += input * Prime2;
+	return Rotl(acc, 31) * Prime1;
+}
+
+static uint64_t Avalanche(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= Prime2;
+	h ^= h >> 29;
+	h *= Prime3;
+	h ^= h >> 32;
+	return h;
+}
+
+SCDerivedDataKey SCHashBytes(const void* data, size_t size, uint64_t seed)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	const uint8_t* end = p + size;
+
+	uint64_t a = seed + Prime1 + Prime2, b = seed + Prime2, c = seed, d = seed - Prime1;
+	for (; end - p >= 32; p += 32)
+	{
+		a = Round(a, Read64(p));
+		b = Round(b, Read64(p + 8));
+		c = Round(c, Read64(p + 16));
+		d = Round(d, Read64(p + 24));
+	}
+
+	uint64_t low = Rotl(a, 1) + Rotl(b, 7) + Rotl(c, 12) + Rotl(d, 18) + size;
+	uint64_t high = (Rotl(a, 29) ^ Rotl(c, 43)) + (b ^ Rotl(d, 53)) * Prime3 + (seed ^ size) * Prime5;
+	for (; end - p >= 8; p += 8)
+	{
+		const uint64_t word = Read64(p);
+		low = Rotl(low ^ Round(0, word), 27) * Prime1 + Prime4;
+		high = Rotl(high ^ Round(Prime3, word), 31) * Prime2 + Prime5;
+	}
+	for (; p < end; p++)
+	{
+		low = Rotl(low ^ (*p * Prime5), 11) * Prime1;
+		high = Rotl(high ^ (*p * Prime4), 13) * Prime3;
+	}
+	return { Avalanche(high), Avalanche(low) };
+}
+
+std::string SCDerivedDataKey::ToHex() const
+{
+	static const char digits[] = "0123456789abcdef";
+	std::string hex(32, '0');
+	for (int i = 0; i < 16; i++)
+	{
+		hex[15 - i] = digits[(High >> (i * 4)) & 15];
+		hex[31 - i] = digits[(Low >> (i * 4)) & 15];
+	}
+	return hex;
+}
+
+SCDerivedDataKeyBuilder::SCDerivedDataKeyBuilder(std::string_view processor, uint32_t version)
+{
+	Key = SCHashBytes(processor.data(), processor.size(), version);
+}
+
+// Each piece is hashed seeded with the key so far, so order matters and pieces can't cancel.
+SCDerivedDataKeyBuilder& SCDerivedDataKeyBuilder::Add(const void* data, size_t size)
+{
+	const SCDerivedDataKey piece = SCHashBytes(data, size, Key.Low ^ Rotl(Key.High, 32));
+	Key.High = Avalanche(Key.High * Prime1 ^ piece.High);
+	Key.Low = piece.Low;
+	return *this;
+}
+
+SCDerivedDataKeyBuilder& SCDerivedDataKeyBuilder::Add(std::string_view text)
+{
+	const uint64_t length = text.size();
+	Add(&length, sizeof(length));
+	return Add(text.data(), text.size());
+}
+
+// Cache files
+
+struct DerivedDataHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint64_t KeyHigh;
+	uint64_t KeyLow;
+	uint64_t Size;
+	uint64_t Checksum;
+};
+
+static constexpr char DerivedDataMagic[4] = { 'S', 'C', 'D', 'D' };
+static constexpr uint32_t DerivedDataVersion = 1;
+
+static uint64_t Checksum(const void* data, size_t size)
+{
+	return SCHashBytes(data, size).Low;
+}
+
+SCDerivedDataCache::SCDerivedDataCache(std::string directory) : Directory(std::move(directory))
+{
+}
+
+std::string SCDerivedDataCache::PathFor(const SCDerivedDataKey& key) const
+{
+	const std::string hex = key.ToHex();
+	return Directory + "/" + hex.substr(0, 2) + "/" + hex;
+}
+
+bool SCDerivedDataCache::Get(const SCDerivedDataKey& key, std::vector<uint8_t>& data)
+{
+	if (!IsEnabled())
+		return false;
+
+	std::ifstream file(PathFor(key), std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		Misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+	file.seekg(0);
+
+	// The size is checked against the file before trusting it with an allocation.
+	DerivedDataHeader header;
+	bool ok = file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+		std::memcmp(header.Magic, DerivedDataMagic, sizeof(header.Magic)) == 0 && header.Version == DerivedDataVersion &&
+		header.KeyHigh == key.High && header.KeyLow == key.Low && header.Size == fileSize - sizeof(header);
+	if (ok)
+	{
+		data.resize(header.Size);
+		ok = file.read(reinterpret_cast<char*>(data.data()), data.size()) && Checksum(data.data(), data.size()) == header.Checksum;
+	}
+
+	if (!ok)
+	{
+		data.clear();
+		Rejected.fetch_add(1, std::memory_order_relaxed);
+		Misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	Hits.fetch_add(1, std::memory_order_relaxed);
+	BytesRead.fetch_add(data.size(), std::memory_order_relaxed);
+	return true;
+}
+
+bool SCDerivedDataCache::Put(const SCDerivedDataKey& key, std::span<const uint8_t> data)
+{
+	if (!IsEnabled())
+		return false;
+
+	namespace fs = std::filesystem;
+	const std::string path = PathFor(key);
+	// Unique per writer, including writers in other processes.
+	const uint64_t writer = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+		static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) * Prime1;
+	const std::string temp = path + "." + std::to_string(writer) + ".tmp";
+
+	std::error_code error;
+	fs::create_directories(fs::path(path).parent_path(), error);
+
+	DerivedDataHeader header;
+	std::memcpy(header.Magic, DerivedDataMagic, sizeof(header.Magic));
+	header.Version = DerivedDataVersion;
+	header.KeyHigh = key.High;
+	header.KeyLow = key.Low;
+	header.Size = data.size();
+	header.Checksum = Checksum(data.data(), data.size());
+
+	bool ok;
+	{
+		std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+		ok = file.write(reinterpret_cast<const char*>(&header), sizeof(header)) &&
+			file.write(reinterpret_cast<const char*>(data.data()), data.size());
+		file.close();
+		ok = ok && !file.fail();
+	}
+	if (ok)
+	{
+		fs::rename(temp, path, error); // replaces an existing file on every platform we build for
+		ok = !error;
+	}
+
+	if (!ok)
+	{
+		fs::remove(temp, error);
+		WriteFailures.fetch_add(1, std::memory_order_relaxed);
+		std::cerr << "[ENGINE][CACHE]: Could not write derived data to " << path << std::endl;
+		return false;
+	}
+	Writes.fetch_add(1, std::memory_order_relaxed);
+	BytesWritten.fetch_add(data.size(), std::memory_order_relaxed);
+	return true;
+}
+
+SCDerivedDataStats SCDerivedDataCache::GetStats() const
+{
+	SCDerivedDataStats stats;
+	stats.Hits = Hits.load(std::memory_order_relaxed);
+	stats.Misses = Misses.load(std::memory_order_relaxed);
+	stats.Rejected = Rejected.load(std::memory_order_relaxed);
+	stats.Writes = Writes.load(std::memory_order_relaxed);
+	stats.WriteFailures = WriteFailures.load(std::memory_order_relaxed);
+	stats.BytesRead = BytesRead.load(std::memory_order_relaxed);
+	stats.BytesWritten = BytesWritten.load(std::memory_order_relaxed);
+	return stats;
+}
+
+std::ostream& operator<<(std::ostream& stream, const SCDerivedDataStats& stats)
+{
+	return stream << "Derived data cache: " << stats.Hits << " hits, " << stats.Misses << " misses (" << stats.Rejected
+		<< " rejected), " << stats.Writes << " writes (" << stats.WriteFailures << " failed), " << stats.BytesRead
+		<< " bytes read, " << stats.BytesWritten << " bytes written\n";
+}
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+#include <Core/FileWatcher.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+struct SCFileWatcher::Root
+{
+	std::string Directory;
+	std::thread Thread;
+#ifdef _WIN32
+	HANDLE Handle = INVALID_HANDLE_VALUE;
+#else
+	int Fd = -1;
+	std::unordered_map<int, std::string> Directories; // by watch descriptor; only touched by Thread after Watch
+#endif
+};
+
+SCFileWatcher::SCFileWatcher(std::chrono::milliseconds debounce) : Debounce(debounce)
+{
+#ifdef _WIN32
+	StopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#else
+	StopFd = eventfd(0, EFD_CLOEXEC);
+#endif
+}
+
+SCFileWatcher::~SCFileWatcher()
+{
+	Stopping.store(true);
+#ifdef _WIN32
+	if (StopEvent)
+		SetEvent(StopEvent);
+#else
+	if (StopFd >= 0)
+	{
+		const uint64_t one = 1;
+		[[maybe_unused]] const ssize_t written = write(StopFd, &one, sizeof(one));
+	}
+#endif
+
+	for (std::unique_ptr<Root>& root : Roots)
+	{
+		if (root->Thread.joinable())
+			root->Thread.join();
+#ifdef _WIN32
+		CloseHandle(root->Handle);
+#else
+		close(root->Fd);
+#endif
+	}
+
+#ifdef _WIN32
+	if (StopEvent)
+		CloseHandle(StopEvent);
+#else
+	if (StopFd >= 0)
+		close(StopFd);
+#endif
+}
+
+void SCFileWatcher::Record(std::string path)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	const Clock::time_point now = Clock::now();
+	if (Pending.empty())
+		FirstChange = now;
+	LastChange = now;
+	Pending.push_back(std::move(path));
+}
+
+#ifdef _WIN32
+// True while some handle has the file open for writing. Files that are gone or otherwise can't be
+// opened are not held back; whoever reads them will find out.
+static bool IsBeingWritten(const std::string& path)
+{
+	const HANDLE file = CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return GetLastError() == ERROR_SHARING_VIOLATION;
+	CloseHandle(file);
+	return false;
+}
+#endif
+
+std::vector<std::string> SCFileWatcher::TakeChanges()
+{
+	std::vector<std::string> changes;
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		const Clock::time_point now = Clock::now();
+		if (Pending.empty() || (now - LastChange < Debounce && now - FirstChange < Debounce * MaxBatchDelay))
+			return changes;
+		changes.swap(Pending);
+	}
+	std::sort(changes.begin(), changes.end());
+	changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+#ifdef _WIN32
+	// ReadDirectoryChangesW reports writes as they happen rather than when the writer closes the
+	// file, so files still open for writing go back to wait for a later batch.
+	const auto busy = std::stable_partition(changes.begin(), changes.end(), [](const std::string& path) { return !IsBeingWritten(path); });
+	for (auto path = busy; path != changes.end(); ++path)
+		Record(std::move(*path));
+	changes.erase(busy, changes.end());
+#endif
+	return changes;
+}
+
+#ifdef _WIN32
+
+bool SCFileWatcher::Watch(const std::string& directory)
+{
+	if (!StopEvent)
+		return false;
+
+	auto root = std::make_unique<Root>();
+	root->Directory = directory;
+	root->Handle = CreateFileW(std::filesystem::path(directory).c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (root->Handle == INVALID_HANDLE_VALUE)
+	{
+		std::cerr << "[ENGINE][FILES]: Could not watch " << directory << std::endl;
+		return false;
+	}
+
+	Root& started = *Roots.emplace_back(std::move(root));
+	started.Thread = std::thread(&SCFileWatcher::Run, this, std::ref(started));
+	return true;
+}
+
+void SCFileWatcher::Run(Root& root)
+{
+	alignas(DWORD) BYTE buffer[64 * 1024];
+	OVERLAPPED overlapped = {};
+	overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	const HANDLE waits[2] = { overlapped.hEvent, static_cast<HANDLE>(StopEvent) };
+	const std::filesystem::path base(root.Directory);
+
+	while (!Stopping.load())
+	{
+		ResetEvent(overlapped.hEvent);
+		if (!ReadDirectoryChangesW(root.Handle, buffer, sizeof(buffer), TRUE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+			nullptr, &overlapped, nullptr))
+			break;
+
+		DWORD bytes = 0;
+		if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0)
+		{
+			CancelIoEx(root.Handle, &overlapped);
+			GetOverlappedResult(root.Handle, &overlapped, &bytes, TRUE);
+			break;
+		}
+		if (!GetOverlappedResult(root.Handle, &overlapped, &bytes, FALSE))
+			break;
+		if (bytes == 0)
+		{
+			std::cerr << "[ENGINE][FILES]: Change buffer overflowed for " << root.Directory << "; some changes were missed." << std::endl;
+			continue;
+		}
+
+		for (const BYTE* p = buffer;;)
+		{
+			const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p);
+			if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+			{
+				const std::filesystem::path name(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+				// Directories report modifications too when their contents change.
+				std::error_code error;
+				if (!std::filesystem::is_directory(base / name, error))
+					Record((base / name).generic_string());
+			}
+			if (info->NextEntryOffset == 0)
+				break;
+			p += info->NextEntryOffset;
+		}
+	}
+	CloseHandle(overlapped.hEvent);
+}
+
+#else
+
+static constexpr uint32_t WatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+static void AddWatches(int fd, const std::string& directory, std::unordered_map<int, std::string>& directories)
+{
+	const int wd = inotify_add_watch(fd, directory.c_str(), WatchMask | IN_ONLYDIR);
+	if (wd < 0)
+		return;
+	directories[wd] = directory;
+
+	std::error_code error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+		if (entry.is_directory(error) && !entry.is_symlink(error))
+			AddWatches(fd, entry.path().generic_string(), directories);
+}
+
+bool SCFileWatcher::Watch(const std::string& directory)
+{
+	if (StopFd < 0)
+		return false;
+
+	auto root = std::make_unique<Root>();
+	root->Directory = directory;
+	root->Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (root->Fd >= 0)
+		AddWatches(root->Fd, directory, root->Directories);
+	if (root->Directories.empty())
+	{
+		if (root->Fd >= 0)
+			close(root->Fd);
+		std::cerr << "[ENGINE][FILES]: Could not watch " << directory << std::endl;
+		return false;
+	}
+
+	Root& started = *Roots.emplace_back(std::move(root));
+	started.Thread = std::thread(&SCFileWatcher::Run, this, std::ref(started));
+	return true;
+}
+
+void SCFileWatcher::Run(Root& root)
+{
+	alignas(inotify_event) char buffer[16 * 1024];
+	while (!Stopping.load())
+	{
+		pollfd fds[2] = { { root.Fd, POLLIN, 0 }, { StopFd, POLLIN, 0 } };
+		if (poll(fds, 2, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		if (fds[1].revents != 0)
+			break;
+
+		const ssize_t size = read(root.Fd, buffer, sizeof(buffer));
+		for (ssize_t offset = 0; offset < size;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+				std::cerr << "[ENGINE][FILES]: Change queue overflowed for " << root.Directory << "; some changes were missed." << std::endl;
+			if (event->mask & IN_IGNORED)
+				root.Directories.erase(event->wd);
+
+			const auto directory = root.Directories.find(event->wd);
+			if (directory == root.Directories.end() || event->len == 0)
+				continue;
+			const std::string path = directory->second + "/" + event->name;
+
+			if (event->mask & IN_ISDIR)
+			{
+				// Files may land in a new directory before its watch exists; those only show up
+				// on their next write.
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					AddWatches(root.Fd, path, root.Directories);
+			}
+			else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+			{
+				Record(path);
+			}
+		}
+	}
+}
+
+#endif
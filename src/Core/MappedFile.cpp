@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <utility>
+#include <Core/MappedFile.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SCMappedFile::SCMappedFile(SCMappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+SCMappedFile& SCMappedFile::operator=(SCMappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		Data = std::exchange(other.Data, nullptr);
+		Size = std::exchange(other.Size, 0);
+#ifdef _WIN32
+		FileHandle = std::exchange(other.FileHandle, nullptr);
+		MappingHandle = std::exchange(other.MappingHandle, nullptr);
+#endif
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+
+bool SCMappedFile::Open(const std::string& path)
+{
+	Close();
+
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	FileHandle = file;
+	MappingHandle = mapping;
+	Data = static_cast<const uint8_t*>(view);
+	Size = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void SCMappedFile::Close()
+{
+	if (Data)
+		UnmapViewOfFile(Data);
+	if (MappingHandle)
+		CloseHandle(MappingHandle);
+	if (FileHandle)
+		CloseHandle(FileHandle);
+	Data = nullptr;
+	Size = 0;
+	FileHandle = nullptr;
+	MappingHandle = nullptr;
+}
+
+void SCMappedFile::Prefetch(size_t offset, size_t size) const
+{
+	if (!Data || offset >= Size)
+		return;
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = const_cast<uint8_t*>(Data + offset);
+	range.NumberOfBytes = std::min(size, Size - offset);
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+bool SCMappedFile::Open(const std::string& path)
+{
+	Close();
+
+	const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping keeps the file referenced
+	if (view == MAP_FAILED)
+		return false;
+
+	Data = static_cast<const uint8_t*>(view);
+	Size = static_cast<size_t>(info.st_size);
+	return true;
+}
+
+void SCMappedFile::Close()
+{
+	if (Data)
+		munmap(const_cast<uint8_t*>(Data), Size);
+	Data = nullptr;
+	Size = 0;
+}
+
+void SCMappedFile::Prefetch(size_t offset, size_t size) const
+{
+	if (!Data || offset >= Size)
+		return;
+	// madvise wants a page-aligned start.
+	const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	const size_t start = offset & ~(page - 1);
+	const size_t end = offset + std::min(size, Size - offset);
+	madvise(const_cast<uint8_t*>(Data + start), end - start, MADV_WILLNEED);
+}
+
+#endif
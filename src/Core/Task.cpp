@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <functional>
+#include <Core/Task.h>
+
+SCTaskScheduler* SCTaskScheduler::CurrentScheduler = nullptr;
+
+// Handle ring
+
+void SCTaskScheduler::HandleRing::Push(std::coroutine_handle<> handle)
+{
+	if (Count == Items.size())
+	{
+		std::vector<std::coroutine_handle<>> grown(std::max<size_t>(Items.size() * 2, 64));
+		for (size_t i = 0; i < Count; i++)
+			grown[i] = Items[(Head + i) & (Items.size() - 1)];
+		Items = std::move(grown);
+		Head = 0;
+	}
+	Items[(Head + Count) & (Items.size() - 1)] = handle;
+	Count++;
+}
+
+std::coroutine_handle<> SCTaskScheduler::HandleRing::Pop()
+{
+	std::coroutine_handle<> handle = Items[Head];
+	Head = (Head + 1) & (Items.size() - 1);
+	Count--;
+	return handle;
+}
+
+// Scheduler
+
+SCTaskScheduler::SCTaskScheduler(EventSystem& events, unsigned int workers)
+	: PreviousScheduler(CurrentScheduler), Events(events)
+{
+	CurrentScheduler = this;
+	for (unsigned int i = 0; i < workers; i++)
+		Workers.emplace_back(&SCTaskScheduler::WorkerLoop, this);
+}
+
+// Coroutines still suspended here are not resumed; their frames are left alone. Destroy the
+// scheduler after EventSystem::Halt so no dispatch is still inside OnEvent.
+SCTaskScheduler::~SCTaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(EventMutex);
+		for (EventHandlerId& id : EventHandlers)
+		{
+			if (id != 0)
+				Events.Unregister(id);
+			id = 0;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(WorkerMutex);
+		Stopping = true;
+	}
+	WorkerCondition.notify_all();
+	for (std::thread& worker : Workers)
+		worker.join();
+
+	if (CurrentScheduler == this)
+		CurrentScheduler = PreviousScheduler;
+}
+
+void SCTaskScheduler::ResumeOnFrame(std::coroutine_handle<> handle)
+{
+	std::lock_guard<std::mutex> lock(FrameMutex);
+	FrameReady.push_back(handle);
+}
+
+void SCTaskScheduler::ResumeOnWorker(std::coroutine_handle<> handle)
+{
+	if (Workers.empty())
+	{
+		ResumeOnFrame(handle);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(WorkerMutex);
+		WorkerReady.Push(handle);
+	}
+	WorkerCondition.notify_one();
+}
+
+void SCTaskScheduler::WaitFor(float seconds, std::coroutine_handle<> handle)
+{
+	std::lock_guard<std::mutex> lock(FrameMutex);
+	DelayHeap.push_back({ Clock + std::max(seconds, 0.0f), DelaySequence++, handle });
+	std::push_heap(DelayHeap.begin(), DelayHeap.end(), std::greater<Delayed>());
+}
+
+void SCTaskScheduler::WaitUntil(PollWaiter* waiter)
+{
+	std::lock_guard<std::mutex> lock(FrameMutex);
+	waiter->Next = Polling;
+	Polling = waiter;
+}
+
+void SCTaskScheduler::WaitForEvent(EventType type, EventWaiter* waiter)
+{
+	const size_t index = static_cast<size_t>(type);
+	if (index >= EventTypeCount)
+	{
+		ResumeOnFrame(waiter->Handle);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(EventMutex);
+	waiter->Next = EventWaiters[index];
+	EventWaiters[index] = waiter;
+	if (EventHandlers[index] == 0)
+		EventHandlers[index] = Events.Register(type, [this, type](const EventArgs& args) { OnEvent(type, args); });
+}
+
+// Runs on the dispatching thread. The args are only valid here, so each waiter copies what it
+// needs before its coroutine is queued for the frame thread.
+void SCTaskScheduler::OnEvent(EventType type, const EventArgs& args)
+{
+	EventWaiter* waiter;
+	{
+		std::lock_guard<std::mutex> lock(EventMutex);
+		waiter = std::exchange(EventWaiters[static_cast<size_t>(type)], nullptr);
+	}
+	if (!waiter)
+		return;
+
+	std::lock_guard<std::mutex> lock(FrameMutex);
+	while (waiter)
+	{
+		EventWaiter* next = waiter->Next;
+		if (waiter->Capture)
+			waiter->Capture(waiter, args);
+		FrameReady.push_back(waiter->Handle);
+		waiter = next;
+	}
+}
+
+void SCTaskScheduler::Tick(float deltaSeconds)
+{
+	{
+		std::lock_guard<std::mutex> lock(FrameMutex);
+		Clock += std::max(deltaSeconds, 0.0f);
+
+		while (!DelayHeap.empty() && DelayHeap.front().ResumeAt <= Clock)
+		{
+			std::pop_heap(DelayHeap.begin(), DelayHeap.end(), std::greater<Delayed>());
+			FrameReady.push_back(DelayHeap.back().Handle);
+			DelayHeap.pop_back();
+		}
+
+		for (PollWaiter** link = &Polling; *link;)
+		{
+			PollWaiter* waiter = *link;
+			if (waiter->Ready(waiter))
+			{
+				*link = waiter->Next;
+				FrameReady.push_back(waiter->Handle);
+			}
+			else
+			{
+				link = &waiter->Next;
+			}
+		}
+
+		// Both vectors keep their capacity; coroutines suspended again below land in FrameReady.
+		std::swap(FrameReady, FrameRunning);
+	}
+
+	for (std::coroutine_handle<> handle : FrameRunning)
+		handle.resume();
+	FrameRunning.clear();
+}
+
+void SCTaskScheduler::WorkerLoop()
+{
+	while (true)
+	{
+		std::coroutine_handle<> handle;
+		{
+			std::unique_lock<std::mutex> lock(WorkerMutex);
+			WorkerCondition.wait(lock, [this] { return Stopping || !WorkerReady.Empty(); });
+			if (WorkerReady.Empty())
+				return;
+			handle = WorkerReady.Pop();
+		}
+		handle.resume();
+	}
+}
@@ -0,0 +1,45 @@
+#include <Events/EventChannel.h>
+
+struct EventChannelRegistry
+{
+	std::mutex Mutex;
+	std::vector<EventChannelBase*> Channels;
+};
+
+static EventChannelRegistry& Registry()
+{
+	static EventChannelRegistry registry;
+	return registry;
+}
+
+void EventChannelBase::RegisterChannel(EventChannelBase* channel)
+{
+	EventChannelRegistry& registry = Registry();
+	std::lock_guard<std::mutex> lock(registry.Mutex);
+	registry.Channels.push_back(channel);
+}
+
+EventSubscriptionId EventChannelBase::NextSubscriptionId()
+{
+	static std::atomic<EventSubscriptionId> next{ 1 };
+	return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t EventChannelBase::FlushAll()
+{
+	EventChannelRegistry& registry = Registry();
+	size_t delivered = 0;
+	// Not holding the lock while flushing: a callback may be the first user of another channel.
+	for (size_t i = 0;; i++)
+	{
+		EventChannelBase* channel;
+		{
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+			if (i >= registry.Channels.size())
+				break;
+			channel = registry.Channels[i];
+		}
+		delivered += channel->FlushPending();
+	}
+	return delivered;
+}
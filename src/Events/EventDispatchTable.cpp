@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <iostream>
+#include <Events/EventSystem.h>
+
+// Handler ids carry the event type in the low bits so Remove doesn't have to search every list.
+static constexpr unsigned int HandlerTypeBits = 16;
+static constexpr EventHandlerId HandlerTypeMask = (EventHandlerId(1) << HandlerTypeBits) - 1;
+static_assert(EventTypeCount <= HandlerTypeMask, "EventType doesn't fit in a handler id");
+
+// Marks a dispatch in flight for the duration of a scope, so it is released even if a callback throws.
+struct DispatchReadGuard
+{
+	std::atomic<uint32_t>& Count;
+	explicit DispatchReadGuard(std::atomic<uint32_t>& count) : Count(count) { Count.fetch_add(1); }
+	~DispatchReadGuard() { Count.fetch_sub(1, std::memory_order_release); }
+};
+
+EventDispatchTable::EventDispatchTable(EventStats* stats)
+	: Stats(stats)
+{
+	for (auto& list : Lists)
+		list.store(nullptr, std::memory_order_relaxed);
+}
+
+EventDispatchTable::~EventDispatchTable()
+{
+	for (auto& list : Lists)
+		delete list.load(std::memory_order_relaxed);
+	for (const RetiredList& retired : Retired)
+		delete retired.List;
+}
+
+EventHandlerId EventDispatchTable::Add(EventType type, ECallback cb)
+{
+	const size_t index = static_cast<size_t>(type);
+	if (index >= EventTypeCount)
+	{
+		std::cerr << "[ENGINE][EVENTS]: Cannot register a handler for unknown event type " << index << std::endl;
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(WriteMutex);
+	const EventHandlerId id = (NextSerial++ << HandlerTypeBits) | index;
+
+	const HandlerList* current = Lists[index].load(std::memory_order_relaxed);
+	HandlerList* next = current ? new HandlerList(*current) : new HandlerList();
+	std::shared_ptr<EventStats::HandlerCounters> stats;
+	if constexpr (SCEventStatsPolicy::Enabled)
+		stats = std::make_shared<EventStats::HandlerCounters>();
+	next->push_back({ id, std::move(cb), std::move(stats) });
+	Publish(index, next);
+	return id;
+}
+
+bool EventDispatchTable::Remove(EventHandlerId id)
+{
+	const size_t index = static_cast<size_t>(id & HandlerTypeMask);
+	if (id == 0 || index >= EventTypeCount)
+		return false;
+
+	std::lock_guard<std::mutex> lock(WriteMutex);
+	const HandlerList* current = Lists[index].load(std::memory_order_relaxed);
+	if (!current)
+		return false;
+
+	auto it = std::find_if(current->begin(), current->end(), [id](const Handler& h) { return h.Id == id; });
+	if (it == current->end())
+		return false;
+
+	HandlerList* next = nullptr;
+	if (current->size() > 1)
+	{
+		next = new HandlerList();
+		next->reserve(current->size() - 1);
+		for (const Handler& handler : *current)
+			if (handler.Id != id)
+				next->push_back(handler);
+	}
+	Publish(index, next);
+	return true;
+}
+
+// Called with WriteMutex held.
+void EventDispatchTable::Publish(size_t index, const HandlerList* list)
+{
+	const HandlerList* old = Lists[index].exchange(list);
+	if (old)
+		Retired.push_back({ old, Epoch.load(std::memory_order_relaxed) });
+	Reclaim();
+}
+
+// Called with WriteMutex held. Never waits: the epoch only advances once every dispatch that
+// started in the previous epoch has left, and a list retired in epoch e is freed from e + 2 on,
+// when no dispatch from e - 1 or e can still hold it. Dispatches that start later load the
+// pointer after it was replaced (both sides use seq_cst), so they never see a retired list.
+void EventDispatchTable::Reclaim()
+{
+	uint64_t epoch = Epoch.load(std::memory_order_relaxed);
+	if (Readers[(epoch + 1) & 1].Count.load() == 0)
+		Epoch.store(++epoch);
+	if (Readers[(epoch + 1) & 1].Count.load() == 0)
+		Epoch.store(++epoch);
+
+	auto freed = std::remove_if(Retired.begin(), Retired.end(), [epoch](const RetiredList& retired)
+		{
+			if (retired.Epoch + 2 > epoch)
+				return false;
+			delete retired.List;
+			return true;
+		});
+	Retired.erase(freed, Retired.end());
+}
+
+void EventDispatchTable::Dispatch(const Event& event) const
+{
+	const size_t index = static_cast<size_t>(event.Type);
+	if (index >= EventTypeCount || !event.Args)
+		return;
+
+	DispatchReadGuard guard(Readers[Epoch.load(std::memory_order_relaxed) & 1].Count);
+
+	const HandlerList* list = Lists[index].load();
+
+	if constexpr (SCEventStatsPolicy::Enabled)
+	{
+		if (Stats)
+		{
+			const uint64_t start = SCEventClockNs();
+			uint64_t last = start;
+			if (list)
+			{
+				for (const Handler& handler : *list)
+				{
+					handler.Callback(*event.Args);
+					const uint64_t now = SCEventClockNs();
+					if (handler.Stats)
+						handler.Stats->CallTime.Record(now - last);
+					last = now;
+				}
+			}
+			Stats->RecordDispatch(event.Type, event.FireTime, start, last);
+			return;
+		}
+	}
+
+	if (!list)
+		return;
+	for (const Handler& handler : *list)
+		handler.Callback(*event.Args);
+}
+
+size_t EventDispatchTable::HandlerCount(EventType type) const
+{
+	const size_t index = static_cast<size_t>(type);
+	if (index >= EventTypeCount)
+		return 0;
+
+	DispatchReadGuard guard(Readers[Epoch.load(std::memory_order_relaxed) & 1].Count);
+	const HandlerList* list = Lists[index].load();
+	return list ? list->size() : 0;
+}
+
+void EventDispatchTable::ReadHandlerStats(std::vector<EventHandlerStatsSnapshot>& out) const
+{
+	DispatchReadGuard guard(Readers[Epoch.load(std::memory_order_relaxed) & 1].Count);
+	for (size_t i = 0; i < EventTypeCount; i++)
+	{
+		const HandlerList* list = Lists[i].load();
+		if (!list)
+			continue;
+		for (const Handler& handler : *list)
+		{
+			EventHandlerStatsSnapshot stats;
+			stats.Id = handler.Id;
+			stats.Type = static_cast<EventType>(i);
+			if (handler.Stats)
+				stats.CallTime = handler.Stats->CallTime.Read();
+			out.push_back(stats);
+		}
+	}
+}
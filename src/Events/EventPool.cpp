@@ -0,0 +1,127 @@
+#include <Events/EventSystem.h>
+
+// Free-list state for one thread. LocalFree is only touched by the owning thread; Returned is a
+// Treiber stack other threads push released slots onto, drained by the owner in one exchange.
+struct EventPoolThreadState
+{
+	Event* LocalFree = nullptr;
+	std::atomic<Event*> Returned{ nullptr };
+};
+
+static constexpr size_t EventPoolBlockSize = 64;
+
+struct EventPoolRegistry
+{
+	std::mutex Mutex;
+	std::vector<std::unique_ptr<EventPoolThreadState>> Pools;
+	std::vector<EventPoolThreadState*> Orphans;
+	std::vector<std::unique_ptr<Event[]>> Blocks;
+	std::atomic<size_t> SlotCount{ 0 };
+};
+
+static EventPoolRegistry& Registry()
+{
+	static EventPoolRegistry registry;
+	return registry;
+}
+
+struct EventPoolHandle
+{
+	EventPoolThreadState* Pool;
+
+	EventPoolHandle()
+	{
+		EventPoolRegistry& registry = Registry();
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+		if (!registry.Orphans.empty())
+		{
+			Pool = registry.Orphans.back();
+			registry.Orphans.pop_back();
+		}
+		else
+		{
+			registry.Pools.push_back(std::make_unique<EventPoolThreadState>());
+			Pool = registry.Pools.back().get();
+		}
+	}
+
+	~EventPoolHandle()
+	{
+		EventPoolRegistry& registry = Registry();
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+		registry.Orphans.push_back(Pool);
+	}
+};
+
+static EventPoolThreadState& LocalPool()
+{
+	thread_local EventPoolHandle handle;
+	return *handle.Pool;
+}
+
+void EventRecycler::operator()(Event* event) const
+{
+	EventPool::Release(event);
+}
+
+void EventPool::Grow(EventPoolThreadState& pool)
+{
+	std::unique_ptr<Event[]> block(new Event[EventPoolBlockSize]);
+	for (size_t i = 0; i < EventPoolBlockSize; i++)
+	{
+		block[i].Owner = &pool;
+		block[i].Next = pool.LocalFree;
+		pool.LocalFree = &block[i];
+	}
+
+	EventPoolRegistry& registry = Registry();
+	registry.SlotCount.fetch_add(EventPoolBlockSize, std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(registry.Mutex);
+	registry.Blocks.push_back(std::move(block));
+}
+
+EventPtr EventPool::Acquire(EventType type)
+{
+	EventPoolThreadState& pool = LocalPool();
+
+	if (!pool.LocalFree)
+		pool.LocalFree = pool.Returned.exchange(nullptr, std::memory_order_acquire);
+	if (!pool.LocalFree)
+		Grow(pool);
+
+	Event* event = pool.LocalFree;
+	pool.LocalFree = event->Next;
+	event->Next = nullptr;
+	event->Type = type;
+	return EventPtr(event);
+}
+
+void EventPool::Release(Event* event)
+{
+	if (!event)
+		return;
+
+	event->ResetArgs();
+	event->Type = EventType::EVENT_NONE;
+	event->OrderingKey = 0;
+	event->FireTime = 0;
+
+	EventPoolThreadState* owner = event->Owner;
+	if (owner == &LocalPool())
+	{
+		event->Next = owner->LocalFree;
+		owner->LocalFree = event;
+		return;
+	}
+
+	Event* head = owner->Returned.load(std::memory_order_relaxed);
+	do
+	{
+		event->Next = head;
+	} while (!owner->Returned.compare_exchange_weak(head, event, std::memory_order_release, std::memory_order_relaxed));
+}
+
+size_t EventPool::AllocatedSlots()
+{
+	return Registry().SlotCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <Events/EventStats.h>
+
+uint64_t SCEventClockNs()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static void AtomicMax(std::atomic<uint64_t>& target, uint64_t value)
+{
+	uint64_t current = target.load(std::memory_order_relaxed);
+	while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+	}
+}
+
+// Histogram
+
+void SCLatencyHistogram::Record(uint64_t ns)
+{
+	const size_t bucket = std::min<size_t>(std::bit_width(ns), BucketCount - 1);
+	Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	TotalNs.fetch_add(ns, std::memory_order_relaxed);
+	AtomicMax(MaxNs, ns);
+}
+
+SCLatencyHistogram::Snapshot SCLatencyHistogram::Read() const
+{
+	Snapshot snapshot;
+	for (size_t i = 0; i < BucketCount; i++)
+		snapshot.Buckets[i] = Buckets[i].load(std::memory_order_relaxed);
+	snapshot.Count = Count.load(std::memory_order_relaxed);
+	snapshot.TotalNs = TotalNs.load(std::memory_order_relaxed);
+	snapshot.MaxNs = MaxNs.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+uint64_t SCLatencyHistogram::Snapshot::PercentileNs(double percentile) const
+{
+	uint64_t total = 0;
+	for (uint64_t count : Buckets)
+		total += count;
+	if (total == 0)
+		return 0;
+
+	const double rank = std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(total);
+	uint64_t seen = 0;
+	for (size_t i = 0; i < BucketCount; i++)
+	{
+		seen += Buckets[i];
+		if (static_cast<double>(seen) >= rank && Buckets[i] != 0)
+			return std::min(i == 0 ? 0 : (uint64_t(1) << i) - 1, MaxNs);
+	}
+	return MaxNs;
+}
+
+// Counters
+
+EventStats::TypeCounters* EventStats::Counters(EventType type)
+{
+	const size_t index = static_cast<size_t>(type);
+	return index < EventTypeCount ? &Types[index] : nullptr;
+}
+
+void EventStats::RecordFired(EventType type)
+{
+	if (TypeCounters* counters = Counters(type))
+		counters->Fired.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventStats::RecordDispatch(EventType type, uint64_t fireTimeNs, uint64_t startNs, uint64_t endNs)
+{
+	TypeCounters* counters = Counters(type);
+	if (!counters)
+		return;
+	counters->Dispatched.fetch_add(1, std::memory_order_relaxed);
+	if (fireTimeNs != 0 && startNs >= fireTimeNs)
+		counters->QueueLatency.Record(startNs - fireTimeNs);
+	counters->DispatchTime.Record(endNs - startNs);
+}
+
+void EventStats::RecordQueueDepth(size_t depth)
+{
+	size_t current = MaxQueueDepth.load(std::memory_order_relaxed);
+	while (current < depth && !MaxQueueDepth.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+	}
+}
+
+void EventStats::Read(EventStatsSnapshot& snapshot) const
+{
+	snapshot.MaxQueueDepth = MaxQueueDepth.load(std::memory_order_relaxed);
+	snapshot.Types.clear();
+	for (size_t i = 0; i < EventTypeCount; i++)
+	{
+		EventTypeStatsSnapshot type;
+		type.Type = static_cast<EventType>(i);
+		type.Fired = Types[i].Fired.load(std::memory_order_relaxed);
+		type.Dispatched = Types[i].Dispatched.load(std::memory_order_relaxed);
+		if (type.Fired == 0 && type.Dispatched == 0)
+			continue;
+		type.QueueLatency = Types[i].QueueLatency.Read();
+		type.DispatchTime = Types[i].DispatchTime.Read();
+		snapshot.Types.push_back(type);
+	}
+}
+
+void EventStats::SetDumpInterval(double seconds)
+{
+	const uint64_t interval = seconds > 0 ? static_cast<uint64_t>(seconds * 1e9) : 0;
+	DumpIntervalNs.store(interval, std::memory_order_relaxed);
+	NextDumpNs.store(interval ? SCEventClockNs() + interval : 0, std::memory_order_relaxed);
+}
+
+bool EventStats::Due(uint64_t nowNs)
+{
+	const uint64_t interval = DumpIntervalNs.load(std::memory_order_relaxed);
+	uint64_t next = NextDumpNs.load(std::memory_order_relaxed);
+	if (interval == 0 || nowNs < next)
+		return false;
+	return NextDumpNs.compare_exchange_strong(next, nowNs + interval, std::memory_order_relaxed);
+}
+
+// Snapshot queries and dump
+
+const EventTypeStatsSnapshot* EventStatsSnapshot::FindType(EventType type) const
+{
+	for (const EventTypeStatsSnapshot& stats : Types)
+		if (stats.Type == type)
+			return &stats;
+	return nullptr;
+}
+
+const EventHandlerStatsSnapshot* EventStatsSnapshot::FindHandler(EventHandlerId id) const
+{
+	for (const EventHandlerStatsSnapshot& stats : Handlers)
+		if (stats.Id == id)
+			return &stats;
+	return nullptr;
+}
+
+static const char* EventTypeName(EventType type)
+{
+	switch (type)
+	{
+	case EventType::EVENT_NONE: return "EVENT_NONE";
+	case EventType::ERROR_EVENT: return "ERROR_EVENT";
+	case EventType::APP_PROC_START: return "APP_PROC_START";
+	case EventType::APP_PROC_STOP: return "APP_PROC_STOP";
+	case EventType::APP_RENDER_LOOP: return "APP_RENDER_LOOP";
+	default: return "?";
+	}
+}
+
+static double ToMicroseconds(uint64_t ns)
+{
+	return static_cast<double>(ns) / 1000.0;
+}
+
+std::ostream& operator<<(std::ostream& os, const EventStatsSnapshot& stats)
+{
+	if (!stats.Enabled)
+		return os << "[ENGINE][EVENTS]: Event stats are compiled out (SC_EVENT_STATS=0)" << std::endl;
+
+	const std::ios::fmtflags flags = os.flags();
+	const std::streamsize precision = os.precision();
+	os << std::fixed << std::setprecision(1);
+
+	os << "[ENGINE][EVENTS]: Queue depth " << stats.QueueDepth << "/" << stats.QueueCapacity
+		<< ", max " << stats.MaxQueueDepth << ", dropped " << stats.Dropped << std::endl;
+
+	os << "  " << std::left << std::setw(18) << "type" << std::right
+		<< std::setw(10) << "fired" << std::setw(10) << "handled"
+		<< std::setw(12) << "wait p50" << std::setw(12) << "wait p99" << std::setw(12) << "wait max"
+		<< std::setw(12) << "run mean" << std::setw(12) << "run max" << "  (us)" << std::endl;
+	for (const EventTypeStatsSnapshot& type : stats.Types)
+	{
+		os << "  " << std::left << std::setw(18) << EventTypeName(type.Type) << std::right
+			<< std::setw(10) << type.Fired << std::setw(10) << type.Dispatched
+			<< std::setw(12) << ToMicroseconds(type.QueueLatency.PercentileNs(50))
+			<< std::setw(12) << ToMicroseconds(type.QueueLatency.PercentileNs(99))
+			<< std::setw(12) << ToMicroseconds(type.QueueLatency.MaxNs)
+			<< std::setw(12) << type.DispatchTime.MeanNs() / 1000.0
+			<< std::setw(12) << ToMicroseconds(type.DispatchTime.MaxNs) << std::endl;
+	}
+
+	if (!stats.Handlers.empty())
+	{
+		os << "  " << std::left << std::setw(18) << "handler" << std::setw(18) << "type" << std::right
+			<< std::setw(10) << "calls" << std::setw(12) << "mean" << std::setw(12) << "p99"
+			<< std::setw(12) << "max" << std::setw(14) << "total ms" << std::endl;
+		for (const EventHandlerStatsSnapshot& handler : stats.Handlers)
+		{
+			os << "  " << std::left << std::setw(18) << handler.Id << std::setw(18) << EventTypeName(handler.Type) << std::right
+				<< std::setw(10) << handler.CallTime.Count
+				<< std::setw(12) << handler.CallTime.MeanNs() / 1000.0
+				<< std::setw(12) << ToMicroseconds(handler.CallTime.PercentileNs(99))
+				<< std::setw(12) << ToMicroseconds(handler.CallTime.MaxNs)
+				<< std::setw(14) << static_cast<double>(handler.CallTime.TotalNs) / 1e6 << std::endl;
+		}
+	}
+
+	os.flags(flags);
+	os.precision(precision);
+	return os;
+}
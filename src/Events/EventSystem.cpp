@@ -1,64 +1,448 @@
+#include <algorithm>
 #include <Events/EventSystem.h>
-#include <Events/EventArgs.h>
+#include <Events/EventTimers.h>
 
-std::map<EventType, std::vector<ECallback>> EventSystem::EventCallbacks;
+static size_t RoundUpPow2(size_t value)
+{
+	size_t result = 2;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
 
-void EventQueue::PushEvent(std::unique_ptr<Event> event)
+EventQueue::EventQueue(const EventQueueSettings& settings)
+	: Mask(RoundUpPow2(settings.Capacity) - 1), Policy(settings.Policy)
 {
-	std::lock_guard<std::mutex> lock(mutex_);
-	queue_.push(std::move(event));
-	condition_.notify_one();
+	Slots = std::make_unique<Slot[]>(Mask + 1);
+	for (size_t i = 0; i <= Mask; i++)
+	{
+		Slots[i].Sequence.store(i, std::memory_order_relaxed);
+		Slots[i].Value = nullptr;
+	}
 }
 
-std::unique_ptr<Event> EventQueue::PopEvent()
+EventQueue::~EventQueue()
 {
-	std::unique_lock<std::mutex> lock(mutex_);
-	condition_.wait(lock, [this] { return !queue_.empty(); });
+	while (Event* event = TryDequeue())
+		EventRecycler()(event);
+	for (Event* event : Spilled)
+		EventRecycler()(event);
+	for (Event* event : Overflow)
+		EventRecycler()(event);
+}
+
+bool EventQueue::TryEnqueue(Event* event)
+{
+	size_t pos = EnqueuePos.load(std::memory_order_relaxed);
+	Slot* slot;
+	for (;;)
+	{
+		slot = &Slots[pos & Mask];
+		const size_t seq = slot->Sequence.load(std::memory_order_acquire);
+		const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+		if (diff == 0)
+		{
+			if (EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			return false; // full
+		}
+		else
+		{
+			pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->Value = event;
+	slot->Sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+Event* EventQueue::TryDequeue()
+{
+	const size_t pos = DequeuePos.load(std::memory_order_relaxed);
+	Slot& slot = Slots[pos & Mask];
+	const size_t seq = slot.Sequence.load(std::memory_order_acquire);
+	if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0)
+		return nullptr; // empty, or the producer has claimed the slot but not published yet
+
+	Event* event = slot.Value;
+	slot.Sequence.store(pos + Mask + 1, std::memory_order_release);
+	DequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+	if (Policy == EventBackpressure::Block)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (ProducersWaiting.load(std::memory_order_relaxed) != 0)
+		{
+			SpaceSignal.fetch_add(1, std::memory_order_release);
+			SpaceSignal.notify_all();
+		}
+	}
 
-	auto event = std::move(queue_.front());
-	queue_.pop();
 	return event;
 }
 
-void EventSystem::Register(EventType type, ECallback cb)
+void EventQueue::WakeConsumer()
+{
+	// Pairs with the fence in PopEvent: either we see the consumer waiting, or it sees our event.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (ConsumerWaiting.load(std::memory_order_relaxed))
+	{
+		ConsumerSignal.fetch_add(1, std::memory_order_release);
+		ConsumerSignal.notify_one();
+	}
+}
+
+bool EventQueue::PushEvent(EventPtr event)
+{
+	if (!event)
+		return false;
+
+	if (Closed.load(std::memory_order_acquire))
+	{
+		Dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Event* raw = event.release();
+	bool spill = Policy == EventBackpressure::Grow && Overflowing.load(std::memory_order_acquire);
+
+	while (!spill && !TryEnqueue(raw))
+	{
+		switch (Policy)
+		{
+		case EventBackpressure::Drop:
+			EventRecycler()(raw);
+			Dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+
+		case EventBackpressure::Grow:
+			spill = true;
+			break;
+
+		case EventBackpressure::Block:
+		{
+			const uint32_t key = SpaceSignal.load(std::memory_order_acquire);
+			ProducersWaiting.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			const bool pushed = TryEnqueue(raw);
+			if (!pushed && !Closed.load(std::memory_order_acquire))
+				SpaceSignal.wait(key, std::memory_order_acquire);
+
+			ProducersWaiting.fetch_sub(1, std::memory_order_relaxed);
+			if (pushed)
+			{
+				WakeConsumer();
+				return true;
+			}
+
+			if (Closed.load(std::memory_order_acquire))
+			{
+				EventRecycler()(raw);
+				Dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
+		break;
+		}
+	}
+
+	if (spill)
+	{
+		std::lock_guard<std::mutex> lock(OverflowMutex);
+		Overflow.push_back(raw);
+		Overflowing.store(true, std::memory_order_release);
+	}
+
+	WakeConsumer();
+	return true;
+}
+
+EventPtr EventQueue::TryPopEvent()
+{
+	for (;;)
+	{
+		// Ring entries claimed before the last spill was taken are older than everything in Spilled.
+		if (DequeuePos.load(std::memory_order_relaxed) < SpillBarrier)
+		{
+			if (Event* event = TryDequeue())
+				return EventPtr(event);
+			std::this_thread::yield(); // claimed but not yet published
+			continue;
+		}
+
+		if (!Spilled.empty())
+		{
+			Event* event = Spilled.front();
+			Spilled.pop_front();
+			return EventPtr(event);
+		}
+
+		if (Event* event = TryDequeue())
+			return EventPtr(event);
+
+		if (!Overflowing.load(std::memory_order_acquire))
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(OverflowMutex);
+		SpillBarrier = EnqueuePos.load(std::memory_order_relaxed);
+		Spilled.swap(Overflow);
+		Overflowing.store(false, std::memory_order_release);
+	}
+}
+
+EventPtr EventQueue::PopEvent()
+{
+	for (;;)
+	{
+		if (auto event = TryPopEvent())
+			return event;
+
+		if (Closed.load(std::memory_order_acquire))
+			return TryPopEvent();
+
+		const uint32_t key = ConsumerSignal.load(std::memory_order_acquire);
+		ConsumerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (auto event = TryPopEvent())
+		{
+			ConsumerWaiting.store(false, std::memory_order_relaxed);
+			return event;
+		}
+
+		if (!Closed.load(std::memory_order_acquire))
+			ConsumerSignal.wait(key, std::memory_order_acquire);
+		ConsumerWaiting.store(false, std::memory_order_relaxed);
+	}
+}
+
+void EventQueue::Close()
+{
+	Closed.store(true, std::memory_order_release);
+	ConsumerSignal.fetch_add(1, std::memory_order_release);
+	ConsumerSignal.notify_all();
+	SpaceSignal.fetch_add(1, std::memory_order_release);
+	SpaceSignal.notify_all();
+}
+
+size_t EventQueue::ApproximateSize() const
+{
+	const size_t enqueued = EnqueuePos.load(std::memory_order_relaxed);
+	const size_t dequeued = DequeuePos.load(std::memory_order_relaxed);
+	return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+// In Deferred mode nothing drains the queue until the next Flush, so a producer blocked on a full
+// ring would wait out the frame, and the main thread would wait forever. Spill instead.
+static EventQueueSettings ResolveQueueSettings(EventQueueSettings queueSettings, const EventDispatchSettings& dispatchSettings)
+{
+	if (dispatchSettings.Mode == EventDispatchMode::Deferred && queueSettings.Policy == EventBackpressure::Block)
+		queueSettings.Policy = EventBackpressure::Grow;
+	return queueSettings;
+}
+
+static constexpr size_t NoDeferredEvent = SIZE_MAX;
+
+EventSystem::EventSystem(const EventQueueSettings& queueSettings, const EventDispatchSettings& dispatchSettings)
+	: Dispatcher(&Stats), DispatchSettings(dispatchSettings), Queue(ResolveQueueSettings(queueSettings, dispatchSettings)),
+	Timers(std::make_unique<EventTimerWheel>())
 {
-	std::lock_guard<std::mutex> lock(mutex_);
-	EventCallbacks[type].push_back(std::move(cb));
+	LatestByType.fill(NoDeferredEvent);
+	if (DispatchSettings.Mode == EventDispatchMode::Deferred)
+		DeferredBatch.reserve(Queue.Capacity());
+}
+
+EventSystem::~EventSystem() = default;
+
+void EventSystem::SetCoalescing(EventType type, bool coalesce)
+{
+	const size_t index = static_cast<size_t>(type);
+	if (index < EventTypeCount)
+		Coalescing[index].store(coalesce, std::memory_order_relaxed);
+}
+
+EventHandlerId EventSystem::Register(EventType type, ECallback cb)
+{
+	return Dispatcher.Add(type, std::move(cb));
+}
+
+bool EventSystem::Unregister(EventHandlerId id)
+{
+	return Dispatcher.Remove(id);
 }
 
 void EventSystem::Launch()
 {
-	HandlerThread = std::thread(EventSystem::EventHandler, std::ref(Queue));
+	if (DispatchSettings.Mode == EventDispatchMode::Deferred)
+		return; // dispatched by Flush on the caller's thread
+
+	if (DispatchSettings.Mode == EventDispatchMode::WorkerPool)
+	{
+		unsigned int workers = DispatchSettings.Workers;
+		if (workers == 0)
+			workers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+		WorkerPool = std::make_unique<EventWorkerPool>(Dispatcher, Queue.Capacity());
+		WorkerPool->Start(workers);
+	}
+	HandlerThread = std::thread(&EventSystem::EventHandler, this);
 }
 
-void EventSystem::FireEvent(std::unique_ptr<Event> event)
+void EventSystem::FireEvent(EventPtr event)
 {
+	if constexpr (SCEventStatsPolicy::Enabled)
+	{
+		if (event)
+		{
+			event->FireTime = SCEventClockNs();
+			Stats.RecordFired(event->Type);
+		}
+	}
 	Queue.PushEvent(std::move(event));
 }
 
+EventTimerId EventSystem::FireEventAfter(float delaySeconds, EventPtr event)
+{
+	return Timers->Schedule(delaySeconds, std::move(event));
+}
+
+EventTimerId EventSystem::FireEventEvery(float intervalSeconds, float durationSeconds, std::function<EventPtr()> make)
+{
+	return Timers->ScheduleRepeating(intervalSeconds, durationSeconds, std::move(make));
+}
+
+bool EventSystem::CancelTimer(EventTimerId id)
+{
+	return Timers->Cancel(id);
+}
+
+void EventSystem::AdvanceTimers(float deltaSeconds)
+{
+	Timers->Advance(deltaSeconds, DueTimers);
+	for (EventPtr& event : DueTimers)
+		FireEvent(std::move(event));
+	DueTimers.clear();
+}
+
+EventStatsSnapshot EventSystem::GetStats() const
+{
+	EventStatsSnapshot snapshot;
+	if constexpr (SCEventStatsPolicy::Enabled)
+	{
+		Stats.Read(snapshot);
+		Dispatcher.ReadHandlerStats(snapshot.Handlers);
+	}
+	snapshot.QueueCapacity = Queue.Capacity();
+	snapshot.QueueDepth = Queue.ApproximateSize();
+	snapshot.Dropped = Queue.DroppedCount();
+	return snapshot;
+}
+
+void EventSystem::DumpStats(std::ostream& os) const
+{
+	os << GetStats();
+}
+
+void EventSystem::SetStatsDumpInterval(double seconds)
+{
+	Stats.SetDumpInterval(seconds);
+}
+
+// Called by whichever thread drains the queue.
+void EventSystem::PollStats()
+{
+	if constexpr (SCEventStatsPolicy::Enabled)
+	{
+		Stats.RecordQueueDepth(Queue.ApproximateSize());
+		if (Stats.Due(SCEventClockNs()))
+			DumpStats(std::cout);
+	}
+}
+
 void EventSystem::Halt()
 {
 	running = false;
-	Queue.PushEvent(nullptr); // to unblock the thread if waiting
+	Queue.Close(); // to unblock the thread if waiting; queued events are still handled
 	if (HandlerThread.joinable()) {
 		HandlerThread.join();
 	}
+	if (WorkerPool) {
+		WorkerPool->Stop();
+		WorkerPool.reset();
+	}
+	while (Flush() > 0) {
+	}
+}
+
+void EventSystem::CoalesceInto(EventPtr event)
+{
+	const size_t index = static_cast<size_t>(event->Type);
+	if (index >= EventTypeCount || !Coalescing[index].load(std::memory_order_relaxed))
+	{
+		DeferredBatch.push_back(std::move(event));
+		return;
+	}
+
+	size_t& latest = event->OrderingKey == 0 ? LatestByType[index] : LatestByKey[index].try_emplace(event->OrderingKey, NoDeferredEvent).first->second;
+	if (latest != NoDeferredEvent)
+		DeferredBatch[latest].reset(); // superseded; the slot goes straight back to its pool
+	latest = DeferredBatch.size();
+	DeferredBatch.push_back(std::move(event));
+}
+
+size_t EventSystem::Flush()
+{
+	if (DispatchSettings.Mode != EventDispatchMode::Deferred || Flushing)
+		return 0;
+	Flushing = true;
+	PollStats();
+
+	// Bounded so producers that keep firing during the drain can't hold the frame; anything
+	// beyond the bound is picked up by the next Flush.
+	const size_t limit = Queue.ApproximateSize() + Queue.Capacity();
+	for (size_t i = 0; i < limit; i++)
+	{
+		EventPtr event = Queue.TryPopEvent();
+		if (!event)
+			break;
+		CoalesceInto(std::move(event));
+	}
+
+	size_t dispatched = 0;
+	for (EventPtr& event : DeferredBatch)
+	{
+		if (!event)
+			continue;
+		Dispatcher.Dispatch(*event);
+		event.reset();
+		dispatched++;
+	}
+
+	DeferredBatch.clear();
+	LatestByType.fill(NoDeferredEvent);
+	for (auto& latest : LatestByKey)
+		latest.clear();
+	Flushing = false;
+	return dispatched;
 }
 
-void EventSystem::EventHandler(EventQueue& queue)
+void EventSystem::EventHandler()
 {
 	while (true)
 	{
-		auto event = queue.PopEvent();
-		if (event == nullptr) { // handle shutdown signal
+		auto event = Queue.PopEvent();
+		if (event == nullptr) { // queue closed and drained
 			break;
 		}
 
-		auto callbacksIt = EventCallbacks.find(event->Type);
-		if (callbacksIt != EventCallbacks.end()) {
-			for (const auto& callback : callbacksIt->second) {
-				callback(*event->Args);
-			}
-		}
+		PollStats();
+		if (WorkerPool)
+			WorkerPool->Submit(std::move(event));
+		else
+			Dispatcher.Dispatch(*event);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include <cmath>
+#include <Events/EventTimers.h>
+
+static constexpr uint64_t MaxTimerTicks = (uint64_t(1) << 32) - 1;
+
+EventTimerWheel::EventTimerWheel()
+{
+	Heads.fill(NoNode);
+}
+
+uint64_t EventTimerWheel::ToTicks(float seconds)
+{
+	if (!(seconds > 0))
+		return 0;
+	const double ticks = std::ceil(static_cast<double>(seconds) / TickSeconds);
+	return ticks >= static_cast<double>(MaxTimerTicks) ? MaxTimerTicks : static_cast<uint64_t>(ticks);
+}
+
+uint32_t EventTimerWheel::AllocateNode()
+{
+	if (FreeList != NoNode)
+	{
+		const uint32_t index = FreeList;
+		FreeList = Nodes[index].Next;
+		Nodes[index].Next = NoNode;
+		return index;
+	}
+	Nodes.emplace_back();
+	return static_cast<uint32_t>(Nodes.size() - 1);
+}
+
+void EventTimerWheel::FreeNode(uint32_t index)
+{
+	Node& node = Nodes[index];
+	node.Event.reset();
+	node.Make = nullptr;
+	node.Interval = 0;
+	node.End = 0;
+	node.List = NoNode;
+	node.Prev = NoNode;
+	if (++node.Generation == 0) // ids are never 0
+		node.Generation = 1;
+	node.Next = FreeList;
+	FreeList = index;
+	Pending--;
+}
+
+void EventTimerWheel::Link(uint32_t index, uint32_t list)
+{
+	Node& node = Nodes[index];
+	if (list != EveryAdvanceList)
+		OnWheel++;
+	node.List = list;
+	node.Prev = NoNode;
+	node.Next = Heads[list];
+	if (node.Next != NoNode)
+		Nodes[node.Next].Prev = index;
+	Heads[list] = index;
+}
+
+void EventTimerWheel::Unlink(uint32_t index)
+{
+	Node& node = Nodes[index];
+	if (node.List != EveryAdvanceList)
+		OnWheel--;
+	if (node.Prev != NoNode)
+		Nodes[node.Prev].Next = node.Next;
+	else
+		Heads[node.List] = node.Next;
+	if (node.Next != NoNode)
+		Nodes[node.Next].Prev = node.Prev;
+	node.Prev = node.Next = node.List = NoNode;
+}
+
+// Level l holds timers due in [256^l, 256^(l+1)) ticks, in the slot picked by the expiry's l-th
+// byte. That slot is cascaded to a finer level when the clock's lower bytes wrap to it, which is
+// never later than the expiry.
+void EventTimerWheel::Insert(uint32_t index)
+{
+	Node& node = Nodes[index];
+	uint64_t delta = node.Expiry - CurrentTick;
+	if (delta > MaxTimerTicks)
+	{
+		node.Expiry = CurrentTick + MaxTimerTicks;
+		delta = MaxTimerTicks;
+	}
+
+	uint32_t level = 0;
+	while (level + 1 < Levels && delta >= (uint64_t(1) << (LevelBits * (level + 1))))
+		level++;
+	const uint32_t slot = static_cast<uint32_t>(node.Expiry >> (LevelBits * level)) & (SlotsPerLevel - 1);
+	Link(index, level * SlotsPerLevel + slot);
+}
+
+// Empties a list and returns its first node; the nodes keep their Next links.
+uint32_t EventTimerWheel::Detach(uint32_t list)
+{
+	const uint32_t head = Heads[list];
+	Heads[list] = NoNode;
+	if (list != EveryAdvanceList)
+		for (uint32_t index = head; index != NoNode; index = Nodes[index].Next)
+			OnWheel--;
+	return head;
+}
+
+void EventTimerWheel::Cascade(uint32_t level)
+{
+	const uint32_t slot = static_cast<uint32_t>(CurrentTick >> (LevelBits * level)) & (SlotsPerLevel - 1);
+	uint32_t index = Detach(level * SlotsPerLevel + slot);
+	while (index != NoNode)
+	{
+		const uint32_t next = Nodes[index].Next;
+		Insert(index);
+		index = next;
+	}
+}
+
+void EventTimerWheel::FireNode(uint32_t index, std::vector<EventPtr>& due)
+{
+	Node& node = Nodes[index];
+	if (!node.Make)
+	{
+		due.push_back(std::move(node.Event));
+		FreeNode(index);
+		return;
+	}
+
+	if (node.End != 0 && CurrentTick > node.End)
+	{
+		FreeNode(index);
+		return;
+	}
+	if (EventPtr event = node.Make())
+		due.push_back(std::move(event));
+
+	if (node.Interval == 0)
+	{
+		Link(index, EveryAdvanceList);
+		return;
+	}
+	node.Expiry = CurrentTick + node.Interval;
+	if (node.End != 0 && node.Expiry > node.End)
+	{
+		FreeNode(index);
+		return;
+	}
+	Insert(index);
+}
+
+// The list is detached first: repeating timers may link themselves back into it.
+void EventTimerWheel::Expire(uint32_t list, std::vector<EventPtr>& due)
+{
+	uint32_t index = Detach(list);
+	while (index != NoNode)
+	{
+		const uint32_t next = Nodes[index].Next;
+		Nodes[index].Prev = Nodes[index].Next = Nodes[index].List = NoNode;
+		FireNode(index, due);
+		index = next;
+	}
+}
+
+EventTimerId EventTimerWheel::Schedule(float delaySeconds, EventPtr event)
+{
+	if (!event)
+		return 0;
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	const uint32_t index = AllocateNode();
+	Node& node = Nodes[index];
+	node.Event = std::move(event);
+	node.Expiry = CurrentTick + std::max<uint64_t>(ToTicks(delaySeconds), 1);
+	Insert(index);
+	Pending++;
+	return (static_cast<EventTimerId>(node.Generation) << 32) | index;
+}
+
+EventTimerId EventTimerWheel::ScheduleRepeating(float intervalSeconds, float durationSeconds, std::function<EventPtr()> make)
+{
+	if (!make)
+		return 0;
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	const uint32_t index = AllocateNode();
+	Node& node = Nodes[index];
+	node.Make = std::move(make);
+	node.Interval = ToTicks(intervalSeconds);
+	node.End = durationSeconds > 0 ? CurrentTick + std::max<uint64_t>(ToTicks(durationSeconds), 1) : 0;
+	if (node.Interval == 0)
+	{
+		Link(index, EveryAdvanceList);
+	}
+	else
+	{
+		node.Expiry = CurrentTick + node.Interval;
+		Insert(index);
+	}
+	Pending++;
+	return (static_cast<EventTimerId>(node.Generation) << 32) | index;
+}
+
+bool EventTimerWheel::Cancel(EventTimerId id)
+{
+	const uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFF);
+	const uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+	std::lock_guard<std::mutex> lock(Mutex);
+	if (index >= Nodes.size() || Nodes[index].Generation != generation || Nodes[index].List == NoNode)
+		return false;
+	Unlink(index);
+	FreeNode(index);
+	return true;
+}
+
+void EventTimerWheel::Advance(float deltaSeconds, std::vector<EventPtr>& due)
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	if (deltaSeconds > 0)
+		Accumulated += deltaSeconds;
+	uint64_t ticks = static_cast<uint64_t>(Accumulated / TickSeconds);
+	Accumulated -= static_cast<double>(ticks) * TickSeconds;
+
+	// Nothing on the wheel itself: just move the clock.
+	if (OnWheel == 0)
+	{
+		CurrentTick += ticks;
+		ticks = 0;
+	}
+
+	for (; ticks > 0; ticks--)
+	{
+		CurrentTick++;
+		if ((CurrentTick & (SlotsPerLevel - 1)) == 0)
+		{
+			if (((CurrentTick >> LevelBits) & (SlotsPerLevel - 1)) == 0)
+			{
+				if (((CurrentTick >> (2 * LevelBits)) & (SlotsPerLevel - 1)) == 0)
+					Cascade(3);
+				Cascade(2);
+			}
+			Cascade(1);
+		}
+		Expire(static_cast<uint32_t>(CurrentTick & (SlotsPerLevel - 1)), due);
+	}
+
+	Expire(EveryAdvanceList, due);
+}
+
+size_t EventTimerWheel::PendingCount() const
+{
+	std::lock_guard<std::mutex> lock(Mutex);
+	return Pending;
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <Events/EventSystem.h>
+
+// Events a worker handles from one strand before putting it at the back of the ready queue, so a
+// busy domain can't starve the others.
+static constexpr size_t StrandBatchSize = 32;
+// Idle keyed strands are freed once this many exist.
+static constexpr size_t KeyedStrandPruneThreshold = 1024;
+
+EventWorkerPool::EventWorkerPool(const EventDispatchTable& dispatcher, size_t maxInFlight)
+	: Dispatcher(dispatcher),
+	MaxInFlight(static_cast<uint32_t>(std::clamp<size_t>(maxInFlight, 1, UINT32_MAX))),
+	PruneThreshold(KeyedStrandPruneThreshold)
+{
+}
+
+EventWorkerPool::~EventWorkerPool()
+{
+	Stop();
+}
+
+void EventWorkerPool::Start(unsigned int workers)
+{
+	{
+		std::lock_guard<std::mutex> lock(ReadyMutex);
+		Stopping = false;
+	}
+	for (unsigned int i = 0; i < std::max(workers, 1u); i++)
+		Workers.emplace_back(&EventWorkerPool::WorkerLoop, this);
+}
+
+void EventWorkerPool::Stop()
+{
+	uint32_t inFlight;
+	while ((inFlight = InFlight.load(std::memory_order_acquire)) != 0)
+		InFlight.wait(inFlight, std::memory_order_acquire);
+
+	{
+		std::lock_guard<std::mutex> lock(ReadyMutex);
+		Stopping = true;
+	}
+	ReadyCondition.notify_all();
+	for (std::thread& worker : Workers)
+		worker.join();
+	Workers.clear();
+}
+
+EventWorkerPool::Strand& EventWorkerPool::StrandFor(const Event& event)
+{
+	if (event.OrderingKey == 0)
+	{
+		const size_t index = static_cast<size_t>(event.Type);
+		return TypeStrands[index < EventTypeCount ? index : 0];
+	}
+
+	if (KeyedStrands.size() >= PruneThreshold)
+		PruneKeyedStrands();
+
+	std::unique_ptr<Strand>& strand = KeyedStrands[event.OrderingKey];
+	if (!strand)
+		strand = std::make_unique<Strand>();
+	return *strand;
+}
+
+// Only the handler thread schedules strands, so one that isn't scheduled is not referenced by any
+// worker and stays that way until the next Submit. Taking its mutex makes sure the worker that
+// unscheduled it has let go.
+void EventWorkerPool::PruneKeyedStrands()
+{
+	for (auto it = KeyedStrands.begin(); it != KeyedStrands.end();)
+	{
+		bool idle;
+		{
+			std::lock_guard<std::mutex> lock(it->second->Mutex);
+			idle = !it->second->Scheduled;
+		}
+		it = idle ? KeyedStrands.erase(it) : std::next(it);
+	}
+	PruneThreshold = std::max(KeyedStrandPruneThreshold, KeyedStrands.size() * 2);
+}
+
+void EventWorkerPool::Submit(EventPtr event)
+{
+	if (!event)
+		return;
+
+	uint32_t inFlight = InFlight.load(std::memory_order_relaxed);
+	while (inFlight >= MaxInFlight)
+	{
+		InFlight.wait(inFlight, std::memory_order_relaxed);
+		inFlight = InFlight.load(std::memory_order_relaxed);
+	}
+	InFlight.fetch_add(1, std::memory_order_relaxed);
+
+	Strand& strand = StrandFor(*event);
+	Event* raw = event.release();
+	bool schedule;
+	{
+		std::lock_guard<std::mutex> lock(strand.Mutex);
+		if (strand.Tail)
+			strand.Tail->Next = raw;
+		else
+			strand.Head = raw;
+		strand.Tail = raw;
+		schedule = !strand.Scheduled;
+		strand.Scheduled = true;
+	}
+
+	if (schedule)
+		Schedule(&strand);
+}
+
+void EventWorkerPool::Schedule(Strand* strand)
+{
+	{
+		std::lock_guard<std::mutex> lock(ReadyMutex);
+		Ready.push_back(strand);
+	}
+	ReadyCondition.notify_one();
+}
+
+void EventWorkerPool::WorkerLoop()
+{
+	while (true)
+	{
+		Strand* strand;
+		{
+			std::unique_lock<std::mutex> lock(ReadyMutex);
+			ReadyCondition.wait(lock, [this] { return Stopping || !Ready.empty(); });
+			if (Ready.empty())
+				return;
+			strand = Ready.front();
+			Ready.pop_front();
+		}
+
+		bool drained = false;
+		for (size_t i = 0; i < StrandBatchSize && !drained; i++)
+		{
+			Event* raw;
+			{
+				std::lock_guard<std::mutex> lock(strand->Mutex);
+				raw = strand->Head;
+				if (raw)
+				{
+					strand->Head = raw->Next;
+					if (!strand->Head)
+						strand->Tail = nullptr;
+					raw->Next = nullptr;
+				}
+				else
+				{
+					strand->Scheduled = false; // strand may be freed by the handler thread from here on
+					drained = true;
+				}
+			}
+			if (!raw)
+				break;
+
+			EventPtr event(raw);
+			Dispatcher.Dispatch(*event);
+			event.reset();
+
+			// Wake the handler thread if it is waiting for room (Submit) or for the pool to drain (Stop).
+			const uint32_t before = InFlight.fetch_sub(1, std::memory_order_acq_rel);
+			if (before == MaxInFlight || before == 1)
+				InFlight.notify_all();
+		}
+
+		if (!drained)
+			Schedule(strand);
+	}
+}
@@ -1,36 +1,36 @@
 #include <Graphics/Camera.h>
 
-glm::mat4 Camera3D::ComputeProjectionMatrix(float aspectRatio)
+SCMatrix4f Camera3D::ComputeProjectionMatrix(float aspectRatio)
 {
-	return glm::perspectiveFovLH<float>(glm::radians(45.0f), 800, 600, 0.1f, 100.0f);
+	return SCMatrix4f::PerspectiveFovRH(FOV, aspectRatio, 0.1f, 100.0f);
 }
 
-glm::mat4 Camera3D::ComputeViewMatrix()
+SCMatrix4f Camera3D::ComputeViewMatrix()
 {
-	return glm::lookAt(glm::vec3(Position), glm::vec3(Target), glm::vec3(Up));
+	return SCMatrix4f::LookAtRH(Position, Target, Up);
 }
 
-glm::mat4 Camera3D::ComputeProjectionViewMatrix(float aspectRatio)
+SCMatrix4f Camera3D::ComputeProjectionViewMatrix(float aspectRatio)
 {
-	return ComputeProjectionMatrix(aspectRatio) * ComputeViewMatrix();
+	return ComputeViewMatrix() * ComputeProjectionMatrix(aspectRatio);
 }
 
-XMMATRIX DXCamera3D::ComputeProjectionMatrix(float aspectRatio)
+SCMatrix4f DXCamera3D::ComputeProjectionMatrix(float aspectRatio)
 {
-	return XMMatrixPerspectiveFovLH(glm::radians(45.0f), aspectRatio, 0.1f, 100.0f);
+	return SCMatrix4f::PerspectiveFovLH(FOV, aspectRatio, 0.1f, 100.0f);
 }
 
-XMMATRIX DXCamera3D::ComputeViewMatrix()
+SCMatrix4f DXCamera3D::ComputeViewMatrix()
 {
-	return XMMatrixLookAtLH(XMLoadFloat3(&Position), XMLoadFloat3(&Target), XMLoadFloat3(&Up));
+	return SCMatrix4f::LookAtLH(Position, Target, Up);
 }
 
-XMMATRIX DXCamera3D::ComputeProjectionViewMatrix(float aspectRatio)
+SCMatrix4f DXCamera3D::ComputeProjectionViewMatrix(float aspectRatio)
 {
-	return XMMatrixMultiply(ComputeProjectionMatrix(aspectRatio), ComputeViewMatrix());
+	return ComputeViewMatrix() * ComputeProjectionMatrix(aspectRatio);
 }
 
-XMMATRIX DXCamera3D::ComputeMVPMatrix(float aspectRatio, XMMATRIX world)
+SCMatrix4f DXCamera3D::ComputeMVPMatrix(float aspectRatio, const SCMatrix4f& world)
 {
 	return world * ComputeViewMatrix() * ComputeProjectionMatrix(aspectRatio);
 }
\ No newline at end of file
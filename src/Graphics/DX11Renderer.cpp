@@ -1,4 +1,5 @@
 #include <Graphics/DX11/DX11Renderer.h>
+#include <algorithm>
 #include <SDL3/SDL.h>
 
 bool DX11Renderer::Initialize(Window* window)
@@ -113,14 +114,52 @@ bool DX11Renderer::CreateIndexBuffer(const void* indexData, UINT indexSize, UINT
     return true;
 }
 
-std::shared_ptr<DX11Mesh> DX11Renderer::CreateMesh(std::vector<SCVertex>& vertices, std::vector<unsigned int>& indices, std::shared_ptr<SCMaterial> material)
+bool DX11Renderer::CreateMeshVertexBuffer(DX11Mesh& mesh, std::span<const SCVertex> vertices)
 {
-    ComPtr<ID3D11Buffer> vertexBuffer;
-    ComPtr<ID3D11Buffer> indexBuffer;
+    mesh.VertexStride = SCVertexStride(mesh.VertexFormat);
 
-    CreateVertexBuffer(vertices.data(), sizeof(SCVertex), vertices.size(), vertexBuffer);
-    CreateIndexBuffer(indices.data(), sizeof(unsigned int), indices.size(), indexBuffer);
+    if (mesh.VertexFormat == SCVertexFormat::Standard)
+    {
+        return CreateVertexBuffer(vertices.data(), sizeof(SCVertex), vertices.size(), mesh.VertexBuffer);
+    }
+
+    SCEncodedVertices encoded = SCEncodeVertices(vertices, mesh.VertexFormat);
+    if (mesh.VertexFormat == SCVertexFormat::CompactQuantized)
+    {
+        mesh.QuantizationBuffer = CreateConstantBuffer(encoded.Quantization);
+    }
+
+    return CreateVertexBuffer(encoded.Data.data(), encoded.Stride(), encoded.Count, mesh.VertexBuffer);
+}
+
+bool DX11Renderer::CreateIndexBuffer(SCIndexSpan indices, Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer)
+{
+    return CreateIndexBuffer(indices.GetData(), SCIndexSize(indices.GetFormat()), static_cast<UINT>(indices.Size()), buffer);
+}
+
+bool DX11Renderer::CreateMeshIndexBuffer(DX11Mesh& mesh, SCIndexSpan indices, size_t vertexCount)
+{
+    mesh.IndexFormat = SCChooseIndexFormat(vertexCount);
+    mesh.IndexCount = static_cast<UINT>(indices.Size());
+
+    if (indices.GetFormat() == mesh.IndexFormat)
+    {
+        return CreateIndexBuffer(indices, mesh.IndexBuffer);
+    }
 
+    // Only narrows: 16-bit input always fits, so it is never widened.
+    if (mesh.IndexFormat == SCIndexFormat::UInt32)
+    {
+        mesh.IndexFormat = SCIndexFormat::UInt16;
+        return CreateIndexBuffer(indices, mesh.IndexBuffer);
+    }
+
+    SCEncodedIndices encoded = SCEncodeIndices(indices, mesh.IndexFormat);
+    return CreateIndexBuffer(encoded.Span(), mesh.IndexBuffer);
+}
+
+std::shared_ptr<DX11Mesh> DX11Renderer::CreateMesh(std::vector<SCVertex>& vertices, std::vector<unsigned int>& indices, std::shared_ptr<SCMaterial> material, std::span<const SCMeshLod> lods, SCVertexFormat format)
+{
     std::shared_ptr<DX11Material> derivedMaterial = std::dynamic_pointer_cast<DX11Material>(material);
 
     if (!derivedMaterial)
@@ -129,55 +168,102 @@ std::shared_ptr<DX11Mesh> DX11Renderer::CreateMesh(std::vector<SCVertex>& vertic
         return nullptr;
     }
 
+    if (derivedMaterial->Shader && derivedMaterial->Shader->VertexFormat != format)
+    {
+        std::cerr << "[ENGINE][RND/DX11]: Mesh vertex format does not match the material's shader." << std::endl;
+    }
+
     // Create DX11Mesh with ComPtr objects
-    auto mesh = std::make_shared<DX11Mesh>(vertexBuffer, indexBuffer, derivedMaterial);
+    auto mesh = std::make_shared<DX11Mesh>(nullptr, nullptr, derivedMaterial);
     mesh->Indices = indices;
     mesh->Vertices = vertices;
+    mesh->Lods.assign(lods.begin(), lods.end());
+    mesh->VertexFormat = format;
+    if (!CreateMeshIndexBuffer(*mesh, mesh->Indices, mesh->Vertices.size())
+        || !CreateMeshVertexBuffer(*mesh, mesh->Vertices))
+    {
+        return nullptr;
+    }
 
     std::cout << mesh->IndexBuffer.Get() << std::endl;
 
     return mesh;
 }
 
-std::shared_ptr<DX11Shader> DX11Renderer::CreateShader(const wchar_t* vsPath, const wchar_t* psPath)
+std::shared_ptr<DX11Mesh> DX11Renderer::CreateMesh(std::span<const SCVertex> vertices, SCIndexSpan indices, std::span<const SCMeshLod> lods, SCVertexFormat format)
+{
+    auto mesh = std::make_shared<DX11Mesh>(nullptr, nullptr, nullptr);
+    mesh->Lods.assign(lods.begin(), lods.end());
+    mesh->VertexFormat = format;
+
+    if (!CreateMeshIndexBuffer(*mesh, indices, vertices.size())
+        || !CreateMeshVertexBuffer(*mesh, vertices))
+    {
+        return nullptr;
+    }
+
+    return mesh;
+}
+
+std::shared_ptr<DX11Shader> DX11Renderer::CreateShader(const wchar_t* vsPath, const wchar_t* psPath, SCVertexFormat format)
 {
     std::shared_ptr<DX11Shader> shader = std::make_shared<DX11Shader>();
-    shader->Initialize(this->d3dDevice.Get(), vsPath, psPath);
+    shader->Initialize(this->d3dDevice.Get(), vsPath, psPath, format, shaderCache);
     return shader;
 }
 
-std::shared_ptr<DX11Shader> DX11Renderer::CreateShader(const wchar_t* shPath)
+std::shared_ptr<DX11Shader> DX11Renderer::CreateShader(const wchar_t* shPath, SCVertexFormat format)
 {
     std::shared_ptr<DX11Shader> shader = std::make_shared<DX11Shader>();
-    shader->Initialize(this->d3dDevice.Get(), shPath);
+    shader->Initialize(this->d3dDevice.Get(), shPath, format, shaderCache);
+    return shader;
+}
+
+std::shared_ptr<DX11Shader> DX11Renderer::CreateShader(ID3DBlob* vsBlob, ID3DBlob* psBlob, SCVertexFormat format)
+{
+    std::shared_ptr<DX11Shader> shader = std::make_shared<DX11Shader>();
+    shader->Initialize(this->d3dDevice.Get(), vsBlob, psBlob, format);
     return shader;
 }
 
 void DX11Renderer::UploadMesh(std::shared_ptr<DX11Mesh> mesh)
 {
-    CreateVertexBuffer(mesh->Vertices.data(), sizeof(SCVertex), mesh->Vertices.size(), mesh->VertexBuffer);
-    CreateIndexBuffer(mesh->Indices.data(), sizeof(unsigned int), mesh->Indices.size(), mesh->IndexBuffer);
+    CreateMeshVertexBuffer(*mesh, mesh->Vertices);
+    CreateMeshIndexBuffer(*mesh, mesh->Indices, mesh->Vertices.size());
 
     std::cout << "Uploaded mesh" << std::endl;
 }
 
 void DX11Renderer::DrawMesh(const std::weak_ptr<Mesh>& mesh)
+{
+    DrawMesh(mesh, 0);
+}
+
+void DX11Renderer::DrawMesh(const std::weak_ptr<Mesh>& mesh, size_t lod)
 {
     auto dx11Mesh = std::dynamic_pointer_cast<DX11Mesh>(mesh.lock());
     if (!dx11Mesh) {
         std::cerr << "Invalid mesh for DX11Renderer" << std::endl;
         return;
     }
+    if (!dx11Mesh->Material) {
+        std::cerr << "[ENGINE][RND/DX11]: Mesh has no material." << std::endl;
+        return;
+    }
 
     //std::cout << dx11Mesh.get() << std::endl;
 
-    BindBuffer(DX11BufferType::VERTEX, dx11Mesh->VertexBuffer);
-    BindBuffer(DX11BufferType::INDEX, dx11Mesh->IndexBuffer);
+    BindBuffer(DX11BufferType::VERTEX, dx11Mesh->VertexBuffer, dx11Mesh->VertexStride);
+    BindIndexBuffer(dx11Mesh->IndexBuffer, dx11Mesh->IndexFormat);
 
     if (dx11Mesh->Material->ConstantBuffer) {
         this->d3dContext->VSSetConstantBuffers(0, 1, dx11Mesh->Material->ConstantBuffer->GetBuffer().GetAddressOf());
     }
 
+    if (dx11Mesh->QuantizationBuffer) {
+        this->d3dContext->VSSetConstantBuffers(1, 1, dx11Mesh->QuantizationBuffer->GetBuffer().GetAddressOf());
+    }
+
     this->d3dContext->IASetInputLayout(dx11Mesh->Material->Shader->inputLayout.Get());
 
     this->d3dContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -185,7 +271,14 @@ void DX11Renderer::DrawMesh(const std::weak_ptr<Mesh>& mesh)
     this->d3dContext->VSSetShader(dx11Mesh->Material->Shader->vertexShader.Get(), nullptr, 0);
     this->d3dContext->PSSetShader(dx11Mesh->Material->Shader->pixelShader.Get(), nullptr, 0);
 
-    this->d3dContext->DrawIndexed(dx11Mesh->Indices.size(), 0, 0);
+    if (dx11Mesh->Lods.empty())
+    {
+        this->d3dContext->DrawIndexed(dx11Mesh->IndexCount, 0, 0);
+        return;
+    }
+
+    const SCMeshLod& level = dx11Mesh->Lods[std::min(lod, dx11Mesh->Lods.size() - 1)];
+    this->d3dContext->DrawIndexed(level.IndexCount, level.IndexOffset, 0);
 }
 
 std::shared_ptr<SCMaterial> DX11Renderer::CreateMaterial(std::shared_ptr<SCMaterialSpec> spec)
@@ -203,7 +296,7 @@ std::shared_ptr<SCMaterial> DX11Renderer::CreateMaterial(std::shared_ptr<SCMater
     return material;
 }
 
-void DX11Renderer::BindBuffer(DX11BufferType bufferType, Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer)
+void DX11Renderer::BindBuffer(DX11BufferType bufferType, Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer, UINT stride)
 {
     if (!buffer) {
         std::cerr << "Index buffer is not initialized!" << std::endl;
@@ -214,14 +307,13 @@ void DX11Renderer::BindBuffer(DX11BufferType bufferType, Microsoft::WRL::ComPtr<
     {
     case DX11BufferType::VERTEX:
     {
-        UINT stride = sizeof(SCVertex);
         UINT offset = 0;
         d3dContext->IASetVertexBuffers(0, 1, buffer.GetAddressOf(), &stride, &offset);
     }
     break;
 
     case DX11BufferType::INDEX:
-        d3dContext->IASetIndexBuffer(buffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+        std::cerr << "[ENGINE][RND/DX11]: Index buffers need their format, bind them with BindIndexBuffer." << std::endl;
         break;
 
     case DX11BufferType::CONSTANT:
@@ -234,6 +326,16 @@ void DX11Renderer::BindBuffer(DX11BufferType bufferType, Microsoft::WRL::ComPtr<
     }
 }
 
+void DX11Renderer::BindIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer, SCIndexFormat format)
+{
+    if (!buffer) {
+        std::cerr << "Index buffer is not initialized!" << std::endl;
+        return;
+    }
+
+    d3dContext->IASetIndexBuffer(buffer.Get(), format == SCIndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
+}
+
 
 
 void DX11Renderer::BeginFrame(SCVector2i size)
@@ -1,16 +1,64 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <Graphics/DX11/DX11Shader.h>
 
-bool DX11Shader::Initialize(ID3D11Device* device, const wchar_t* vsPath, const wchar_t* psPath)
+// Input layout and shader defines for each SCVertexFormat. basic.hlsl switches its VS_INPUT on these.
+static DXGI_FORMAT PositionFormat(SCVertexFormat format)
 {
-    ID3DBlob* vsBlob = nullptr;
-    ID3DBlob* psBlob = nullptr;
+    return format == SCVertexFormat::CompactQuantized ? DXGI_FORMAT_R16G16B16A16_UNORM : DXGI_FORMAT_R32G32B32_FLOAT;
+}
+
+static DXGI_FORMAT NormalFormat(SCVertexFormat format)
+{
+    return format == SCVertexFormat::Standard ? DXGI_FORMAT_R32G32B32_FLOAT : DXGI_FORMAT_R16G16_SNORM;
+}
+
+static DXGI_FORMAT TexCoordFormat(SCVertexFormat format)
+{
+    return format == SCVertexFormat::Standard ? DXGI_FORMAT_R32G32_FLOAT : DXGI_FORMAT_R16G16_FLOAT;
+}
+
+static const D3D_SHADER_MACRO* ShaderDefines(SCVertexFormat format)
+{
+    static const D3D_SHADER_MACRO compact[] = { { "SC_VERTEX_COMPACT", "1" }, { nullptr, nullptr } };
+    static const D3D_SHADER_MACRO quantized[] = { { "SC_VERTEX_COMPACT", "1" }, { "SC_VERTEX_QUANTIZED", "1" }, { nullptr, nullptr } };
 
-    if (!CompileShaderFromFile(vsPath, "VS_Main", "vs_5_0", &vsBlob) ||
-        !CompileShaderFromFile(psPath, "PS_Main", "ps_5_0", &psBlob))
+    switch (format)
+    {
+    case SCVertexFormat::Compact: return compact;
+    case SCVertexFormat::CompactQuantized: return quantized;
+    default: return nullptr;
+    }
+}
+
+bool DX11Shader::Initialize(ID3D11Device* device, const wchar_t* vsPath, const wchar_t* psPath, SCVertexFormat format, SCDerivedDataCache* cache)
+{
+    ComPtr<ID3DBlob> vsBlob;
+    ComPtr<ID3DBlob> psBlob;
+
+    if (!CompileShaderFromFile(vsPath, "VS_Main", "vs_5_0", ShaderDefines(format), cache, vsBlob) ||
+        !CompileShaderFromFile(psPath, "PS_Main", "ps_5_0", ShaderDefines(format), cache, psBlob))
     {
         return false;
     }
 
+    return Initialize(device, vsBlob.Get(), psBlob.Get(), format);
+}
+
+bool DX11Shader::Initialize(ID3D11Device* device, const wchar_t* shPath, SCVertexFormat format, SCDerivedDataCache* cache)
+{
+    return Initialize(device, shPath, shPath, format, cache);
+}
+
+bool DX11Shader::Initialize(ID3D11Device* device, ID3DBlob* vsBlob, ID3DBlob* psBlob, SCVertexFormat format)
+{
+    if (!vsBlob || !psBlob)
+        return false;
+    VertexFormat = format;
+
     HRESULT hr = device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, &vertexShader);
     if (FAILED(hr)) { std::cerr << "Failed to create vertex shader." << std::endl; return false; }
 
@@ -18,52 +66,118 @@ bool DX11Shader::Initialize(ID3D11Device* device, const wchar_t* vsPath, const w
     if (FAILED(hr)) { std::cerr << "Failed to create pixel shader." << std::endl; return false; }
 
     const D3D11_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+        { "POSITION", 0, PositionFormat(format), 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "NORMAL", 0, NormalFormat(format), 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD", 0, TexCoordFormat(format), 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 }
     };
 
     hr = device->CreateInputLayout(layout, ARRAYSIZE(layout), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &inputLayout);
     if (FAILED(hr)) { std::cerr << "Failed to create input layout." << std::endl; return false; }
 
-    vsBlob->Release();
-    psBlob->Release();
-
     return true;
 }
 
-bool DX11Shader::Initialize(ID3D11Device* device, const wchar_t* shPath)
+static UINT CompileFlags()
 {
-    ID3DBlob* vsBlob = nullptr;
-    ID3DBlob* psBlob = nullptr;
+    UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#if defined(DEBUG) || defined(_DEBUG)
+    flags |= D3DCOMPILE_DEBUG;
+#endif
+    return flags;
+}
+
+static bool CheckCompileResult(HRESULT hr, ID3DBlob* errorBlob)
+{
+    if (FAILED(hr) && errorBlob)
+        std::cerr << "Shader compilation error: " << static_cast<char*>(errorBlob->GetBufferPointer()) << std::endl;
+    if (errorBlob)
+        errorBlob->Release();
+    return SUCCEEDED(hr);
+}
 
-    if (!CompileShaderFromFile(shPath, "VS_Main", "vs_5_0", &vsBlob) ||
-        !CompileShaderFromFile(shPath, "PS_Main", "ps_5_0", &psBlob))
+// Adds the files named by the preprocessor's #line markers, unescaping their backslashes.
+static void CollectSourceFiles(ID3DBlob* preprocessed, std::vector<std::string>& files)
+{
+    const std::string_view text(static_cast<const char*>(preprocessed->GetBufferPointer()), preprocessed->GetBufferSize());
+    for (size_t line = text.find("#line"); line != std::string_view::npos; line = text.find("#line", line + 5))
     {
-        return false;
+        size_t i = text.find_first_of("\"\n", line);
+        if (i == std::string_view::npos || text[i] != '"')
+            continue;
+        std::string file;
+        for (i++; i < text.size() && text[i] != '"' && text[i] != '\n'; i++)
+        {
+            if (text[i] == '\\' && i + 1 < text.size())
+                i++;
+            file.push_back(text[i]);
+        }
+        if (!file.empty() && std::find(files.begin(), files.end(), file) == files.end())
+            files.push_back(std::move(file));
     }
+}
 
-    HRESULT hr = device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, &vertexShader);
-    if (FAILED(hr)) { std::cerr << "Failed to create vertex shader." << std::endl; return false; }
-
-    hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &pixelShader);
-    if (FAILED(hr)) { std::cerr << "Failed to create pixel shader." << std::endl; return false; }
-
-    const D3D11_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 }
-    };
+// One stage. With a cache (or when the source files are wanted) the source is preprocessed
+// first, which is cheap next to compiling, and the key covers the result, so edits to included
+// files or defines miss as they should.
+static bool CompileStage(const std::string& source, const char* sourceName, const D3D_SHADER_MACRO* defines,
+    const char* entryPoint, const char* shaderModel, SCDerivedDataCache* cache, std::vector<std::string>* sourceFiles, ID3DInclude* include, ComPtr<ID3DBlob>& blob)
+{
+    if (!include)
+        include = D3D_COMPILE_STANDARD_FILE_INCLUDE;
+    ID3DBlob* errorBlob = nullptr;
+    const bool cached = cache && cache->IsEnabled();
+    if (!cached && !sourceFiles)
+    {
+        HRESULT hr = D3DCompile(source.data(), source.size(), sourceName, defines, include,
+            entryPoint, shaderModel, CompileFlags(), 0, blob.ReleaseAndGetAddressOf(), &errorBlob);
+        return CheckCompileResult(hr, errorBlob);
+    }
 
-    hr = device->CreateInputLayout(layout, ARRAYSIZE(layout), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &inputLayout);
-    if (FAILED(hr)) { std::cerr << "Failed to create input layout." << std::endl; return false; }
+    ComPtr<ID3DBlob> preprocessed;
+    HRESULT hr = D3DPreprocess(source.data(), source.size(), sourceName, defines, include,
+        preprocessed.GetAddressOf(), &errorBlob);
+    if (!CheckCompileResult(hr, errorBlob))
+        return false;
+    if (sourceFiles)
+        CollectSourceFiles(preprocessed.Get(), *sourceFiles);
 
-    vsBlob->Release();
-    psBlob->Release();
+    // The preprocessed text keeps #line markers, so errors still point into the original files.
+    auto compile = [&]()
+        {
+            errorBlob = nullptr;
+            hr = D3DCompile(preprocessed->GetBufferPointer(), preprocessed->GetBufferSize(), sourceName, nullptr, nullptr,
+                entryPoint, shaderModel, CompileFlags(), 0, blob.ReleaseAndGetAddressOf(), &errorBlob);
+            return CheckCompileResult(hr, errorBlob);
+        };
+    if (!cached)
+        return compile();
+
+    const SCDerivedDataKey key = SCDerivedDataKeyBuilder("DX11Shader", DX11Shader::CacheVersion)
+        .Add(preprocessed->GetBufferPointer(), preprocessed->GetBufferSize())
+        .Add(std::string_view(entryPoint)).Add(std::string_view(shaderModel))
+        .Add(CompileFlags()).Add(static_cast<uint32_t>(D3D_COMPILER_VERSION))
+        .Finish();
+
+    std::vector<uint8_t> bytecode;
+    if (cache->Get(key, bytecode) && SUCCEEDED(D3DCreateBlob(bytecode.size(), blob.ReleaseAndGetAddressOf())))
+    {
+        std::memcpy(blob->GetBufferPointer(), bytecode.data(), bytecode.size());
+        return true;
+    }
 
+    if (!compile())
+        return false;
+    cache->Put(key, std::span<const uint8_t>(static_cast<const uint8_t*>(blob->GetBufferPointer()), blob->GetBufferSize()));
     return true;
 }
 
+bool DX11Shader::CompileSource(const std::string& source, const char* sourceName, SCVertexFormat format, ComPtr<ID3DBlob>& vsBlob, ComPtr<ID3DBlob>& psBlob,
+    SCDerivedDataCache* cache, std::vector<std::string>* sourceFiles, ID3DInclude* include)
+{
+    return CompileStage(source, sourceName, ShaderDefines(format), "VS_Main", "vs_5_0", cache, sourceFiles, include, vsBlob) &&
+        CompileStage(source, sourceName, ShaderDefines(format), "PS_Main", "ps_5_0", cache, sourceFiles, include, psBlob);
+}
+
 void DX11Shader::SetShaders(ID3D11DeviceContext* context)
 {
     context->IASetInputLayout(inputLayout.Get());
@@ -71,26 +185,17 @@ void DX11Shader::SetShaders(ID3D11DeviceContext* context)
     context->PSSetShader(pixelShader.Get(), nullptr, 0);
 }
 
-bool DX11Shader::CompileShaderFromFile(const wchar_t* fileName, const char* entryPoint, const char* shaderModel, ID3DBlob** blob)
+bool DX11Shader::CompileShaderFromFile(const wchar_t* fileName, const char* entryPoint, const char* shaderModel, const D3D_SHADER_MACRO* defines, SCDerivedDataCache* cache, ComPtr<ID3DBlob>& blob)
 {
-    UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
-#if defined(DEBUG) || defined(_DEBUG)
-    flags |= D3DCOMPILE_DEBUG;
-#endif
-
-    ID3DBlob* errorBlob = nullptr;
-    HRESULT hr = D3DCompileFromFile(fileName, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryPoint, shaderModel,
-        flags, 0, blob, &errorBlob);
-    if (FAILED(hr))
+    const std::filesystem::path path(fileName);
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
     {
-        if (errorBlob)
-        {
-            std::cerr << "Shader compilation error: " << static_cast<char*>(errorBlob->GetBufferPointer()) << std::endl;
-            errorBlob->Release();
-        }
+        std::cerr << "Could not open shader file " << path.string() << std::endl;
         return false;
     }
+    std::stringstream source;
+    source << file.rdbuf();
 
-    if (errorBlob) errorBlob->Release();
-    return true;
-}
\ No newline at end of file
+    return CompileStage(source.str(), path.string().c_str(), defines, entryPoint, shaderModel, cache, nullptr, nullptr, blob);
+}
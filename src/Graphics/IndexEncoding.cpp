@@ -0,0 +1,49 @@
+#include <cstring>
+#include <limits>
+#include <Graphics/IndexEncoding.h>
+
+unsigned int SCIndexSize(SCIndexFormat format)
+{
+	return format == SCIndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+SCIndexFormat SCChooseIndexFormat(size_t vertexCount)
+{
+	return vertexCount <= std::numeric_limits<uint16_t>::max() ? SCIndexFormat::UInt16 : SCIndexFormat::UInt32;
+}
+
+SCEncodedIndices SCEncodeIndices(SCIndexSpan indices, SCIndexFormat format)
+{
+	SCEncodedIndices encoded;
+	encoded.Format = format;
+	encoded.Count = indices.Size();
+	encoded.Data.resize(encoded.Count * SCIndexSize(format));
+
+	if (indices.GetFormat() == format)
+	{
+		std::memcpy(encoded.Data.data(), indices.GetData(), encoded.Data.size());
+	}
+	else if (format == SCIndexFormat::UInt16)
+	{
+		const uint32_t* source = static_cast<const uint32_t*>(indices.GetData());
+		uint16_t* target = reinterpret_cast<uint16_t*>(encoded.Data.data());
+		for (size_t i = 0; i < encoded.Count; i++)
+			target[i] = static_cast<uint16_t>(source[i]);
+	}
+	else
+	{
+		const uint16_t* source = static_cast<const uint16_t*>(indices.GetData());
+		uint32_t* target = reinterpret_cast<uint32_t*>(encoded.Data.data());
+		for (size_t i = 0; i < encoded.Count; i++)
+			target[i] = source[i];
+	}
+	return encoded;
+}
+
+std::vector<unsigned int> SCDecodeIndices(SCIndexSpan indices)
+{
+	std::vector<unsigned int> decoded(indices.Size());
+	for (size_t i = 0; i < decoded.size(); i++)
+		decoded[i] = indices[i];
+	return decoded;
+}
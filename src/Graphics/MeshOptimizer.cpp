@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <Core/IdMap.h>
+#include <Graphics/MeshOptimizer.h>
+
+// FIFO cache simulation by timestamps: a vertex is in the cache if fewer than cacheSize misses
+// have happened since it was loaded. Starting the clock past cacheSize makes every zeroed stamp a
+// miss, and advancing it by cacheSize + 1 flushes the cache without touching the stamps.
+class FifoCache
+{
+public:
+	FifoCache(size_t vertexCount, unsigned int cacheSize) : Stamps(vertexCount, 0), Size(cacheSize), Time(cacheSize + 1) {}
+
+	unsigned int Triangle(const unsigned int* triangle) { return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]); }
+	void Flush() { Time += Size + 1; }
+
+private:
+	unsigned int Access(unsigned int vertex)
+	{
+		if (Time - Stamps[vertex] <= Size)
+			return 0;
+		Stamps[vertex] = Time++;
+		return 1;
+	}
+
+	std::vector<unsigned int> Stamps;
+	unsigned int Size;
+	unsigned int Time;
+};
+
+SCVertexCacheStats SCAnalyzeVertexCache(std::span<const unsigned int> indices, size_t vertexCount, unsigned int cacheSize)
+{
+	SCVertexCacheStats stats;
+	stats.Triangles = indices.size() / 3;
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<bool> used(vertexCount, false);
+	for (size_t i = 0; i < stats.Triangles * 3; i += 3)
+		stats.Transforms += cache.Triangle(&indices[i]);
+	for (size_t i = 0; i < stats.Triangles * 3; i++)
+	{
+		if (!used[indices[i]])
+		{
+			used[indices[i]] = true;
+			stats.Vertices++;
+		}
+	}
+	stats.ACMR = stats.Triangles ? static_cast<float>(stats.Transforms) / stats.Triangles : 0;
+	stats.ATVR = stats.Vertices ? static_cast<float>(stats.Transforms) / stats.Vertices : 0;
+	return stats;
+}
+
+// Welding
+
+static uint64_t CellKey(int64_t x, int64_t y, int64_t z)
+{
+	uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+	h = (h ^ (h >> 31)) + static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full;
+	h = (h ^ (h >> 29)) + static_cast<uint64_t>(z) * 0x165667B19E3779F9ull;
+	h ^= h >> 32;
+	return h | 1; // SCIdMap reserves 0
+}
+
+static bool Within(const SCVertex& a, const SCVertex& b, const SCWeldSettings& settings)
+{
+	auto close = [](float x, float y, float tolerance) { return std::fabs(x - y) <= tolerance; };
+	return close(a.Position.X, b.Position.X, settings.PositionTolerance) && close(a.Position.Y, b.Position.Y, settings.PositionTolerance)
+		&& close(a.Position.Z, b.Position.Z, settings.PositionTolerance)
+		&& close(a.Normal.X, b.Normal.X, settings.NormalTolerance) && close(a.Normal.Y, b.Normal.Y, settings.NormalTolerance)
+		&& close(a.Normal.Z, b.Normal.Z, settings.NormalTolerance)
+		&& close(a.TexCoord.X, b.TexCoord.X, settings.TexCoordTolerance) && close(a.TexCoord.Y, b.TexCoord.Y, settings.TexCoordTolerance);
+}
+
+size_t SCWeldVertices(Mesh& mesh, const SCWeldSettings& settings)
+{
+	constexpr unsigned int None = ~0u;
+	const size_t count = mesh.Vertices.size();
+
+	// Cells are four tolerances wide and a match lies within one tolerance on each axis, so most
+	// vertices only search their own cell and those near a face search two. Each cell heads a chain
+	// through the welded vertices that landed in it.
+	const float tolerance = settings.PositionTolerance;
+	const float cell = std::max(tolerance * 4, 1e-12f);
+	auto cellOf = [cell](float x) { return static_cast<int64_t>(std::floor(x / cell)); };
+	SCIdMap<unsigned int> heads(count);
+	std::vector<SCVertex> welded;
+	std::vector<unsigned int> next;
+	std::vector<unsigned int> remap(count);
+	welded.reserve(count);
+	next.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const SCVertex& vertex = mesh.Vertices[i];
+		const SCVector3f& p = vertex.Position;
+
+		unsigned int match = None;
+		for (int64_t z = cellOf(p.Z - tolerance); z <= cellOf(p.Z + tolerance) && match == None; z++)
+			for (int64_t y = cellOf(p.Y - tolerance); y <= cellOf(p.Y + tolerance) && match == None; y++)
+				for (int64_t x = cellOf(p.X - tolerance); x <= cellOf(p.X + tolerance) && match == None; x++)
+					if (const unsigned int* head = heads.Find(CellKey(x, y, z)))
+						for (unsigned int candidate = *head; candidate != None && match == None; candidate = next[candidate])
+							if (Within(welded[candidate], vertex, settings))
+								match = candidate;
+
+		if (match == None)
+		{
+			match = static_cast<unsigned int>(welded.size());
+			unsigned int* head = heads.Emplace(CellKey(cellOf(p.X), cellOf(p.Y), cellOf(p.Z)), None).first;
+			next.push_back(*head);
+			*head = match;
+			welded.push_back(vertex);
+		}
+		remap[i] = match;
+	}
+
+	// Triangles whose corners welded together draw nothing.
+	size_t kept = 0;
+	for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+	{
+		const unsigned int a = remap[mesh.Indices[i]], b = remap[mesh.Indices[i + 1]], c = remap[mesh.Indices[i + 2]];
+		if (a == b || b == c || a == c)
+			continue;
+		mesh.Indices[kept++] = a;
+		mesh.Indices[kept++] = b;
+		mesh.Indices[kept++] = c;
+	}
+	mesh.Indices.resize(kept);
+
+	const size_t removed = count - welded.size();
+	mesh.Vertices = std::move(welded);
+	return removed;
+}
+
+// Vertex cache order: Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" (2006). Each vertex
+// scores by its position in a modelled LRU cache and by how few triangles it has left (finishing
+// vertices off frees cache slots); triangles score the sum of their vertices, and the best
+// triangle touching the cache goes next.
+
+static constexpr unsigned int ForsythCacheSize = 32;
+static constexpr unsigned int ForsythMaxValence = 64;
+
+struct ForsythScores
+{
+	float Cache[ForsythCacheSize];
+	float Valence[ForsythMaxValence];
+
+	ForsythScores()
+	{
+		for (unsigned int i = 0; i < ForsythCacheSize; i++)
+		{
+			// The three vertices of the triangle just drawn score alike whatever order they went in.
+			Cache[i] = i < 3 ? 0.75f : std::pow(1.0f - static_cast<float>(i - 3) / (ForsythCacheSize - 3), 1.5f);
+		}
+		Valence[0] = 0;
+		for (unsigned int i = 1; i < ForsythMaxValence; i++)
+			Valence[i] = 2.0f / std::sqrt(static_cast<float>(i));
+	}
+
+	float Score(int cachePosition, unsigned int remaining) const
+	{
+		if (remaining == 0)
+			return -1;
+		const float cache = cachePosition >= 0 ? Cache[cachePosition] : 0;
+		return cache + Valence[std::min(remaining, ForsythMaxValence - 1)];
+	}
+};
+
+void SCOptimizeVertexCache(std::span<unsigned int> indices, size_t vertexCount)
+{
+	static const ForsythScores scores;
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	// Each vertex's triangles, live ones first; Remaining counts the live ones.
+	std::vector<unsigned int> offsets(vertexCount + 1, 0);
+	for (size_t i = 0; i < triangleCount * 3; i++)
+		offsets[indices[i] + 1]++;
+	for (size_t v = 0; v < vertexCount; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	std::vector<unsigned int> adjacency(triangleCount * 3);
+	for (size_t t = 0; t < triangleCount; t++)
+		for (size_t k = 0; k < 3; k++)
+		{
+			const unsigned int v = indices[t * 3 + k];
+			adjacency[offsets[v] + remaining[v]++] = static_cast<unsigned int>(t);
+		}
+
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++)
+		vertexScore[v] = scores.Score(-1, remaining[v]);
+
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	for (size_t t = 0; t < triangleCount; t++)
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+	std::vector<unsigned int> output(triangleCount * 3);
+	unsigned int cache[ForsythCacheSize + 3];
+	unsigned int cacheCount = 0;
+	size_t cursor = 0; // every triangle before it is emitted
+
+	size_t best = std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin();
+	for (size_t written = 0; written < triangleCount; written++)
+	{
+		if (best == SIZE_MAX)
+		{
+			// Nothing in the cache has triangles left: start over at the next undrawn one.
+			while (emitted[cursor])
+				cursor++;
+			best = cursor;
+		}
+
+		const unsigned int* triangle = &indices[best * 3];
+		emitted[best] = true;
+		std::copy(triangle, triangle + 3, &output[written * 3]);
+
+		unsigned int updated[ForsythCacheSize + 3];
+		unsigned int updatedCount = 0;
+		for (size_t k = 0; k < 3; k++)
+		{
+			const unsigned int v = triangle[k];
+			updated[updatedCount++] = v;
+			// Take the triangle off the vertex's live list.
+			unsigned int* begin = &adjacency[offsets[v]];
+			unsigned int* end = begin + remaining[v];
+			std::iter_swap(std::find(begin, end, static_cast<unsigned int>(best)), end - 1);
+			remaining[v]--;
+		}
+		for (unsigned int i = 0; i < cacheCount; i++)
+			if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2])
+				updated[updatedCount++] = cache[i];
+
+		// Vertices pushed out of the cache lose their cache score.
+		for (unsigned int i = ForsythCacheSize; i < updatedCount; i++)
+		{
+			const unsigned int v = updated[i];
+			const float score = scores.Score(-1, remaining[v]);
+			const float delta = score - vertexScore[v];
+			vertexScore[v] = score;
+			for (unsigned int a = offsets[v]; a < offsets[v] + remaining[v]; a++)
+				triangleScore[adjacency[a]] += delta;
+		}
+		cacheCount = std::min(updatedCount, ForsythCacheSize);
+		std::copy(updated, updated + cacheCount, cache);
+
+		for (unsigned int i = 0; i < cacheCount; i++)
+		{
+			const unsigned int v = cache[i];
+			const float score = scores.Score(static_cast<int>(i), remaining[v]);
+			const float delta = score - vertexScore[v];
+			vertexScore[v] = score;
+			for (unsigned int a = offsets[v]; a < offsets[v] + remaining[v]; a++)
+				triangleScore[adjacency[a]] += delta;
+		}
+
+		// Only triangles touching the cache changed, so the next one is among them.
+		best = SIZE_MAX;
+		float bestScore = -1;
+		for (unsigned int i = 0; i < cacheCount; i++)
+			for (unsigned int a = offsets[cache[i]]; a < offsets[cache[i]] + remaining[cache[i]]; a++)
+				if (triangleScore[adjacency[a]] > bestScore)
+				{
+					bestScore = triangleScore[adjacency[a]];
+					best = adjacency[a];
+				}
+	}
+
+	std::copy(output.begin(), output.end(), indices.begin());
+}
+
+// Overdraw: Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced
+// Overdraw" (2007). The cache-ordered triangles are cut where the cache restarts anyway (a
+// triangle with three misses) and again wherever a cluster's ACMR so far is within threshold of
+// the whole run's, so clusters can be reordered without losing much of the cache order. Clusters
+// facing away from the mesh's centre are drawn first, since they are the likeliest occluders.
+
+static SCVector3f TriangleNormal(std::span<const SCVertex> vertices, const unsigned int* triangle)
+{
+	const SCVector3f& a = vertices[triangle[0]].Position;
+	return (vertices[triangle[1]].Position - a).Cross(vertices[triangle[2]].Position - a);
+}
+
+void SCOptimizeOverdraw(std::span<unsigned int> indices, std::span<const SCVertex> vertices, float threshold, unsigned int cacheSize)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	FifoCache cache(vertices.size(), cacheSize);
+	std::vector<size_t> hard;
+	for (size_t t = 0; t < triangleCount; t++)
+		if (cache.Triangle(&indices[t * 3]) == 3 || t == 0)
+			hard.push_back(t);
+	hard.push_back(triangleCount);
+
+	std::vector<size_t> clusters;
+	for (size_t h = 0; h + 1 < hard.size(); h++)
+	{
+		const size_t begin = hard[h], end = hard[h + 1];
+		cache.Flush();
+		size_t misses = 0;
+		for (size_t t = begin; t < end; t++)
+			misses += cache.Triangle(&indices[t * 3]);
+		const float target = threshold * misses / (end - begin);
+
+		clusters.push_back(begin);
+		cache.Flush();
+		size_t runMisses = 0, runTriangles = 0;
+		for (size_t t = begin; t < end; t++)
+		{
+			runMisses += cache.Triangle(&indices[t * 3]);
+			runTriangles++;
+			if (t + 1 < end && runMisses <= target * runTriangles)
+			{
+				clusters.push_back(t + 1);
+				cache.Flush();
+				runMisses = runTriangles = 0;
+			}
+		}
+	}
+	clusters.push_back(triangleCount);
+
+	// Area-weighted centroids; the unnormalized cross product is twice the area.
+	SCVector3f meshCentroid;
+	float meshArea = 0;
+	struct Cluster
+	{
+		size_t Begin, End;
+		SCVector3f Centroid;
+		SCVector3f Normal;
+		float Key = 0;
+	};
+	std::vector<Cluster> sorted(clusters.size() - 1);
+	for (size_t c = 0; c + 1 < clusters.size(); c++)
+	{
+		Cluster& cluster = sorted[c];
+		cluster.Begin = clusters[c];
+		cluster.End = clusters[c + 1];
+		float area = 0;
+		for (size_t t = cluster.Begin; t < cluster.End; t++)
+		{
+			const unsigned int* triangle = &indices[t * 3];
+			const SCVector3f normal = TriangleNormal(vertices, triangle);
+			const float weight = std::sqrt(normal.Dot(normal));
+			const SCVector3f centre = (vertices[triangle[0]].Position + vertices[triangle[1]].Position + vertices[triangle[2]].Position) * (1.0f / 3);
+			cluster.Centroid += centre * weight;
+			cluster.Normal += normal;
+			area += weight;
+		}
+		meshCentroid += cluster.Centroid;
+		meshArea += area;
+		cluster.Centroid = area > 0 ? cluster.Centroid * (1.0f / area) : vertices[indices[cluster.Begin * 3]].Position;
+	}
+	meshCentroid = meshArea > 0 ? meshCentroid * (1.0f / meshArea) : SCVector3f();
+
+	for (Cluster& cluster : sorted)
+	{
+		const float length = std::sqrt(cluster.Normal.Dot(cluster.Normal));
+		cluster.Key = length > 0 ? (cluster.Centroid - meshCentroid).Dot(cluster.Normal) / length : 0;
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.Key > b.Key; });
+
+	std::vector<unsigned int> output;
+	output.reserve(triangleCount * 3);
+	for (const Cluster& cluster : sorted)
+		output.insert(output.end(), indices.begin() + cluster.Begin * 3, indices.begin() + cluster.End * 3);
+	std::copy(output.begin(), output.end(), indices.begin());
+}
+
+size_t SCOptimizeVertexFetch(Mesh& mesh)
+{
+	constexpr unsigned int None = ~0u;
+	std::vector<unsigned int> remap(mesh.Vertices.size(), None);
+	std::vector<SCVertex> ordered;
+	ordered.reserve(mesh.Vertices.size());
+	for (unsigned int& index : mesh.Indices)
+	{
+		if (remap[index] == None)
+		{
+			remap[index] = static_cast<unsigned int>(ordered.size());
+			ordered.push_back(mesh.Vertices[index]);
+		}
+		index = remap[index];
+	}
+
+	const size_t dropped = mesh.Vertices.size() - ordered.size();
+	mesh.Vertices = std::move(ordered);
+	return dropped;
+}
+
+SCMeshOptimizeReport SCOptimizeMesh(Mesh& mesh, const SCMeshOptimizeSettings& settings)
+{
+	SCMeshOptimizeReport report;
+	report.VerticesBefore = mesh.Vertices.size();
+	report.Before = SCAnalyzeVertexCache(mesh.Indices, mesh.Vertices.size(), settings.CacheSize);
+
+	if (settings.Weld)
+		SCWeldVertices(mesh, settings.WeldSettings);
+	SCOptimizeVertexCache(mesh.Indices, mesh.Vertices.size());
+	if (settings.Overdraw)
+		SCOptimizeOverdraw(mesh.Indices, mesh.Vertices, settings.OverdrawThreshold, settings.CacheSize);
+	SCOptimizeVertexFetch(mesh);
+
+	report.VerticesAfter = mesh.Vertices.size();
+	report.After = SCAnalyzeVertexCache(mesh.Indices, mesh.Vertices.size(), settings.CacheSize);
+	return report;
+}
+
+std::ostream& operator<<(std::ostream& stream, const SCMeshOptimizeReport& report)
+{
+	const std::ios::fmtflags flags = stream.flags();
+	const std::streamsize precision = stream.precision();
+	stream << std::fixed << std::setprecision(3)
+		<< report.After.Triangles << " triangles, vertices " << report.VerticesBefore << " -> " << report.VerticesAfter
+		<< ", ACMR " << report.Before.ACMR << " -> " << report.After.ACMR
+		<< ", ATVR " << report.Before.ATVR << " -> " << report.After.ATVR << "\n";
+	stream.flags(flags);
+	stream.precision(precision);
+	return stream;
+}
@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <Graphics/MeshOptimizer.h>
+#include <Graphics/MeshSimplifier.h>
+
+// Weighted sum of squared distances to planes: Q(p) = p.A.p + 2 b.p + c, A symmetric and kept as
+// its upper triangle. Doubles, since the terms nearly cancel close to the surface.
+struct Quadric
+{
+	double A00 = 0, A01 = 0, A02 = 0, A11 = 0, A12 = 0, A22 = 0;
+	double B0 = 0, B1 = 0, B2 = 0;
+	double C = 0;
+	double Weight = 0;
+
+	// The plane through point with the given unit normal.
+	static Quadric Plane(const SCVector3f& normal, const SCVector3f& point, double weight)
+	{
+		const double a = normal.X, b = normal.Y, c = normal.Z, d = -normal.Dot(point);
+		Quadric q;
+		q.A00 = a * a * weight; q.A01 = a * b * weight; q.A02 = a * c * weight;
+		q.A11 = b * b * weight; q.A12 = b * c * weight; q.A22 = c * c * weight;
+		q.B0 = a * d * weight; q.B1 = b * d * weight; q.B2 = c * d * weight;
+		q.C = d * d * weight;
+		q.Weight = weight;
+		return q;
+	}
+
+	Quadric& operator+=(const Quadric& other)
+	{
+		A00 += other.A00; A01 += other.A01; A02 += other.A02;
+		A11 += other.A11; A12 += other.A12; A22 += other.A22;
+		B0 += other.B0; B1 += other.B1; B2 += other.B2;
+		C += other.C;
+		Weight += other.Weight;
+		return *this;
+	}
+
+	Quadric operator+(const Quadric& other) const { return Quadric(*this) += other; }
+
+	// Root mean square distance from p to the planes.
+	float Error(const SCVector3f& p) const
+	{
+		if (Weight <= 0)
+			return 0;
+		const double x = p.X, y = p.Y, z = p.Z;
+		const double q = A00 * x * x + A11 * y * y + A22 * z * z + 2 * (A01 * x * y + A02 * x * z + A12 * y * z)
+			+ 2 * (B0 * x + B1 * y + B2 * z) + C;
+		return static_cast<float>(std::sqrt(std::max(q, 0.0) / Weight));
+	}
+};
+
+enum class SimplifyVertexKind : uint8_t
+{
+	Manifold,	// collapses into any neighbour
+	Border,		// collapses along the border only
+	Locked
+};
+
+// Borders weigh more than the surface so the outline of open meshes holds its shape.
+static constexpr double BorderWeight = 10;
+
+struct SimplifyCollapse
+{
+	unsigned int From;
+	unsigned int To;
+	float Error;
+};
+
+// Stable LSD radix sort by Error, 11 bits a pass. Errors are never negative, so their bit
+// patterns order the same way the floats do; a comparison sort was most of a pass's time.
+static void SortCollapses(std::vector<SimplifyCollapse>& collapses, std::vector<SimplifyCollapse>& scratch)
+{
+	scratch.resize(collapses.size());
+	for (unsigned int shift = 0; shift < 32; shift += 11)
+	{
+		unsigned int histogram[2048] = {};
+		auto digit = [shift](const SimplifyCollapse& collapse)
+			{
+				uint32_t bits;
+				std::memcpy(&bits, &collapse.Error, sizeof(bits));
+				return (bits >> shift) & 2047;
+			};
+		for (const SimplifyCollapse& collapse : collapses)
+			histogram[digit(collapse)]++;
+		for (unsigned int i = 0, sum = 0; i < 2048; i++)
+			sum += std::exchange(histogram[i], sum);
+		for (const SimplifyCollapse& collapse : collapses)
+			scratch[histogram[digit(collapse)]++] = collapse;
+		collapses.swap(scratch);
+	}
+}
+
+std::vector<unsigned int> SCSimplify(std::span<const unsigned int> indices, std::span<const SCVertex> vertices,
+	size_t targetIndexCount, float targetError, float* resultError)
+{
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		if (indices[i] != indices[i + 1] && indices[i + 1] != indices[i + 2] && indices[i] != indices[i + 2])
+			result.insert(result.end(), &indices[i], &indices[i] + 3);
+	const size_t vertexCount = vertices.size();
+	const size_t targetTriangles = targetIndexCount / 3;
+	float maxError = 0;
+
+	// Topology is decided by position, so each used vertex maps to the first used vertex at its
+	// position; more than one at a position is a seam.
+	std::vector<bool> used(vertexCount, false);
+	for (unsigned int index : result)
+		used[index] = true;
+	std::vector<unsigned int> order;
+	for (unsigned int v = 0; v < vertexCount; v++)
+		if (used[v])
+			order.push_back(v);
+	auto positionLess = [&](unsigned int a, unsigned int b)
+		{
+			const SCVector3f& p = vertices[a].Position;
+			const SCVector3f& q = vertices[b].Position;
+			return p.X != q.X ? p.X < q.X : p.Y != q.Y ? p.Y < q.Y : p.Z != q.Z ? p.Z < q.Z : a < b;
+		};
+	std::sort(order.begin(), order.end(), positionLess);
+
+	std::vector<unsigned int> canonical(vertexCount);
+	std::iota(canonical.begin(), canonical.end(), 0u);
+	std::vector<SimplifyVertexKind> kind(vertexCount, SimplifyVertexKind::Manifold);
+	for (size_t begin = 0, end; begin < order.size(); begin = end)
+	{
+		end = begin + 1;
+		while (end < order.size() && vertices[order[end]].Position == vertices[order[begin]].Position)
+			end++;
+		for (size_t i = begin; i < end; i++)
+		{
+			canonical[order[i]] = order[begin];
+			if (end - begin > 1)
+				kind[order[i]] = SimplifyVertexKind::Locked;
+		}
+	}
+
+	// The triangles around each position, rebuilt as triangles go. Half-edges are looked up through
+	// them; vertices that can move have no others at their position, so they also list exactly
+	// the triangles that use the vertex.
+	std::vector<unsigned int> offsets;
+	std::vector<unsigned int> adjacency;
+	auto buildAdjacency = [&]()
+		{
+			offsets.assign(vertexCount + 1, 0);
+			for (unsigned int index : result)
+				offsets[canonical[index] + 1]++;
+			for (size_t v = 0; v < vertexCount; v++)
+				offsets[v + 1] += offsets[v];
+			adjacency.resize(result.size());
+			std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < result.size(); i++)
+				adjacency[fill[canonical[result[i]]]++] = static_cast<unsigned int>(i / 3);
+		};
+	auto countEdge = [&](unsigned int from, unsigned int to)
+		{
+			from = canonical[from];
+			to = canonical[to];
+			unsigned int count = 0;
+			for (unsigned int a = offsets[from]; a < offsets[from + 1]; a++)
+			{
+				const unsigned int* triangle = &result[adjacency[a] * 3];
+				const size_t k = canonical[triangle[0]] == from ? 0 : canonical[triangle[1]] == from ? 1 : 2;
+				count += canonical[triangle[(k + 1) % 3]] == to;
+			}
+			return count;
+		};
+	// Per corner: whether the half-edge from it to the next corner has no opposite.
+	std::vector<bool> borderEdge;
+	auto findBorders = [&]()
+		{
+			borderEdge.resize(result.size());
+			for (size_t i = 0; i < result.size(); i += 3)
+				for (size_t k = 0; k < 3; k++)
+					borderEdge[i + k] = countEdge(result[i + (k + 1) % 3], result[i + k]) == 0;
+		};
+
+	// Borders have no opposite half-edge; a half-edge used twice is non-manifold, and its ends stay.
+	buildAdjacency();
+	findBorders();
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		for (size_t k = 0; k < 3; k++)
+		{
+			const unsigned int a = result[i + k], b = result[i + (k + 1) % 3];
+			if (countEdge(a, b) > 1)
+			{
+				kind[a] = kind[b] = SimplifyVertexKind::Locked;
+			}
+			else if (borderEdge[i + k])
+			{
+				if (kind[a] == SimplifyVertexKind::Manifold)
+					kind[a] = SimplifyVertexKind::Border;
+				if (kind[b] == SimplifyVertexKind::Manifold)
+					kind[b] = SimplifyVertexKind::Border;
+			}
+		}
+	}
+
+	// Each triangle's plane, weighted by area, goes to its corners; each border edge adds a plane
+	// through it perpendicular to its triangle.
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		const unsigned int* triangle = &result[i];
+		const SCVector3f& p0 = vertices[triangle[0]].Position;
+		const SCVector3f cross = (vertices[triangle[1]].Position - p0).Cross(vertices[triangle[2]].Position - p0);
+		const float length = cross.Length();
+		if (length == 0)
+			continue;
+		const SCVector3f normal = cross * (1.0f / length);
+		const Quadric plane = Quadric::Plane(normal, p0, length * 0.5);
+		for (size_t k = 0; k < 3; k++)
+		{
+			quadrics[canonical[triangle[k]]] += plane;
+
+			if (!borderEdge[i + k])
+				continue;
+			const unsigned int a = triangle[k], b = triangle[(k + 1) % 3];
+			const SCVector3f edge = vertices[b].Position - vertices[a].Position;
+			const float edgeLength = edge.Length();
+			if (edgeLength == 0)
+				continue;
+			const SCVector3f side = edge.Cross(normal) * (1.0f / edgeLength);
+			const Quadric border = Quadric::Plane(side, vertices[a].Position, edgeLength * edgeLength * BorderWeight);
+			quadrics[canonical[a]] += border;
+			quadrics[canonical[b]] += border;
+		}
+	}
+
+	std::vector<SimplifyCollapse> collapses;
+	std::vector<SimplifyCollapse> scratch;
+	std::vector<unsigned int> remap(vertexCount);
+	std::vector<bool> touched(vertexCount);
+
+	// Passes of independent collapses, cheapest first: a vertex takes part in at most one per pass,
+	// and neither does anything it shares a triangle with, so every check below sees the
+	// triangles as they really are.
+	while (result.size() / 3 > targetTriangles)
+	{
+		const size_t triangleCount = result.size() / 3;
+		buildAdjacency();
+		findBorders();
+
+		collapses.clear();
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (size_t k = 0; k < 3; k++)
+			{
+				const unsigned int a = result[i + k], b = result[i + (k + 1) % 3];
+				const bool border = borderEdge[i + k];
+				// Interior edges come up from both of their triangles; take them once.
+				if (!border && canonical[a] > canonical[b])
+					continue;
+
+				const Quadric combined = quadrics[canonical[a]] + quadrics[canonical[b]];
+				auto allowed = [&](unsigned int from)
+					{
+						return kind[from] == SimplifyVertexKind::Manifold || (kind[from] == SimplifyVertexKind::Border && border);
+					};
+				const float toB = allowed(a) ? combined.Error(vertices[b].Position) : std::numeric_limits<float>::infinity();
+				const float toA = allowed(b) ? combined.Error(vertices[a].Position) : std::numeric_limits<float>::infinity();
+				if (toB <= toA && toB <= targetError)
+					collapses.push_back({ a, b, toB });
+				else if (toA < toB && toA <= targetError)
+					collapses.push_back({ b, a, toA });
+			}
+		}
+		SortCollapses(collapses, scratch);
+
+		std::iota(remap.begin(), remap.end(), 0u);
+		std::fill(touched.begin(), touched.end(), false);
+		size_t removed = 0;
+		size_t applied = 0;
+		for (const SimplifyCollapse& collapse : collapses)
+		{
+			if (triangleCount - removed <= targetTriangles)
+				break;
+			if (touched[collapse.From] || touched[collapse.To])
+				continue;
+
+			// Refuse collapses that fold a remaining triangle over or squash it flat.
+			bool valid = true;
+			size_t collapsing = 0;
+			const SCVector3f& to = vertices[collapse.To].Position;
+			for (unsigned int a = offsets[collapse.From]; a < offsets[collapse.From + 1] && valid; a++)
+			{
+				const unsigned int* triangle = &result[adjacency[a] * 3];
+				if (triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To)
+				{
+					collapsing++;
+					continue;
+				}
+				SCVector3f before[3], after[3];
+				for (size_t k = 0; k < 3; k++)
+				{
+					before[k] = vertices[triangle[k]].Position;
+					after[k] = triangle[k] == collapse.From ? to : before[k];
+				}
+				const SCVector3f oldNormal = (before[1] - before[0]).Cross(before[2] - before[0]);
+				const SCVector3f newNormal = (after[1] - after[0]).Cross(after[2] - after[0]);
+				const float newLength = newNormal.Length();
+				valid = newLength > 0 && oldNormal.Dot(newNormal) >= 0.25f * oldNormal.Length() * newLength;
+			}
+			if (!valid)
+				continue;
+
+			remap[collapse.From] = collapse.To;
+			quadrics[canonical[collapse.To]] += quadrics[canonical[collapse.From]];
+			for (unsigned int a = offsets[collapse.From]; a < offsets[collapse.From + 1]; a++)
+				for (size_t k = 0; k < 3; k++)
+					touched[result[adjacency[a] * 3 + k]] = true;
+			touched[collapse.To] = true;
+			maxError = std::max(maxError, collapse.Error);
+			removed += collapsing;
+			applied++;
+		}
+		if (applied == 0)
+			break;
+
+		size_t kept = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+			if (a == b || b == c || a == c)
+				continue;
+			result[kept++] = a;
+			result[kept++] = b;
+			result[kept++] = c;
+		}
+		result.resize(kept);
+	}
+
+	if (resultError)
+		*resultError = maxError;
+	return result;
+}
+
+size_t SCBuildLods(Mesh& mesh, const SCLodSettings& settings)
+{
+	// Rebuilding drops the old chain first.
+	if (!mesh.Lods.empty())
+		mesh.Indices.resize(mesh.Lods[0].IndexCount);
+	mesh.Lods.clear();
+	mesh.Lods.push_back({ 0, static_cast<uint32_t>(mesh.Indices.size()), 0.0f });
+	if (mesh.Vertices.empty() || mesh.Indices.empty())
+		return mesh.Lods.size();
+
+	SCVector3f min = mesh.Vertices[0].Position, max = min;
+	for (const SCVertex& vertex : mesh.Vertices)
+	{
+		min = SCVector3f(std::min(min.X, vertex.Position.X), std::min(min.Y, vertex.Position.Y), std::min(min.Z, vertex.Position.Z));
+		max = SCVector3f(std::max(max.X, vertex.Position.X), std::max(max.Y, vertex.Position.Y), std::max(max.Z, vertex.Position.Z));
+	}
+	const float budget = settings.MaxError * (max - min).Length() * 0.5f;
+
+	// Each level starts from the one before, so their errors add up.
+	std::vector<unsigned int> previous = mesh.Indices;
+	float error = 0;
+	while (mesh.Lods.size() < settings.MaxLods && previous.size() / 3 > settings.MinTriangles && error < budget)
+	{
+		const size_t target = static_cast<size_t>(previous.size() / 3 * settings.Reduction) * 3;
+		float stepError = 0;
+		std::vector<unsigned int> lod = SCSimplify(previous, mesh.Vertices, target, budget - error, &stepError);
+		if (lod.empty() || lod.size() > previous.size() - previous.size() / 10)
+			break;
+
+		SCOptimizeVertexCache(lod, mesh.Vertices.size());
+		error += stepError;
+		mesh.Lods.push_back({ static_cast<uint32_t>(mesh.Indices.size()), static_cast<uint32_t>(lod.size()), error });
+		mesh.Indices.insert(mesh.Indices.end(), lod.begin(), lod.end());
+		previous = std::move(lod);
+	}
+	return mesh.Lods.size();
+}
+
+size_t SCSelectLod(std::span<const SCMeshLod> lods, float distance, float fovY, float viewportHeight, float pixelError)
+{
+	if (lods.empty() || distance <= 0)
+		return 0;
+
+	const float pixelsPerUnit = viewportHeight / (2.0f * std::tan(fovY * 0.5f) * distance);
+	size_t lod = 0;
+	while (lod + 1 < lods.size() && lods[lod + 1].Error * pixelsPerUnit <= pixelError)
+		lod++;
+	return lod;
+}
+
+size_t SCSelectLod(std::span<const SCMeshLod> lods, const DXCamera3D& camera, const SCVector3f& center, float radius,
+	float viewportHeight, float pixelError)
+{
+	const float distance = (center - camera.Position).Length() - radius;
+	return SCSelectLod(lods, distance, camera.FOV, viewportHeight, pixelError);
+}
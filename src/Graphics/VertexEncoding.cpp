@@ -0,0 +1,308 @@
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Graphics/VertexEncoding.h>
+
+unsigned int SCVertexStride(SCVertexFormat format)
+{
+	switch (format)
+	{
+	case SCVertexFormat::Compact: return sizeof(SCCompactVertex);
+	case SCVertexFormat::CompactQuantized: return sizeof(SCQuantizedVertex);
+	default: return sizeof(SCVertex);
+	}
+}
+
+unsigned int SCEncodedVertices::Stride() const
+{
+	return SCVertexStride(Format);
+}
+
+// Half precision
+
+uint16_t SCFloatToHalf(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const uint32_t sign = (bits >> 16) & 0x8000;
+	const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	if (((bits >> 23) & 0xFF) == 0xFF) // inf / nan
+		return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+	if (exponent >= 0x1F) // overflow
+		return static_cast<uint16_t>(sign | 0x7C00);
+	if (exponent <= 0)
+	{
+		// Denormal or underflow to zero.
+		if (exponent < -10)
+			return static_cast<uint16_t>(sign);
+		mantissa |= 0x800000;
+		const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+		uint32_t half = mantissa >> shift;
+		const uint32_t rest = mantissa & ((1u << shift) - 1);
+		const uint32_t halfway = 1u << (shift - 1);
+		if (rest > halfway || (rest == halfway && (half & 1)))
+			half++;
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+	const uint32_t rest = mantissa & 0x1FFF;
+	// Round to nearest even; a carry into the exponent is still the correct result.
+	if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+		half++;
+	return static_cast<uint16_t>(sign | half);
+}
+
+float SCHalfToFloat(uint16_t value)
+{
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1F;
+	uint32_t mantissa = value & 0x3FF;
+	uint32_t bits;
+
+	if (exponent == 0x1F)
+	{
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else if (exponent == 0)
+	{
+		if (mantissa == 0)
+		{
+			bits = sign;
+		}
+		else
+		{
+			// Renormalize the denormal.
+			exponent = 1;
+			while ((mantissa & 0x400) == 0)
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+			mantissa &= 0x3FF;
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+		}
+	}
+	else
+	{
+		bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+// Octahedral normals
+
+static float SignNotZero(float v)
+{
+	return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+static int16_t ToSnorm16(float v)
+{
+	return static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+static float FromSnorm16(int16_t v)
+{
+	return std::max(static_cast<float>(v) / 32767.0f, -1.0f);
+}
+
+static uint16_t ToUnorm16(float v)
+{
+	return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+}
+
+static float FromUnorm16(uint16_t v)
+{
+	return static_cast<float>(v) / 65535.0f;
+}
+
+void SCEncodeOctahedral(const SCVector3f& normal, int16_t out[2])
+{
+	const float l1 = std::fabs(normal.X) + std::fabs(normal.Y) + std::fabs(normal.Z);
+	float x = l1 > 0 ? normal.X / l1 : 0.0f;
+	float y = l1 > 0 ? normal.Y / l1 : 0.0f;
+
+	if (normal.Z < 0)
+	{
+		const float ox = x;
+		x = (1.0f - std::fabs(y)) * SignNotZero(ox);
+		y = (1.0f - std::fabs(ox)) * SignNotZero(y);
+	}
+
+	out[0] = ToSnorm16(x);
+	out[1] = ToSnorm16(y);
+}
+
+SCVector3f SCDecodeOctahedral(const int16_t encoded[2])
+{
+	float x = FromSnorm16(encoded[0]);
+	float y = FromSnorm16(encoded[1]);
+	const float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+	if (z < 0)
+	{
+		const float ox = x;
+		x = (1.0f - std::fabs(y)) * SignNotZero(ox);
+		y = (1.0f - std::fabs(ox)) * SignNotZero(y);
+	}
+
+	const SCVector3f n(x, y, z);
+	const float length = n.Length();
+	return length > 0 ? n.ScalarMultiply(1.0f / length) : SCVector3f(0, 0, 1);
+}
+
+// Whole meshes
+
+static SCVertexQuantization ComputeQuantization(std::span<const SCVertex> vertices)
+{
+	SCVertexQuantization q;
+	if (vertices.empty())
+		return q;
+
+	SCVector3f lo(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+	SCVector3f hi(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+	for (const SCVertex& v : vertices)
+	{
+		lo = SCVector3f(std::min(lo.X, v.Position.X), std::min(lo.Y, v.Position.Y), std::min(lo.Z, v.Position.Z));
+		hi = SCVector3f(std::max(hi.X, v.Position.X), std::max(hi.Y, v.Position.Y), std::max(hi.Z, v.Position.Z));
+	}
+
+	q.Min = lo;
+	q.Extent = hi - lo;
+	return q;
+}
+
+static float QuantizeAxis(float value, float min, float extent)
+{
+	return extent > 0 ? (value - min) / extent : 0.0f;
+}
+
+SCEncodedVertices SCEncodeVertices(std::span<const SCVertex> vertices, SCVertexFormat format)
+{
+	SCEncodedVertices encoded;
+	encoded.Format = format;
+	encoded.Count = vertices.size();
+	encoded.Data.resize(vertices.size() * encoded.Stride());
+
+	switch (format)
+	{
+	case SCVertexFormat::Compact:
+	{
+		SCCompactVertex* out = reinterpret_cast<SCCompactVertex*>(encoded.Data.data());
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			out[i].Position = vertices[i].Position;
+			SCEncodeOctahedral(vertices[i].Normal, out[i].Normal);
+			out[i].TexCoord[0] = SCFloatToHalf(vertices[i].TexCoord.X);
+			out[i].TexCoord[1] = SCFloatToHalf(vertices[i].TexCoord.Y);
+		}
+	}
+	break;
+
+	case SCVertexFormat::CompactQuantized:
+	{
+		encoded.Quantization = ComputeQuantization(vertices);
+		const SCVertexQuantization& q = encoded.Quantization;
+		SCQuantizedVertex* out = reinterpret_cast<SCQuantizedVertex*>(encoded.Data.data());
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const SCVector3f& p = vertices[i].Position;
+			out[i].Position[0] = ToUnorm16(QuantizeAxis(p.X, q.Min.X, q.Extent.X));
+			out[i].Position[1] = ToUnorm16(QuantizeAxis(p.Y, q.Min.Y, q.Extent.Y));
+			out[i].Position[2] = ToUnorm16(QuantizeAxis(p.Z, q.Min.Z, q.Extent.Z));
+			out[i].Position[3] = 0;
+			SCEncodeOctahedral(vertices[i].Normal, out[i].Normal);
+			out[i].TexCoord[0] = SCFloatToHalf(vertices[i].TexCoord.X);
+			out[i].TexCoord[1] = SCFloatToHalf(vertices[i].TexCoord.Y);
+		}
+	}
+	break;
+
+	default:
+		if (!vertices.empty())
+			std::memcpy(encoded.Data.data(), vertices.data(), encoded.Data.size());
+		break;
+	}
+
+	return encoded;
+}
+
+std::vector<SCVertex> SCDecodeVertices(const SCEncodedVertices& encoded)
+{
+	std::vector<SCVertex> vertices(encoded.Count);
+
+	switch (encoded.Format)
+	{
+	case SCVertexFormat::Compact:
+	{
+		const SCCompactVertex* in = reinterpret_cast<const SCCompactVertex*>(encoded.Data.data());
+		for (size_t i = 0; i < encoded.Count; i++)
+		{
+			vertices[i].Position = in[i].Position;
+			vertices[i].Normal = SCDecodeOctahedral(in[i].Normal);
+			vertices[i].TexCoord = SCVector2f(SCHalfToFloat(in[i].TexCoord[0]), SCHalfToFloat(in[i].TexCoord[1]));
+		}
+	}
+	break;
+
+	case SCVertexFormat::CompactQuantized:
+	{
+		const SCVertexQuantization& q = encoded.Quantization;
+		const SCQuantizedVertex* in = reinterpret_cast<const SCQuantizedVertex*>(encoded.Data.data());
+		for (size_t i = 0; i < encoded.Count; i++)
+		{
+			const SCVector3f unorm(FromUnorm16(in[i].Position[0]), FromUnorm16(in[i].Position[1]), FromUnorm16(in[i].Position[2]));
+			vertices[i].Position = q.Min + unorm * q.Extent;
+			vertices[i].Normal = SCDecodeOctahedral(in[i].Normal);
+			vertices[i].TexCoord = SCVector2f(SCHalfToFloat(in[i].TexCoord[0]), SCHalfToFloat(in[i].TexCoord[1]));
+		}
+	}
+	break;
+
+	default:
+		if (encoded.Count)
+			std::memcpy(vertices.data(), encoded.Data.data(), encoded.Count * sizeof(SCVertex));
+		break;
+	}
+
+	return vertices;
+}
+
+SCVertexEncodingError SCMeasureEncodingError(const std::vector<SCVertex>& original, const SCEncodedVertices& encoded)
+{
+	SCVertexEncodingError error;
+	const std::vector<SCVertex> decoded = SCDecodeVertices(encoded);
+	const size_t count = std::min(original.size(), decoded.size());
+	if (count == 0)
+		return error;
+
+	double sumPosition = 0, sumNormal = 0, sumTexCoord = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		const float position = (original[i].Position - decoded[i].Position).Length();
+		// atan2 keeps precision for the tiny angles we care about, where acos(dot) does not.
+		const SCVector3f n = original[i].Normal.Normalize();
+		const float normal = std::atan2(n.Cross(decoded[i].Normal).Length(), n.Dot(decoded[i].Normal));
+		const float texCoord = (original[i].TexCoord - decoded[i].TexCoord).Length();
+
+		error.MaxPositionError = std::max(error.MaxPositionError, position);
+		error.MaxNormalError = std::max(error.MaxNormalError, normal);
+		error.MaxTexCoordError = std::max(error.MaxTexCoordError, texCoord);
+		sumPosition += position;
+		sumNormal += normal;
+		sumTexCoord += texCoord;
+	}
+
+	error.MeanPositionError = static_cast<float>(sumPosition / count);
+	error.MeanNormalError = static_cast<float>(sumNormal / count);
+	error.MeanTexCoordError = static_cast<float>(sumTexCoord / count);
+	return error;
+}
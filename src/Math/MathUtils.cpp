@@ -0,0 +1,90 @@
+#include <atomic>
+#include <Math/MathUtils.h>
+
+#if defined(SC_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+void SCMathCheckFailed(const char* message)
+{
+	std::cerr << "[ENGINE][MATH]: " << message << std::endl;
+}
+
+static SCSimdLevel DetectSimdLevel()
+{
+#if defined(SC_SIMD_X86)
+	unsigned int regs[4] = {};
+
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+	unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+	__cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+#endif
+
+	const bool sse2 = (regs[3] & (1u << 26)) != 0;
+	const bool osxsave = (regs[2] & (1u << 27)) != 0;
+	const bool avx = (regs[2] & (1u << 28)) != 0;
+	const bool fma = (regs[2] & (1u << 12)) != 0;
+
+	bool avx2 = false;
+	if (maxLeaf >= 7 && osxsave && avx && fma)
+	{
+		// The OS must also save the YMM state on context switch.
+#if defined(_MSC_VER)
+		unsigned long long xcr0 = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+#else
+		unsigned int xlo, xhi;
+		__asm__("xgetbv" : "=a"(xlo), "=d"(xhi) : "c"(0));
+		unsigned long long xcr0 = (static_cast<unsigned long long>(xhi) << 32) | xlo;
+		unsigned int a, b, c, d;
+		__cpuid_count(7, 0, a, b, c, d);
+		avx2 = (b & (1u << 5)) != 0;
+#endif
+		avx2 = avx2 && (xcr0 & 0x6) == 0x6;
+	}
+
+	if (avx2)
+		return SCSimdLevel::AVX2;
+	if (sse2)
+		return SCSimdLevel::SSE;
+#endif
+	return SCSimdLevel::Scalar;
+}
+
+static std::atomic<SCSimdLevel>& ActiveSimdLevel()
+{
+	static std::atomic<SCSimdLevel> level(SCGetSupportedSimdLevel());
+	return level;
+}
+
+SCSimdLevel SCGetSupportedSimdLevel()
+{
+	static const SCSimdLevel supported = DetectSimdLevel();
+	return supported;
+}
+
+SCSimdLevel SCGetSimdLevel()
+{
+	return ActiveSimdLevel().load(std::memory_order_relaxed);
+}
+
+void SCSetSimdLevel(SCSimdLevel level)
+{
+	if (static_cast<int>(level) > static_cast<int>(SCGetSupportedSimdLevel()))
+	{
+		std::cerr << "[ENGINE][MATH]: Requested SIMD level is not supported by this CPU, clamping." << std::endl;
+		level = SCGetSupportedSimdLevel();
+	}
+	ActiveSimdLevel().store(level, std::memory_order_relaxed);
+}
@@ -0,0 +1,422 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <Math/VectorStream.h>
+
+#if defined(SC_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+// Elementwise ops are written once per lane width and shared by the scalar, SSE and AVX2 loops.
+
+struct AddOp
+{
+	static float Apply(float a, float b) { return a + b; }
+#if defined(SC_SIMD_X86)
+	static __m128 Apply(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+	SC_TARGET_AVX2 static __m256 Apply(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+#endif
+};
+
+struct SubtractOp
+{
+	static float Apply(float a, float b) { return a - b; }
+#if defined(SC_SIMD_X86)
+	static __m128 Apply(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+	SC_TARGET_AVX2 static __m256 Apply(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+#endif
+};
+
+struct MultiplyOp
+{
+	static float Apply(float a, float b) { return a * b; }
+#if defined(SC_SIMD_X86)
+	static __m128 Apply(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+	SC_TARGET_AVX2 static __m256 Apply(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+#endif
+};
+
+template<typename Op>
+static void ElementwiseScalar(const float* a, const float* b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = Op::Apply(a[i], b[i]);
+}
+
+template<typename Op>
+static void ElementwiseScalar(const float* a, float b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = Op::Apply(a[i], b);
+}
+
+#if defined(SC_SIMD_X86)
+template<typename Op>
+static void ElementwiseSSE(const float* a, const float* b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i += 4)
+		_mm_store_ps(out + i, Op::Apply(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+}
+
+template<typename Op>
+static void ElementwiseSSE(const float* a, float b, float* out, size_t n)
+{
+	const __m128 vb = _mm_set1_ps(b);
+	for (size_t i = 0; i < n; i += 4)
+		_mm_store_ps(out + i, Op::Apply(_mm_load_ps(a + i), vb));
+}
+
+template<typename Op>
+SC_TARGET_AVX2 static void ElementwiseAVX2(const float* a, const float* b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i += 8)
+		_mm256_store_ps(out + i, Op::Apply(_mm256_load_ps(a + i), _mm256_load_ps(b + i)));
+}
+
+template<typename Op>
+SC_TARGET_AVX2 static void ElementwiseAVX2(const float* a, float b, float* out, size_t n)
+{
+	const __m256 vb = _mm256_set1_ps(b);
+	for (size_t i = 0; i < n; i += 8)
+		_mm256_store_ps(out + i, Op::Apply(_mm256_load_ps(a + i), vb));
+}
+#endif
+
+template<typename Op, typename B>
+static void Elementwise(const float* a, B b, float* out, size_t n)
+{
+	switch (SCGetSimdLevel())
+	{
+#if defined(SC_SIMD_X86)
+	case SCSimdLevel::AVX2:
+		ElementwiseAVX2<Op>(a, b, out, n);
+		break;
+	case SCSimdLevel::SSE:
+		ElementwiseSSE<Op>(a, b, out, n);
+		break;
+#endif
+	default:
+		ElementwiseScalar<Op>(a, b, out, n);
+		break;
+	}
+}
+
+// Dot / Cross / Normalize / Transform
+
+static void DotScalar(const SCVector3fStream& a, const SCVector3fStream& b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = a.X[i] * b.X[i] + a.Y[i] * b.Y[i] + a.Z[i] * b.Z[i];
+}
+
+static void CrossScalar(const SCVector3fStream& a, const SCVector3fStream& b, SCVector3fStream& out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		const float ax = a.X[i], ay = a.Y[i], az = a.Z[i];
+		const float bx = b.X[i], by = b.Y[i], bz = b.Z[i];
+		out.X[i] = ay * bz - az * by;
+		out.Y[i] = az * bx - ax * bz;
+		out.Z[i] = ax * by - ay * bx;
+	}
+}
+
+static void NormalizeScalar(const SCVector3fStream& a, SCVector3fStream& out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		const float x = a.X[i], y = a.Y[i], z = a.Z[i];
+		const float length = std::sqrt(x * x + y * y + z * z);
+		if (length != 0)
+		{
+			out.X[i] = x / length;
+			out.Y[i] = y / length;
+			out.Z[i] = z / length;
+		}
+		else
+		{
+			out.X[i] = x;
+			out.Y[i] = y;
+			out.Z[i] = z;
+		}
+	}
+}
+
+static void TransformScalar(const SCVector3fStream& a, const float* m, SCVector3fStream& out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		const float x = a.X[i], y = a.Y[i], z = a.Z[i];
+		out.X[i] = x * m[0] + y * m[4] + z * m[8] + m[12];
+		out.Y[i] = x * m[1] + y * m[5] + z * m[9] + m[13];
+		out.Z[i] = x * m[2] + y * m[6] + z * m[10] + m[14];
+	}
+}
+
+#if defined(SC_SIMD_X86)
+static void DotSSE(const SCVector3fStream& a, const SCVector3fStream& b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i += 4)
+	{
+		__m128 r = _mm_mul_ps(_mm_load_ps(&a.X[i]), _mm_load_ps(&b.X[i]));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&a.Y[i]), _mm_load_ps(&b.Y[i])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&a.Z[i]), _mm_load_ps(&b.Z[i])));
+		_mm_store_ps(out + i, r);
+	}
+}
+
+static void CrossSSE(const SCVector3fStream& a, const SCVector3fStream& b, SCVector3fStream& out, size_t n)
+{
+	for (size_t i = 0; i < n; i += 4)
+	{
+		const __m128 ax = _mm_load_ps(&a.X[i]), ay = _mm_load_ps(&a.Y[i]), az = _mm_load_ps(&a.Z[i]);
+		const __m128 bx = _mm_load_ps(&b.X[i]), by = _mm_load_ps(&b.Y[i]), bz = _mm_load_ps(&b.Z[i]);
+		_mm_store_ps(&out.X[i], _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+		_mm_store_ps(&out.Y[i], _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+		_mm_store_ps(&out.Z[i], _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+	}
+}
+
+static void NormalizeSSE(const SCVector3fStream& a, SCVector3fStream& out, size_t n)
+{
+	const __m128 zero = _mm_setzero_ps();
+	for (size_t i = 0; i < n; i += 4)
+	{
+		const __m128 x = _mm_load_ps(&a.X[i]), y = _mm_load_ps(&a.Y[i]), z = _mm_load_ps(&a.Z[i]);
+		const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		const __m128 mask = _mm_cmpgt_ps(lengthSq, zero);
+		// Zero lanes divide by one instead of zero, then get the original value blended back in.
+		const __m128 length = _mm_sqrt_ps(_mm_or_ps(_mm_and_ps(mask, lengthSq), _mm_andnot_ps(mask, _mm_set1_ps(1.0f))));
+		_mm_store_ps(&out.X[i], _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(x, length)), _mm_andnot_ps(mask, x)));
+		_mm_store_ps(&out.Y[i], _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(y, length)), _mm_andnot_ps(mask, y)));
+		_mm_store_ps(&out.Z[i], _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(z, length)), _mm_andnot_ps(mask, z)));
+	}
+}
+
+static void TransformSSE(const SCVector3fStream& a, const float* m, SCVector3fStream& out, size_t n)
+{
+	const __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]);
+	const __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]);
+	const __m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+	const __m128 m30 = _mm_set1_ps(m[12]), m31 = _mm_set1_ps(m[13]), m32 = _mm_set1_ps(m[14]);
+
+	for (size_t i = 0; i < n; i += 4)
+	{
+		const __m128 x = _mm_load_ps(&a.X[i]), y = _mm_load_ps(&a.Y[i]), z = _mm_load_ps(&a.Z[i]);
+		_mm_store_ps(&out.X[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_add_ps(_mm_mul_ps(z, m20), m30)));
+		_mm_store_ps(&out.Y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_add_ps(_mm_mul_ps(z, m21), m31)));
+		_mm_store_ps(&out.Z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_add_ps(_mm_mul_ps(z, m22), m32)));
+	}
+}
+
+SC_TARGET_AVX2 static void DotAVX2(const SCVector3fStream& a, const SCVector3fStream& b, float* out, size_t n)
+{
+	for (size_t i = 0; i < n; i += 8)
+	{
+		__m256 r = _mm256_mul_ps(_mm256_load_ps(&a.X[i]), _mm256_load_ps(&b.X[i]));
+		r = _mm256_fmadd_ps(_mm256_load_ps(&a.Y[i]), _mm256_load_ps(&b.Y[i]), r);
+		r = _mm256_fmadd_ps(_mm256_load_ps(&a.Z[i]), _mm256_load_ps(&b.Z[i]), r);
+		_mm256_store_ps(out + i, r);
+	}
+}
+
+SC_TARGET_AVX2 static void CrossAVX2(const SCVector3fStream& a, const SCVector3fStream& b, SCVector3fStream& out, size_t n)
+{
+	for (size_t i = 0; i < n; i += 8)
+	{
+		const __m256 ax = _mm256_load_ps(&a.X[i]), ay = _mm256_load_ps(&a.Y[i]), az = _mm256_load_ps(&a.Z[i]);
+		const __m256 bx = _mm256_load_ps(&b.X[i]), by = _mm256_load_ps(&b.Y[i]), bz = _mm256_load_ps(&b.Z[i]);
+		_mm256_store_ps(&out.X[i], _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)));
+		_mm256_store_ps(&out.Y[i], _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)));
+		_mm256_store_ps(&out.Z[i], _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx)));
+	}
+}
+
+SC_TARGET_AVX2 static void NormalizeAVX2(const SCVector3fStream& a, SCVector3fStream& out, size_t n)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	for (size_t i = 0; i < n; i += 8)
+	{
+		const __m256 x = _mm256_load_ps(&a.X[i]), y = _mm256_load_ps(&a.Y[i]), z = _mm256_load_ps(&a.Z[i]);
+		const __m256 lengthSq = _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)));
+		const __m256 mask = _mm256_cmp_ps(lengthSq, zero, _CMP_GT_OQ);
+		const __m256 length = _mm256_sqrt_ps(_mm256_blendv_ps(one, lengthSq, mask));
+		_mm256_store_ps(&out.X[i], _mm256_blendv_ps(x, _mm256_div_ps(x, length), mask));
+		_mm256_store_ps(&out.Y[i], _mm256_blendv_ps(y, _mm256_div_ps(y, length), mask));
+		_mm256_store_ps(&out.Z[i], _mm256_blendv_ps(z, _mm256_div_ps(z, length), mask));
+	}
+}
+
+SC_TARGET_AVX2 static void TransformAVX2(const SCVector3fStream& a, const float* m, SCVector3fStream& out, size_t n)
+{
+	const __m256 m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[1]), m02 = _mm256_set1_ps(m[2]);
+	const __m256 m10 = _mm256_set1_ps(m[4]), m11 = _mm256_set1_ps(m[5]), m12 = _mm256_set1_ps(m[6]);
+	const __m256 m20 = _mm256_set1_ps(m[8]), m21 = _mm256_set1_ps(m[9]), m22 = _mm256_set1_ps(m[10]);
+	const __m256 m30 = _mm256_set1_ps(m[12]), m31 = _mm256_set1_ps(m[13]), m32 = _mm256_set1_ps(m[14]);
+
+	for (size_t i = 0; i < n; i += 8)
+	{
+		const __m256 x = _mm256_load_ps(&a.X[i]), y = _mm256_load_ps(&a.Y[i]), z = _mm256_load_ps(&a.Z[i]);
+		_mm256_store_ps(&out.X[i], _mm256_fmadd_ps(x, m00, _mm256_fmadd_ps(y, m10, _mm256_fmadd_ps(z, m20, m30))));
+		_mm256_store_ps(&out.Y[i], _mm256_fmadd_ps(x, m01, _mm256_fmadd_ps(y, m11, _mm256_fmadd_ps(z, m21, m31))));
+		_mm256_store_ps(&out.Z[i], _mm256_fmadd_ps(x, m02, _mm256_fmadd_ps(y, m12, _mm256_fmadd_ps(z, m22, m32))));
+	}
+}
+#endif
+
+static bool SizesMatch(const SCVector3fStream& a, const SCVector3fStream& b)
+{
+	if (a.Size() == b.Size())
+		return true;
+	std::cerr << "[ENGINE][MATH]: Vector3f stream size mismatch (" << a.Size() << " vs " << b.Size() << ")." << std::endl;
+	return false;
+}
+
+// SCVector3fStream
+
+void SCVector3fStream::Resize(size_t count)
+{
+	const size_t padded = SCAlignUp(count, Lanes);
+	X.resize(padded);
+	Y.resize(padded);
+	Z.resize(padded);
+	Count = count;
+	ZeroPadding();
+}
+
+void SCVector3fStream::Clear()
+{
+	X.clear();
+	Y.clear();
+	Z.clear();
+	Count = 0;
+}
+
+void SCVector3fStream::ZeroPadding()
+{
+	std::fill(X.begin() + Count, X.end(), 0.0f);
+	std::fill(Y.begin() + Count, Y.end(), 0.0f);
+	std::fill(Z.begin() + Count, Z.end(), 0.0f);
+}
+
+void SCVector3fStream::Gather(const SCVector3f* src, size_t count, size_t stride)
+{
+	Resize(count);
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(src);
+	for (size_t i = 0; i < count; i++)
+	{
+		const SCVector3f* v = reinterpret_cast<const SCVector3f*>(bytes + i * stride);
+		X[i] = v->X;
+		Y[i] = v->Y;
+		Z[i] = v->Z;
+	}
+}
+
+void SCVector3fStream::Scatter(SCVector3f* dst, size_t stride) const
+{
+	unsigned char* bytes = reinterpret_cast<unsigned char*>(dst);
+	for (size_t i = 0; i < Count; i++)
+	{
+		SCVector3f* v = reinterpret_cast<SCVector3f*>(bytes + i * stride);
+		v->X = X[i];
+		v->Y = Y[i];
+		v->Z = Z[i];
+	}
+}
+
+void SCVector3fStream::Add(const SCVector3fStream& other, SCVector3fStream& out) const
+{
+	if (!SizesMatch(*this, other)) return;
+	out.Resize(Count);
+	Elementwise<AddOp>(X.data(), other.X.data(), out.X.data(), PaddedSize());
+	Elementwise<AddOp>(Y.data(), other.Y.data(), out.Y.data(), PaddedSize());
+	Elementwise<AddOp>(Z.data(), other.Z.data(), out.Z.data(), PaddedSize());
+}
+
+void SCVector3fStream::Subtract(const SCVector3fStream& other, SCVector3fStream& out) const
+{
+	if (!SizesMatch(*this, other)) return;
+	out.Resize(Count);
+	Elementwise<SubtractOp>(X.data(), other.X.data(), out.X.data(), PaddedSize());
+	Elementwise<SubtractOp>(Y.data(), other.Y.data(), out.Y.data(), PaddedSize());
+	Elementwise<SubtractOp>(Z.data(), other.Z.data(), out.Z.data(), PaddedSize());
+}
+
+void SCVector3fStream::Multiply(const SCVector3fStream& other, SCVector3fStream& out) const
+{
+	if (!SizesMatch(*this, other)) return;
+	out.Resize(Count);
+	Elementwise<MultiplyOp>(X.data(), other.X.data(), out.X.data(), PaddedSize());
+	Elementwise<MultiplyOp>(Y.data(), other.Y.data(), out.Y.data(), PaddedSize());
+	Elementwise<MultiplyOp>(Z.data(), other.Z.data(), out.Z.data(), PaddedSize());
+}
+
+void SCVector3fStream::ScalarMultiply(float scalar, SCVector3fStream& out) const
+{
+	out.Resize(Count);
+	Elementwise<MultiplyOp>(X.data(), scalar, out.X.data(), PaddedSize());
+	Elementwise<MultiplyOp>(Y.data(), scalar, out.Y.data(), PaddedSize());
+	Elementwise<MultiplyOp>(Z.data(), scalar, out.Z.data(), PaddedSize());
+}
+
+void SCVector3fStream::Dot(const SCVector3fStream& other, SCFloatStream& out) const
+{
+	if (!SizesMatch(*this, other)) return;
+	out.resize(PaddedSize());
+
+	switch (SCGetSimdLevel())
+	{
+#if defined(SC_SIMD_X86)
+	case SCSimdLevel::AVX2: DotAVX2(*this, other, out.data(), PaddedSize()); break;
+	case SCSimdLevel::SSE: DotSSE(*this, other, out.data(), PaddedSize()); break;
+#endif
+	default: DotScalar(*this, other, out.data(), PaddedSize()); break;
+	}
+}
+
+void SCVector3fStream::Cross(const SCVector3fStream& other, SCVector3fStream& out) const
+{
+	if (!SizesMatch(*this, other)) return;
+	out.Resize(Count);
+
+	switch (SCGetSimdLevel())
+	{
+#if defined(SC_SIMD_X86)
+	case SCSimdLevel::AVX2: CrossAVX2(*this, other, out, PaddedSize()); break;
+	case SCSimdLevel::SSE: CrossSSE(*this, other, out, PaddedSize()); break;
+#endif
+	default: CrossScalar(*this, other, out, PaddedSize()); break;
+	}
+}
+
+void SCVector3fStream::Normalize(SCVector3fStream& out) const
+{
+	out.Resize(Count);
+
+	switch (SCGetSimdLevel())
+	{
+#if defined(SC_SIMD_X86)
+	case SCSimdLevel::AVX2: NormalizeAVX2(*this, out, PaddedSize()); break;
+	case SCSimdLevel::SSE: NormalizeSSE(*this, out, PaddedSize()); break;
+#endif
+	default: NormalizeScalar(*this, out, PaddedSize()); break;
+	}
+}
+
+void SCVector3fStream::Transform(const float matrix[16], SCVector3fStream& out) const
+{
+	out.Resize(Count);
+
+	switch (SCGetSimdLevel())
+	{
+#if defined(SC_SIMD_X86)
+	case SCSimdLevel::AVX2: TransformAVX2(*this, matrix, out, PaddedSize()); break;
+	case SCSimdLevel::SSE: TransformSSE(*this, matrix, out, PaddedSize()); break;
+#endif
+	default: TransformScalar(*this, matrix, out, PaddedSize()); break;
+	}
+
+	// The translation row leaks into the padding lanes.
+	out.ZeroPadding();
+}